@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QSet>
 #include <QString>
 #include <QStringList>
 
@@ -32,6 +33,22 @@ class AllAtOnceKeywordsFinder {
         return getIds().has_value() && getIds()->isEmpty();
     }
 
+    /// @brief Parses output of `task ids`, like "1-3 5 7-8".
+    [[nodiscard]]
+    static QSet<int> parseIdRanges(const QString &ids)
+    {
+        QSet<int> res;
+        for (const auto &range : ids.split(' ', Qt::SkipEmptyParts)) {
+            const auto bounds = range.split('-');
+            const int from = bounds.first().toInt();
+            const int to = bounds.last().toInt();
+            for (int id = from; id <= to && id > 0; ++id) {
+                res.insert(id);
+            }
+        }
+        return res;
+    }
+
   private:
     QStringList m_user_keywords;
     std::optional<QString> m_ids;
@@ -2,22 +2,28 @@
 
 #include <QFuture>
 #include <QFutureWatcher>
-#include <QMap>
 #include <QObject>
 #include <QString>
+#include <QTimer>
+#include <QVariant>
 #include <QtConcurrent>
 
-#include "configmanager.hpp"
 #include "task.hpp"
 #include "taskwarriorexecutor.hpp"
 
 #include <atomic>
 #include <cstddef>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <utility>
 
 /// @brief Loads task asynchroniously.
-/// @note It does `task information`.
+/// @note It does `task information`. Requests are debounced, so quick series
+/// of requests (like mouse sweeping over the list) loads the last one only.
+/// Running load is reused for the same task and killed when other task is
+/// requested.
 class AsyncTaskLoader : public QObject {
     Q_OBJECT
   public:
@@ -25,62 +31,82 @@ class AsyncTaskLoader : public QObject {
     static constexpr auto kInvalidRequestId =
         std::numeric_limits<RequestId>::max();
 
-    static AsyncTaskLoader *create(QObject *parent = nullptr)
+    /// @brief Statistic of the requests.
+    struct Counters {
+        /// @brief Loads which launched `task`.
+        std::size_t started{ 0u };
+        /// @brief Loads which were killed because other task was requested.
+        std::size_t cancelled{ 0u };
+        /// @brief Requests which did not launch own load, because newer one
+        /// came within debounce time or the same task was loading already.
+        std::size_t coalesced{ 0u };
+    };
+
+    using CancelFlag = std::shared_ptr<std::atomic<bool>>;
+    /// @brief Reads full task by partially known @p task in worker thread.
+    /// @p cancel is set when load is not needed anymore.
+    using Fetcher = std::function<DetailedTaskInfo(
+        const DetailedTaskInfo &task, const CancelFlag &cancel)>;
+    /// @brief Makes Fetcher for each load in GUI thread, so it may use
+    /// current settings.
+    using FetcherFactory = std::function<Fetcher()>;
+
+    static AsyncTaskLoader *create(FetcherFactory fetcher_factory,
+                                   QObject *parent = nullptr)
     {
-        return new AsyncTaskLoader(parent);
+        return new AsyncTaskLoader(std::move(fetcher_factory), parent);
     }
     AsyncTaskLoader() = delete;
+    ~AsyncTaskLoader() override = default;
+
+    /// @returns Fetcher which does `task information` by @p path_to_binary.
+    /// @note Falls back to given task if reading failed.
+    [[nodiscard]]
+    static Fetcher makeTaskFetcher(QString path_to_binary)
+    {
+        return [path_to_binary = std::move(path_to_binary)](
+                   const DetailedTaskInfo &sourceTask,
+                   const CancelFlag &cancel) {
+            try {
+                // Note, use ONLY reading outside class Taskwarrior
+                // otherwise UNDO will be broken.
+                TaskWarriorExecutor executor(
+                    path_to_binary,
+                    TaskWarriorExecutor::TSkipBinaryValidation{});
+                executor.setCancelFlag(cancel);
+                DetailedTaskInfo task(sourceTask.task_id);
+                if (task.execReadExisting(executor)) {
+                    task.task_uuid = sourceTask.task_uuid;
+                    return task;
+                }
+            } catch (...) { // NOLINT
+            }
+            return sourceTask;
+        };
+    }
 
     template <typename taUserParameters>
     RequestId startTaskLoad(taUserParameters userParameters,
                             const DetailedTaskInfo &partialTask)
     {
         const auto currentRequestId = ++m_latestRequestId;
-        auto *watcher = new TaskFutWatcher(this);
-        m_activeWatchers.insert(currentRequestId, watcher);
-
-        // Lambda will be called in GUI thread.
-        connect(watcher, &QFutureWatcher<DetailedTaskInfo>::finished, this,
-                [this, currentRequestId, watcher,
-                 userParameters = std::move(userParameters)]() {
-                    const auto loadedTask = watcher->future().result();
-                    if (currentRequestId >= m_latestRequestId.load()) {
-                        emit latestLoadingFinished(
-                            QVariant::fromValue(std::move(userParameters)),
-                            currentRequestId, loadedTask);
-                    }
-                    emit anyLoadingFinished(currentRequestId, loadedTask);
-
-                    // Clean-up, remove stored watcher.
-                    m_activeWatchers.remove(currentRequestId);
-                    watcher->deleteLater();
-                });
-
-        // Launching thread.
-        static const auto fetchTaskInfo =
-            [](const QString &pathToBinary,
-               const DetailedTaskInfo &sourceTask) {
-                try {
-                    // Note, use ONLY reading outside class Taskwarrior
-                    // otherwise UNDO will be broken.
-                    const TaskWarriorExecutor executor(
-                        pathToBinary,
-                        TaskWarriorExecutor::TSkipBinaryValidation{});
-                    DetailedTaskInfo task(sourceTask.task_id);
-                    task.execReadExisting(executor);
-                    return task;
-                } catch (...) { // NOLINT
-                }
-                return sourceTask;
-            };
-        const QFuture<DetailedTaskInfo> future = QtConcurrent::run(
-            fetchTaskInfo, ConfigManager::config().get(ConfigManager::TaskBin),
-            partialTask);
-        watcher->setFuture(future);
-
+        if (m_pending) {
+            ++m_counters.coalesced;
+        }
+        m_pending = Request{ currentRequestId,
+                             QVariant::fromValue(std::move(userParameters)),
+                             partialTask };
+        m_debounce->start();
         return currentRequestId;
     }
 
+    /// @returns statistic of the requests since loader was created.
+    [[nodiscard]]
+    const Counters &counters() const
+    {
+        return m_counters;
+    }
+
   signals:
     /// @brief Signal sent when we thing we finished latest requested loading if
     /// it was many.
@@ -91,11 +117,93 @@ class AsyncTaskLoader : public QObject {
 
   private:
     using TaskFutWatcher = QFutureWatcher<DetailedTaskInfo>;
-    explicit AsyncTaskLoader(QObject *parent = nullptr)
+
+    static constexpr int kDebounceMs = 100;
+
+    struct Request {
+        RequestId id;
+        QVariant userParams;
+        DetailedTaskInfo task;
+    };
+
+    /// @brief Running load, request is replaced when the same task is
+    /// requested again.
+    struct Load {
+        Request request;
+        CancelFlag cancel;
+    };
+
+    AsyncTaskLoader(FetcherFactory fetcher_factory, QObject *parent)
         : QObject{ parent }
+        , m_fetcher_factory(std::move(fetcher_factory))
+        , m_debounce(new QTimer(this))
+    {
+        m_debounce->setSingleShot(true);
+        m_debounce->setInterval(kDebounceMs);
+        connect(m_debounce, &QTimer::timeout, this,
+                &AsyncTaskLoader::launchPending);
+    }
+
+    [[nodiscard]]
+    static bool isSameTask(const DetailedTaskInfo &a, const DetailedTaskInfo &b)
+    {
+        return !a.task_uuid.isEmpty() ? a.task_uuid == b.task_uuid
+                                      : a.task_id == b.task_id;
+    }
+
+    void launchPending()
     {
+        if (!m_pending) {
+            return;
+        }
+        auto request = std::move(*m_pending);
+        m_pending.reset();
+
+        if (m_running && isSameTask(m_running->request.task, request.task)) {
+            m_running->request = std::move(request);
+            ++m_counters.coalesced;
+            return;
+        }
+        if (m_running) {
+            m_running->cancel->store(true);
+            ++m_counters.cancelled;
+        }
+
+        auto load = std::make_shared<Load>(
+            Load{ std::move(request), std::make_shared<std::atomic<bool>>() });
+        m_running = load;
+        ++m_counters.started;
+
+        auto *watcher = new TaskFutWatcher(this);
+        // Lambda will be called in GUI thread.
+        connect(watcher, &TaskFutWatcher::finished, this,
+                [this, watcher, load]() {
+                    watcher->deleteLater();
+                    if (m_running == load) {
+                        m_running.reset();
+                    }
+                    if (load->cancel->load()) {
+                        return;
+                    }
+                    const auto loadedTask = watcher->future().result();
+                    if (load->request.id >= m_latestRequestId.load()) {
+                        emit latestLoadingFinished(load->request.userParams,
+                                                   load->request.id,
+                                                   loadedTask);
+                    }
+                    emit anyLoadingFinished(load->request.id, loadedTask);
+                });
+
+        // Launching thread.
+        watcher->setFuture(QtConcurrent::run(m_fetcher_factory(),
+                                             load->request.task, load->cancel));
     }
 
     std::atomic<RequestId> m_latestRequestId{ 0u };
-    QMap<RequestId, TaskFutWatcher *> m_activeWatchers;
+    FetcherFactory m_fetcher_factory;
+    QTimer *m_debounce;
+    /// @brief Request waiting for debounce timeout.
+    std::optional<Request> m_pending;
+    std::shared_ptr<Load> m_running;
+    Counters m_counters;
 };
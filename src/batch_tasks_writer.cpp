@@ -0,0 +1,80 @@
+#include "batch_tasks_writer.hpp"
+#include "task.hpp"
+#include "taskwarriorexecutor.hpp"
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryFile>
+
+#include <optional>
+
+namespace
+{
+/// @brief Exports tasks with @p uuids in any status.
+/// @returns exported objects by UUID or std::nullopt on errors.
+std::optional<QHash<QString, QJsonObject>>
+exportTasks(const TaskWarriorExecutor &executor, const QStringList &uuids)
+{
+    QHash<QString, QJsonObject> res;
+    if (uuids.isEmpty()) {
+        return res;
+    }
+    const auto exec_res = executor.execTaskProgramWithDefaults(
+        QStringList{ "rc.json.array=on" } << uuids << "export");
+    if (!exec_res) {
+        return std::nullopt;
+    }
+    // JSON strings cannot have raw line breaks, so lines are joined safely.
+    QJsonParseError error{};
+    const auto doc =
+        QJsonDocument::fromJson(exec_res.getStdout().join('\n').toUtf8(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isArray()) {
+        return std::nullopt;
+    }
+    const auto array = doc.array();
+    res.reserve(array.size());
+    for (const auto &value : array) {
+        const auto object = value.toObject();
+        res.insert(object.value("uuid").toString(), object);
+    }
+    return res;
+}
+} // namespace
+
+bool BatchTasksWriter::exec(const TaskWarriorExecutor &executor) const
+{
+    if (m_tasks.isEmpty()) {
+        return true;
+    }
+    if (isModifiedByCmd()) {
+        auto task = m_tasks.first();
+        return task.execModifyExisting(executor);
+    }
+    const auto exported = exportTasks(executor, existingUuids(m_tasks));
+    if (!exported) {
+        return false;
+    }
+    const auto objects =
+        buildImport(m_tasks, *exported, QDateTime::currentDateTime());
+    if (!objects) {
+        return false;
+    }
+
+    // Command line is too short for thousands of tasks, so file is used.
+    QTemporaryFile file;
+    if (!file.open()) {
+        return false;
+    }
+    const auto json = QJsonDocument(*objects).toJson(QJsonDocument::Compact);
+    if (file.write(json) != json.size() || !file.flush()) {
+        return false;
+    }
+    return static_cast<bool>(executor.execTaskProgramWithDefaults(
+        { "import", file.fileName() }));
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "task.hpp"
+#include "task_date_time.hpp"
+#include "taskwarriorexecutor.hpp"
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QUuid>
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+/// @brief Writes many tasks with different changes by single `task import`,
+/// instead of `task modify` per task. Tasks without UUID are created, so
+/// pasted list is added at once. Single existing task is written by
+/// `task modify`.
+/// @note Import replaces whole task, so existing tasks are exported first and
+/// only modified properties are put over exported JSON.
+/// @note Taskwarrior 3 records whole import as single undo step, older
+/// versions record step per task.
+class BatchTasksWriter {
+  public:
+    explicit BatchTasksWriter(QList<DetailedTaskInfo> tasks)
+        : m_tasks(std::move(tasks))
+    {
+    }
+
+    /// @returns true if all tasks were written.
+    [[nodiscard]]
+    bool exec(const TaskWarriorExecutor &executor) const;
+
+    /// @returns amount of undo steps which exec() records with `task` of
+    /// @p task_version.
+    [[nodiscard]]
+    std::uint64_t undoSteps(const QString &task_version) const
+    {
+        static constexpr int kSingleUndoImportVersion = 3;
+        if (m_tasks.isEmpty()) {
+            return 0u;
+        }
+        if (isModifiedByCmd() ||
+            task_version.section('.', 0, 0).toInt() >=
+                kSingleUndoImportVersion) {
+            return 1u;
+        }
+        return static_cast<std::uint64_t>(m_tasks.size());
+    }
+
+    /// @returns UUIDs of the existing tasks which must be exported before
+    /// import.
+    [[nodiscard]]
+    static QStringList existingUuids(const QList<DetailedTaskInfo> &tasks)
+    {
+        QStringList uuids;
+        uuids.reserve(tasks.size());
+        for (const auto &task : tasks) {
+            if (!task.task_uuid.isEmpty()) {
+                uuids << task.task_uuid;
+            }
+        }
+        return uuids;
+    }
+
+    /// @brief Builds objects for `task import`.
+    /// @param exported - exported JSON of existing tasks by UUID.
+    /// @param now - time of the new entries and of starting tasks.
+    /// @returns std::nullopt if some existing task was not exported or new
+    /// task has no description.
+    [[nodiscard]]
+    static std::optional<QJsonArray>
+    buildImport(const QList<DetailedTaskInfo> &tasks,
+                const QHash<QString, QJsonObject> &exported,
+                const QDateTime &now)
+    {
+        QJsonArray res;
+        for (const auto &task : tasks) {
+            QJsonObject object;
+            if (task.task_uuid.isEmpty()) {
+                if (task.description.get().trimmed().isEmpty()) {
+                    return std::nullopt;
+                }
+                object.insert(
+                    "uuid", QUuid::createUuid().toString(QUuid::WithoutBraces));
+                object.insert("status", "pending");
+                object.insert("entry", FixedWidthDate::formatExportMSecs(
+                                           now.toMSecsSinceEpoch()));
+            } else {
+                const auto it = exported.constFind(task.task_uuid);
+                if (it == exported.cend()) {
+                    return std::nullopt;
+                }
+                object = *it;
+                // Those are computed by `task`.
+                object.remove("id");
+                object.remove("urgency");
+            }
+            applyModified(task, now, object);
+            res.append(object);
+        }
+        return res;
+    }
+
+    /// @brief Puts modified properties of @p task over @p object, so not
+    /// modified ones remain as they were exported.
+    static void applyModified(const DetailedTaskInfo &task,
+                              const QDateTime &now, QJsonObject &object)
+    {
+        for (const auto &field : DetailedTaskInfo::fields()) {
+            if (field.to_json == nullptr || !field.is_modified(task)) {
+                continue;
+            }
+            const auto value =
+                field.to_json(task, object.value(field.json_key), now);
+            if (value.isNull() || value.isUndefined()) {
+                object.remove(field.json_key);
+            } else {
+                object.insert(field.json_key, value);
+            }
+        }
+    }
+
+  private:
+    /// @returns true if the only existing task is written by `task modify`,
+    /// which does not start or stop tasks.
+    [[nodiscard]]
+    bool isModifiedByCmd() const
+    {
+        if (m_tasks.size() != 1) {
+            return false;
+        }
+        const auto &task = m_tasks.first();
+        return !task.task_uuid.isEmpty() && !task.isModified(task.active);
+    }
+
+    QList<DetailedTaskInfo> m_tasks;
+};
@@ -19,6 +19,8 @@ ConfigManager::ConfigManager()
           { SaveFilterOnExit.name, false },
           { TaskFilter.name, QStringList{} },
           { MuteNotifications.name, false },
+          { ReadStorageDirectly.name, false },
+          { ForwardTaskChanges.name, false },
       })
     , m_named_fields_defaults_(m_named_fields_)
 {
@@ -32,6 +32,12 @@ class ConfigManager {
     static inline const Key<bool> SaveFilterOnExit{ "save_filter_on_exit" };
     static inline const Key<QStringList> TaskFilter{ "task_filter" };
     static inline const Key<bool> MuteNotifications{ "mute_notifications" };
+    static inline const Key<bool> ReadStorageDirectly{
+        "read_storage_directly"
+    };
+    static inline const Key<bool> ForwardTaskChanges{
+        "forward_task_changes"
+    };
 
     static ConfigManager &config();
     ConfigEvents &notifier() { return m_events_; }
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+#include <utility>
+#include <vector>
+
+/// @brief Cheap snapshot of taskwarrior's data files state: size and
+/// modification time of each file. Any write by `task` changes at least one
+/// of those.
+class DataFilesFingerprint {
+  public:
+    /// @brief Files written by Taskwarrior 2.x and 3.x. Missing files are
+    /// part of the fingerprint too.
+    static const QStringList &watchedFileNames()
+    {
+        static const QStringList kNames = {
+            "pending.data",         "completed.data",
+            "undo.data",            "backlog.data",
+            "taskchampion.sqlite3", "taskchampion.sqlite3-wal",
+        };
+        return kNames;
+    }
+
+    DataFilesFingerprint() = default;
+
+    /// @brief Reads current state of the files in @p data_dir.
+    [[nodiscard]]
+    static DataFilesFingerprint read(const QDir &data_dir)
+    {
+        DataFilesFingerprint res;
+        res.m_files.reserve(watchedFileNames().size());
+        for (const auto &name : watchedFileNames()) {
+            const QFileInfo info(data_dir.absoluteFilePath(name));
+            if (info.exists()) {
+                res.m_files.emplace_back(
+                    info.size(), info.lastModified().toMSecsSinceEpoch());
+            } else {
+                res.m_files.emplace_back(kMissing, kMissing);
+            }
+        }
+        return res;
+    }
+
+    bool operator==(const DataFilesFingerprint &other) const
+    {
+        return m_files == other.m_files;
+    }
+
+    bool operator!=(const DataFilesFingerprint &other) const
+    {
+        return !(*this == other);
+    }
+
+  private:
+    static constexpr qint64 kMissing = -1;
+    // size, mtime
+    std::vector<std::pair<qint64, qint64>> m_files;
+};
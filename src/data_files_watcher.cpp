@@ -0,0 +1,81 @@
+#include "data_files_watcher.hpp"
+
+#include "data_files_fingerprint.hpp"
+
+#include <QDir>
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <chrono>
+#include <utility>
+
+namespace
+{
+using namespace std::chrono_literals;
+
+/// @brief `task` writes couple files per command, SQLite does many writes per
+/// transaction, so events are collected for a while.
+constexpr auto kSettleTime = 100ms;
+} // namespace
+
+DataFilesWatcher::DataFilesWatcher(const QString &data_dir, QObject *parent)
+    : QObject(parent)
+    , m_data_dir(data_dir)
+    , m_fingerprint(DataFilesFingerprint::read(m_data_dir))
+{
+    m_settle_timer.setSingleShot(true);
+    m_settle_timer.setInterval(kSettleTime);
+    connect(&m_settle_timer, &QTimer::timeout, this,
+            &DataFilesWatcher::checkFingerprint);
+
+    // Directory is watched to see files created or replaced (taskwarrior 2.x
+    // may rewrite files), files are watched to see appends.
+    m_watcher.addPath(m_data_dir.absolutePath());
+    watchExistingFiles();
+    connect(&m_watcher, &QFileSystemWatcher::directoryChanged, this,
+            &DataFilesWatcher::onFileSystemEvent);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this,
+            &DataFilesWatcher::onFileSystemEvent);
+}
+
+bool DataFilesWatcher::isWatching() const
+{
+    return m_watcher.directories().contains(m_data_dir.absolutePath());
+}
+
+void DataFilesWatcher::onFileSystemEvent()
+{
+    if (!m_settle_timer.isActive()) {
+        m_settle_timer.start();
+    }
+}
+
+void DataFilesWatcher::checkFingerprint()
+{
+    // Replaced files are dropped from watching by OS.
+    watchExistingFiles();
+
+    auto current = DataFilesFingerprint::read(m_data_dir);
+    if (current != m_fingerprint) {
+        m_fingerprint = std::move(current);
+        emit dataFilesWereChanged();
+    }
+}
+
+void DataFilesWatcher::watchExistingFiles()
+{
+    const QStringList watched = m_watcher.files();
+    QStringList toAdd;
+    for (const auto &name : DataFilesFingerprint::watchedFileNames()) {
+        const auto path = m_data_dir.absoluteFilePath(name);
+        if (!watched.contains(path) && m_data_dir.exists(name)) {
+            toAdd << path;
+        }
+    }
+    if (!toAdd.isEmpty()) {
+        m_watcher.addPaths(toAdd);
+    }
+}
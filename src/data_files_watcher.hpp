@@ -0,0 +1,40 @@
+#pragma once
+
+#include "data_files_fingerprint.hpp"
+
+#include <QDir>
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <qtmetamacros.h>
+
+/// @brief Watches taskwarrior's data directory and fires signal when data
+/// files were changed by anyone. It replaces polling of `task stat`.
+/// @note File system notifications are coalesced and confirmed by
+/// DataFilesFingerprint, so touching unrelated files in directory does not
+/// fire signal.
+class DataFilesWatcher : public QObject {
+    Q_OBJECT
+  public:
+    explicit DataFilesWatcher(const QString &data_dir,
+                              QObject *parent = nullptr);
+
+    /// @returns true if OS notifications are working for the directory.
+    /// Otherwise caller should poll.
+    [[nodiscard]]
+    bool isWatching() const;
+
+  signals:
+    void dataFilesWereChanged();
+
+  private:
+    void onFileSystemEvent();
+    void checkFingerprint();
+    void watchExistingFiles();
+
+    QDir m_data_dir;
+    QFileSystemWatcher m_watcher;
+    QTimer m_settle_timer;
+    DataFilesFingerprint m_fingerprint;
+};
@@ -62,14 +62,18 @@ struct DateTimeParser {
   private:
     /// @brief tries to compose 2 strings into QDateTime as ISODate.
     /// @returns QDateTime or std::nullopt if it couldn't make valid date.
-
+    /// @note We force `rc.dateformat`, so fixed width parser handles it
+    /// without intermediate string, other ISO forms are still accepted.
     template <ETaskDateTimeRole taRole>
     [[nodiscard]]
     static TaskDateTime<taRole> composeDateTime(const QString &date,
                                                 const QString &time)
     {
-        auto dt = QDateTime::fromString(QString{ "%1T%2" }.arg(date, time),
-                                        Qt::ISODate);
+        auto dt = FixedWidthDate::parseLocalDateTime(date, time);
+        if (!dt.isValid()) {
+            dt = QDateTime::fromString(QString{ "%1T%2" }.arg(date, time),
+                                       Qt::ISODate);
+        }
         if (dt.isValid()) {
             return TaskDateTime<taRole>{ dt };
         }
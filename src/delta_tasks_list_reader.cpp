@@ -0,0 +1,109 @@
+#include "delta_tasks_list_reader.hpp"
+#include "allatoncekeywordsfinder.hpp"
+#include "filteredtaskslistreader.hpp"
+#include "task.hpp"
+#include "taskwarriorexecutor.hpp"
+
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+#include <utility>
+
+namespace
+{
+/// @returns UUIDs of the pending tasks matching @p filter, std::nullopt on
+/// errors.
+std::optional<QSet<QString>>
+readPendingUuids(const TaskWarriorExecutor &executor,
+                 const AllAtOnceKeywordsFinder &filter)
+{
+    QStringList cmd = { "+PENDING" };
+    if (filter.getIds().has_value()) {
+        cmd << *filter.getIds();
+    }
+    cmd << "_uuids";
+    const auto res = executor.execTaskProgramWithDefaults(cmd);
+    if (!res) {
+        return std::nullopt;
+    }
+    QSet<QString> uuids;
+    for (const auto &line : res.getStdout()) {
+        for (const auto &uuid : line.split(' ', Qt::SkipEmptyParts)) {
+            uuids.insert(uuid);
+        }
+    }
+    return uuids;
+}
+} // namespace
+
+std::optional<QList<DetailedTaskInfo>>
+DeltaTasksListReader::read(const TaskWarriorExecutor &executor,
+                           const AllAtOnceKeywordsFinder &filter)
+{
+    if (filter.isNotFound()) {
+        reset();
+        return QList<DetailedTaskInfo>{};
+    }
+    if (!m_has_kept || !m_newest_modified.isValid() ||
+        m_kept_filter_ids != filter.getIds() ||
+        m_since_full_read.hasExpired(kFullReadPeriodMs)) {
+        return readFull(executor, filter);
+    }
+
+    FilteredTasksListReader changedReader(filter);
+    // Modification time has 1 second precision, so the last second is
+    // re-read to not miss changes done within it.
+    changedReader.setModifiedAfter(m_newest_modified.addSecs(-1));
+    if (!changedReader.readUrgencySortedTaskList(executor)) {
+        return std::nullopt;
+    }
+
+    // Listed after export, so tasks added in between are unknown and lead
+    // to the full read instead of being missed.
+    const auto pendingUuids = readPendingUuids(executor, filter);
+    if (!pendingUuids) {
+        return std::nullopt;
+    }
+
+    auto merged = merge(m_kept, changedReader.tasks, *pendingUuids);
+    if (!merged) {
+        // Task was completed or deleted (other IDs are renumbered), or it was
+        // added without moving modification time forward, like undo does.
+        return readFull(executor, filter);
+    }
+    const auto newest = newestModified(changedReader.tasks);
+    if (newest.isValid() && m_newest_modified < newest) {
+        m_newest_modified = newest;
+    }
+    m_kept = *merged;
+    return merged;
+}
+
+void DeltaTasksListReader::reset()
+{
+    m_has_kept = false;
+    m_kept.clear();
+    m_newest_modified = {};
+    m_kept_filter_ids.reset();
+    m_since_full_read.invalidate();
+}
+
+std::optional<QList<DetailedTaskInfo>>
+DeltaTasksListReader::readFull(const TaskWarriorExecutor &executor,
+                               const AllAtOnceKeywordsFinder &filter)
+{
+    FilteredTasksListReader retriever(filter);
+    if (!retriever.readUrgencySortedTaskList(executor)) {
+        reset();
+        return std::nullopt;
+    }
+    m_has_kept = true;
+    m_kept = retriever.tasks;
+    m_newest_modified = newestModified(m_kept);
+    m_kept_filter_ids = filter.getIds();
+    m_since_full_read.start();
+    return std::move(retriever.tasks);
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "allatoncekeywordsfinder.hpp"
+#include "task.hpp"
+#include "taskwarriorexecutor.hpp"
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <optional>
+
+/// @brief Keeps the last read pending list and re-reads only tasks modified
+/// since then. Each read costs `task export modified.after:` of the changed
+/// tasks plus `task _uuids` of all pending ones, which finds removed tasks.
+/// @note The whole list is exported on the 1st read, when filter was changed,
+/// when some task left the list (IDs are renumbered), after undo (it restores
+/// old modification time), when dependencies were changed (kept tasks become
+/// blocking or stop) and each kFullReadPeriod, as urgency of the kept tasks
+/// depends on time.
+class DeltaTasksListReader {
+  public:
+    static constexpr qint64 kFullReadPeriodMs = 5 * 60 * 1000;
+
+    /// @returns urgency sorted list of the pending tasks (same as
+    /// FilteredTasksListReader) or std::nullopt on errors.
+    [[nodiscard]]
+    std::optional<QList<DetailedTaskInfo>>
+    read(const TaskWarriorExecutor &executor,
+         const AllAtOnceKeywordsFinder &filter);
+
+    /// @brief Forgets kept list, so the next read is full.
+    void reset();
+
+    /// @brief Builds current list from @p kept one, replacing tasks by
+    /// modified ones from @p changed.
+    /// @returns list sorted by urgency or std::nullopt if @p pending_uuids
+    /// has unknown task or misses the kept one, or if dependencies of some
+    /// task were changed, so urgency of the unchanged tasks is stale.
+    [[nodiscard]]
+    static std::optional<QList<DetailedTaskInfo>>
+    merge(const QList<DetailedTaskInfo> &kept,
+          const QList<DetailedTaskInfo> &changed,
+          const QSet<QString> &pending_uuids)
+    {
+        QHash<QString, const DetailedTaskInfo *> changedByUuid;
+        changedByUuid.reserve(changed.size());
+        for (const auto &task : changed) {
+            changedByUuid.insert(task.task_uuid, &task);
+        }
+
+        QList<DetailedTaskInfo> res;
+        res.reserve(kept.size() + changed.size());
+        for (const auto &task : kept) {
+            if (!pending_uuids.contains(task.task_uuid)) {
+                return std::nullopt;
+            }
+            const auto *fresh = changedByUuid.take(task.task_uuid);
+            if (fresh != nullptr && fresh->depends != task.depends) {
+                return std::nullopt;
+            }
+            res << (fresh != nullptr ? *fresh : task);
+        }
+        // Left ones are added.
+        for (const auto &task : changed) {
+            if (!changedByUuid.contains(task.task_uuid)) {
+                continue;
+            }
+            if (!task.depends.isEmpty()) {
+                return std::nullopt;
+            }
+            res << task;
+        }
+        if (res.size() != pending_uuids.size()) {
+            return std::nullopt;
+        }
+        std::stable_sort(res.begin(), res.end(),
+                         [](const DetailedTaskInfo &a,
+                            const DetailedTaskInfo &b) {
+                             return a.urgency > b.urgency;
+                         });
+        return res;
+    }
+
+    /// @returns the latest modification time in @p tasks, invalid if none
+    /// has it.
+    [[nodiscard]]
+    static QDateTime newestModified(const QList<DetailedTaskInfo> &tasks)
+    {
+        QDateTime newest;
+        for (const auto &task : tasks) {
+            if (task.modified.isValid() &&
+                (!newest.isValid() || newest < task.modified)) {
+                newest = task.modified;
+            }
+        }
+        return newest;
+    }
+
+  private:
+    [[nodiscard]]
+    std::optional<QList<DetailedTaskInfo>>
+    readFull(const TaskWarriorExecutor &executor,
+             const AllAtOnceKeywordsFinder &filter);
+
+    bool m_has_kept{ false };
+    QList<DetailedTaskInfo> m_kept;
+    QElapsedTimer m_since_full_read;
+    QDateTime m_newest_modified;
+    /// @brief Filter which was used to read m_kept.
+    std::optional<QString> m_kept_filter_ids;
+};
@@ -0,0 +1,270 @@
+#pragma once
+
+#include "task.hpp"
+#include "tasks_filter_index.hpp"
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringView>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// @brief Trigram index of the tasks descriptions for fuzzy search. Each word
+/// is padded by spaces, so its beginning and end give own trigrams. Search is
+/// case insensitive.
+/// @note Copy is cheap, containers are implicitly shared, so updated() changes
+/// only touched posting lists of the copy.
+class DescriptionTrigramIndex {
+  public:
+    /// @brief Part of the query trigrams which candidate must have.
+    static constexpr int kMinSimilarityPercent = 50;
+    /// @brief Update rebuilds index if more tasks were changed.
+    static constexpr int kMaxUpdatedPercent = 50;
+
+    struct Hit {
+        QString uuid;
+        /// @brief Percent of the query trigrams found, plus bonus for each
+        /// word found as is.
+        int score;
+    };
+    /// @brief Start and length of the highlighted part of the text.
+    using Range = std::pair<qsizetype, qsizetype>;
+
+    explicit DescriptionTrigramIndex(const QList<DetailedTaskInfo> &tasks)
+    {
+        m_slots.reserve(tasks.size());
+        for (const auto &task : tasks) {
+            addSlot(task.task_uuid, task.description.get());
+        }
+    }
+
+    /// @returns index of the @p tasks made by patching this one, so only
+    /// changed descriptions are split to trigrams.
+    [[nodiscard]]
+    DescriptionTrigramIndex updated(const QList<DetailedTaskInfo> &tasks) const
+    {
+        QSet<QString> kept;
+        QList<const DetailedTaskInfo *> added;
+        for (const auto &task : tasks) {
+            const auto it = m_slot_of.constFind(task.task_uuid);
+            if (it != m_slot_of.cend() &&
+                m_slots.at(*it).description == task.description.get()) {
+                kept << task.task_uuid;
+            } else {
+                added << &task;
+            }
+        }
+        const auto removed = m_slot_of.size() - kept.size();
+        if ((added.size() + removed) * 100 >
+            std::max<qsizetype>(1, tasks.size()) * kMaxUpdatedPercent) {
+            return DescriptionTrigramIndex(tasks);
+        }
+
+        DescriptionTrigramIndex res(*this);
+        for (auto it = m_slot_of.cbegin(); it != m_slot_of.cend(); ++it) {
+            if (!kept.contains(it.key())) {
+                res.removeSlot(it.value());
+            }
+        }
+        for (const auto *task : added) {
+            res.addSlot(task->task_uuid, task->description.get());
+        }
+        return res;
+    }
+
+    /// @returns tasks similar to @p query, best ones first.
+    [[nodiscard]]
+    QList<Hit> search(const QString &query) const
+    {
+        const auto words = foldedWords(query);
+        if (words.isEmpty()) {
+            return {};
+        }
+        const auto trigrams = trigramsOf(words);
+        const auto total = static_cast<int>(trigrams.size());
+        const int minHits =
+            std::max(1, (total * kMinSimilarityPercent + 99) / 100);
+
+        std::vector<std::uint16_t> hits(m_slots.size(), 0u);
+        for (const auto trigram : trigrams) {
+            for (const int slot : m_postings.value(trigram)) {
+                ++hits[slot];
+            }
+        }
+
+        QList<Hit> res;
+        for (int slot = 0, sz = static_cast<int>(m_slots.size()); slot < sz;
+             ++slot) {
+            if (hits[slot] < minHits) {
+                continue;
+            }
+            // Only candidates are verified, QStringView::indexOf() uses
+            // vectorized search of the 1st character.
+            const QStringView folded = m_slots.at(slot).folded;
+            int bonus = 0;
+            for (const auto &word : words) {
+                if (folded.indexOf(word) >= 0) {
+                    bonus += kExactWordBonus;
+                }
+            }
+            res << Hit{ m_slots.at(slot).uuid,
+                        hits[slot] * 100 / total + bonus };
+        }
+        std::stable_sort(res.begin(), res.end(),
+                         [](const Hit &a, const Hit &b) {
+                             return a.score > b.score;
+                         });
+        return res;
+    }
+
+    /// @returns ascending and not overlapping parts of the @p text matching
+    /// @p query. Words found as is are highlighted whole, for others only
+    /// similar trigrams are.
+    [[nodiscard]]
+    static QList<Range> matchRanges(QStringView text, const QString &query)
+    {
+        std::vector<bool> marked(text.size(), false);
+        const auto mark = [&marked](qsizetype from, qsizetype length) {
+            std::fill_n(marked.begin() + from, length, true);
+        };
+        for (const auto &word : foldedWords(query)) {
+            bool found = false;
+            for (auto pos = text.indexOf(word, 0, Qt::CaseInsensitive);
+                 pos >= 0;
+                 pos = text.indexOf(word, pos + word.size(),
+                                    Qt::CaseInsensitive)) {
+                mark(pos, word.size());
+                found = true;
+            }
+            if (found) {
+                continue;
+            }
+            const auto wanted = trigramsOf({ word });
+            TasksFilterIndex::forEachToken(text, [&](QStringView token) {
+                const auto start = token.data() - text.data();
+                const auto word_text = padded(token.toString().toCaseFolded());
+                // Folding can change length, positions are approximate then.
+                const auto last = token.size() - 1;
+                for (qsizetype i = 0; i + 3 <= word_text.size(); ++i) {
+                    if (std::binary_search(wanted.cbegin(), wanted.cend(),
+                                           trigramAt(word_text, i))) {
+                        const auto from = std::clamp<qsizetype>(i - 1, 0, last);
+                        const auto to = std::clamp<qsizetype>(i + 1, 0, last);
+                        mark(start + from, to - from + 1);
+                    }
+                }
+            });
+        }
+
+        QList<Range> ranges;
+        for (qsizetype i = 0, sz = text.size(); i < sz; ++i) {
+            if (!marked[i]) {
+                continue;
+            }
+            if (!ranges.isEmpty() &&
+                ranges.last().first + ranges.last().second == i) {
+                ++ranges.last().second;
+            } else {
+                ranges << Range{ i, 1 };
+            }
+        }
+        return ranges;
+    }
+
+  private:
+    static constexpr int kExactWordBonus = 100;
+
+    struct Slot {
+        QString uuid;
+        QString description;
+        QString folded;
+    };
+
+    [[nodiscard]]
+    static QStringList foldedWords(QStringView text)
+    {
+        QStringList words;
+        TasksFilterIndex::forEachToken(text, [&words](QStringView token) {
+            words << token.toString().toCaseFolded();
+        });
+        return words;
+    }
+
+    [[nodiscard]]
+    static QString padded(const QString &word)
+    {
+        return QChar(' ') + word + QChar(' ');
+    }
+
+    [[nodiscard]]
+    static std::uint64_t trigramAt(const QString &text, qsizetype pos)
+    {
+        return (static_cast<std::uint64_t>(text.at(pos).unicode()) << 32u) |
+               (static_cast<std::uint64_t>(text.at(pos + 1).unicode())
+                << 16u) |
+               text.at(pos + 2).unicode();
+    }
+
+    /// @returns sorted unique trigrams of the padded @p words.
+    [[nodiscard]]
+    static std::vector<std::uint64_t> trigramsOf(const QStringList &words)
+    {
+        std::vector<std::uint64_t> res;
+        for (const auto &word : words) {
+            const auto text = padded(word);
+            for (qsizetype i = 0; i + 3 <= text.size(); ++i) {
+                res.push_back(trigramAt(text, i));
+            }
+        }
+        std::sort(res.begin(), res.end());
+        res.erase(std::unique(res.begin(), res.end()), res.end());
+        return res;
+    }
+
+    void addSlot(const QString &uuid, const QString &description)
+    {
+        int slot = 0;
+        Slot value{ uuid, description, description.toCaseFolded() };
+        if (m_free.isEmpty()) {
+            slot = static_cast<int>(m_slots.size());
+            m_slots << std::move(value);
+        } else {
+            slot = m_free.takeLast();
+            m_slots[slot] = std::move(value);
+        }
+        m_slot_of[uuid] = slot;
+        for (const auto trigram : trigramsOf(foldedWords(description))) {
+            m_postings[trigram] << slot;
+        }
+    }
+
+    void removeSlot(const int slot)
+    {
+        auto &value = m_slots[slot];
+        for (const auto trigram : trigramsOf(foldedWords(value.description))) {
+            const auto it = m_postings.find(trigram);
+            if (it == m_postings.end()) {
+                continue;
+            }
+            it->removeOne(slot);
+            if (it->isEmpty()) {
+                m_postings.erase(it);
+            }
+        }
+        m_slot_of.remove(value.uuid);
+        value = Slot{};
+        m_free << slot;
+    }
+
+    /// @brief Slots of the removed tasks are reused by added ones.
+    QList<Slot> m_slots;
+    QList<int> m_free;
+    QHash<QString, int> m_slot_of;
+    QHash<std::uint64_t, QList<int>> m_postings;
+};
@@ -0,0 +1,322 @@
+#include "direct_storage_reader.hpp"
+
+#include "allatoncekeywordsfinder.hpp"
+#include "ff4_storage_reader.hpp"
+#include "ordered_chunks.hpp"
+#include "recurring_task_template.hpp"
+#include "string_intern_pool.hpp"
+#include "task.hpp"
+#include "task_urgency.hpp"
+#include "taskchampion_reader.hpp"
+#include "taskwarriorexecutor.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace
+{
+const QString kTagPrefix = "tag_";
+const QString kDependencyPrefix = "dep_";
+const QString kAnnotationPrefix = "annotation_";
+
+/// @returns value of the key which is "tags" list in 2.x format or
+/// "<prefix>value" keys in 3.x format.
+QStringList readListAttribute(const StoredTask &task, const QString &key,
+                              const QString &prefix)
+{
+    QStringList res;
+    const auto it = task.attributes.constFind(key);
+    if (it != task.attributes.cend()) {
+        res = it.value().split(',', Qt::SkipEmptyParts);
+    }
+    for (auto attr = task.attributes.cbegin(); attr != task.attributes.cend();
+         ++attr) {
+        if (attr.key().startsWith(prefix)) {
+            res << attr.key().mid(prefix.size());
+        }
+    }
+    res.removeDuplicates();
+    return res;
+}
+
+/// @returns texts of the annotations ordered by time they were added.
+QStringList readAnnotations(const StoredTask &task)
+{
+    // Keys are "annotation_<epoch>", epochs have the same width.
+    QStringList keys;
+    for (auto it = task.attributes.keyBegin(); it != task.attributes.keyEnd();
+         ++it) {
+        if (it->startsWith(kAnnotationPrefix)) {
+            keys << *it;
+        }
+    }
+    keys.sort();
+    QStringList res;
+    res.reserve(keys.size());
+    for (const auto &key : std::as_const(keys)) {
+        res << task.attributes.value(key);
+    }
+    return res;
+}
+
+std::optional<qint64> readEpoch(const StoredTask &task, const QString &key)
+{
+    bool ok = false;
+    const qint64 secs = task.attributes.value(key).toLongLong(&ok);
+    if (!ok) {
+        return std::nullopt;
+    }
+    return secs;
+}
+
+/// @brief Fills the same fields as FilteredTasksListReader does.
+DetailedTaskInfo toTaskInfo(const StoredTask &stored, const QStringList &tags,
+                            QStringList annotations, double urgency)
+{
+    const auto &fields = DetailedTaskInfo::fields();
+    // Keys are converted once, as those are looked up for each task.
+    static const auto kKeys = [&fields]() {
+        std::array<QString, kTaskPropertiesCount> keys;
+        std::transform(fields.cbegin(), fields.cend(), keys.begin(),
+                       [](const TaskFieldInfo &field) {
+                           return QString::fromLatin1(field.json_key);
+                       });
+        return keys;
+    }();
+    static const QString kTagsKey = "tags";
+
+    DetailedTaskInfo task(stored.id);
+    task.task_uuid = stored.uuid;
+    task.urgency = urgency;
+    task.annotations = std::move(annotations);
+    // Properties are read as their static table describes.
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        if (kKeys.at(i) == kTagsKey) {
+            // Tags may be stored by several keys, those are collected already.
+            fields.at(i).from_storage(tags.join(','), task);
+            continue;
+        }
+        const auto it = stored.attributes.constFind(kKeys.at(i));
+        if (it != stored.attributes.cend()) {
+            fields.at(i).from_storage(it.value(), task);
+        }
+    }
+    return task;
+}
+} // namespace
+
+std::optional<QString> DirectStorageReader::usedKey(QByteArrayView key)
+{
+    // Properties table plus keys which readUrgencySortedTasks() and
+    // readRecurringTemplates() read.
+    static const auto kKeys = []() {
+        QList<std::pair<QByteArray, QString>> keys;
+        for (const auto &field : DetailedTaskInfo::fields()) {
+            keys.emplace_back(field.json_key,
+                              QString::fromLatin1(field.json_key));
+        }
+        for (const char *key : { "depends", "entry", "status", "wait", "due",
+                                 "scheduled", "priority", "project", "start",
+                                 "recur", "description", "tags" }) {
+            keys.emplace_back(key, QString::fromLatin1(key));
+        }
+        return keys;
+    }();
+    static const QList<QByteArray> kPrefixes = {
+        kTagPrefix.toLatin1(),
+        kDependencyPrefix.toLatin1(),
+        kAnnotationPrefix.toLatin1(),
+    };
+
+    const auto known =
+        std::find_if(kKeys.cbegin(), kKeys.cend(), [key](const auto &entry) {
+            return QByteArrayView(entry.first) == key;
+        });
+    if (known != kKeys.cend()) {
+        return known->second;
+    }
+    const bool prefixed = std::any_of(
+        kPrefixes.cbegin(), kPrefixes.cend(),
+        [key](const QByteArray &prefix) { return key.startsWith(prefix); });
+    if (prefixed) {
+        return QString::fromLatin1(key);
+    }
+    return std::nullopt;
+}
+
+std::optional<QString>
+DirectStorageReader::readDataLocation(const TaskWarriorExecutor &executor)
+{
+    const auto res =
+        executor.execTaskProgramWithDefaults({ "_get", "rc.data.location" });
+    if (!res || res.getStdout().isEmpty()) {
+        return std::nullopt;
+    }
+    QString location = res.getStdout().first().trimmed();
+    if (location.startsWith('~')) {
+        location.replace(0, 1, QDir::homePath());
+    }
+    return location;
+}
+
+std::unique_ptr<DirectStorageReader>
+DirectStorageReader::create(const TaskWarriorExecutor &executor)
+{
+    const auto location = readDataLocation(executor);
+    if (!location) {
+        return nullptr;
+    }
+    const QDir dir(*location);
+    const QFileInfo champion(
+        dir.absoluteFilePath(TaskChampionReader::kFileName));
+    if (champion.isFile() && champion.isReadable()) {
+        return std::make_unique<TaskChampionReader>(
+            champion.absoluteFilePath());
+    }
+    const QFileInfo pending(
+        dir.absoluteFilePath(Ff4StorageReader::kPendingFileName));
+    if (pending.isFile() && pending.isReadable()) {
+        return std::make_unique<Ff4StorageReader>(dir.absolutePath());
+    }
+    return nullptr;
+}
+
+std::optional<QList<DetailedTaskInfo>>
+DirectStorageReader::readUrgencySortedTasks(
+    const AllAtOnceKeywordsFinder &filter) const
+{
+    if (filter.isNotFound()) {
+        return QList<DetailedTaskInfo>{};
+    }
+    // Waiting tasks are +PENDING too since 2.6, older storages may still
+    // keep "waiting" status.
+    auto stored = readTasks({ "pending", "waiting" });
+    if (!stored) {
+        return std::nullopt;
+    }
+    // `task export` gives tasks ordered by id.
+    std::sort(stored->begin(), stored->end(),
+              [](const StoredTask &a, const StoredTask &b) {
+                  return a.id < b.id;
+              });
+
+    const QSet<QString> pendingUuids = [&stored]() {
+        QSet<QString> res;
+        res.reserve(stored->size());
+        for (const auto &task : std::as_const(*stored)) {
+            res.insert(task.uuid);
+        }
+        return res;
+    }();
+    QList<QStringList> dependencies;
+    dependencies.reserve(stored->size());
+    QSet<QString> blockingUuids;
+    for (const auto &task : std::as_const(*stored)) {
+        dependencies << readListAttribute(task, "depends", kDependencyPrefix);
+        for (const auto &uuid : std::as_const(dependencies.last())) {
+            blockingUuids.insert(uuid);
+        }
+    }
+
+    const std::optional<QSet<int>> filteredIds =
+        filter.getIds().has_value()
+            ? std::optional<QSet<int>>(
+                  AllAtOnceKeywordsFinder::parseIdRanges(*filter.getIds()))
+            : std::nullopt;
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+
+    using TStoredIt = QList<StoredTask>::const_iterator;
+    const auto convert = [&](TStoredIt from, TStoredIt to) {
+        // Chunk interns to own pool, so chunks do not lock each other.
+        const StringInternPool::LocalScope interned;
+        QList<DetailedTaskInfo> res;
+        res.reserve(std::distance(from, to));
+        for (auto it = from; it != to; ++it) {
+            const auto &task = *it;
+            const auto i = std::distance(stored->cbegin(), it);
+            if (filteredIds.has_value() && !filteredIds->contains(task.id)) {
+                continue;
+            }
+            const auto tags = readListAttribute(task, "tags", kTagPrefix);
+
+            UrgencyInputs in;
+            const auto priority = task.attributes.value("priority");
+            in.priority = priority.size() == 1
+                              ? static_cast<UrgencyInputs::Priority>(
+                                    priority.at(0).toLatin1())
+                              : UrgencyInputs::Priority::Unset;
+            in.has_project = !task.attributes.value("project").isEmpty();
+            in.has_next_tag = tags.contains("next");
+            in.active = task.attributes.contains("start");
+            const auto wait = readEpoch(task, "wait");
+            in.waiting = task.attributes.value("status") == "waiting" ||
+                         (wait.has_value() && *wait > now);
+            in.blocked = std::any_of(
+                dependencies.at(i).cbegin(), dependencies.at(i).cend(),
+                [&pendingUuids](const QString &uuid) {
+                    return pendingUuids.contains(uuid);
+                });
+            in.blocking = blockingUuids.contains(task.uuid);
+            in.tags_count = static_cast<int>(tags.size());
+            auto annotations = readAnnotations(task);
+            in.annotations_count = static_cast<int>(annotations.size());
+            in.due = readEpoch(task, "due");
+            in.scheduled = readEpoch(task, "scheduled");
+            in.entry = readEpoch(task, "entry");
+
+            res << toTaskInfo(task, tags, std::move(annotations),
+                              TaskUrgency::compute(in, now));
+            res.back().depends = dependencies.at(i);
+        }
+        return res;
+    };
+    auto res = OrderedChunks::parse(stored->cbegin(), stored->cend(), convert,
+                                    [](TStoredIt) { return true; });
+
+    std::stable_sort(res.begin(), res.end(),
+                     [](const DetailedTaskInfo &a, const DetailedTaskInfo &b) {
+                         return a.urgency > b.urgency;
+                     });
+    return res;
+}
+
+std::optional<QList<RecurringTaskTemplate>>
+DirectStorageReader::readRecurringTemplates() const
+{
+    auto stored = readTasks({ "recurring" });
+    if (!stored) {
+        return std::nullopt;
+    }
+    std::sort(stored->begin(), stored->end(),
+              [](const StoredTask &a, const StoredTask &b) {
+                  return a.id < b.id;
+              });
+
+    QList<RecurringTaskTemplate> res;
+    res.reserve(stored->size());
+    for (const auto &task : std::as_const(*stored)) {
+        // Table reader fills it by "id" column, so keep it the same.
+        res << RecurringTaskTemplate{
+            task.id > 0 ? QString::number(task.id) : task.uuid,
+            task.attributes.value("recur"),
+            task.attributes.value("project"),
+            task.attributes.value("description").trimmed(),
+        };
+    }
+    return res;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "allatoncekeywordsfinder.hpp"
+#include "recurring_task_template.hpp"
+#include "task.hpp"
+#include "taskwarriorexecutor.hpp"
+
+#include <QByteArrayView>
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <optional>
+
+/// @brief Task as it is kept by taskwarrior's storage: plain attributes in
+/// taskwarrior's own format (dates are seconds since epoch, tags and
+/// annotations are separated keys).
+struct StoredTask {
+    QString uuid;
+    /// @brief Working set id, 0 if task does not have it.
+    int id{ 0 };
+    QHash<QString, QString> attributes;
+};
+
+/// @brief Reads taskwarrior's data files directly, without launching `task`.
+/// It is read-only, all modifications must be done by `task` binary, so undo
+/// and hooks keep working.
+/// @note Children implement particular storage format, this class makes the
+/// same lists as `task` queries do.
+class DirectStorageReader {
+  public:
+    DirectStorageReader() = default;
+    DirectStorageReader(const DirectStorageReader &) = delete;
+    DirectStorageReader &operator=(const DirectStorageReader &) = delete;
+    DirectStorageReader(DirectStorageReader &&) = delete;
+    DirectStorageReader &operator=(DirectStorageReader &&) = delete;
+    virtual ~DirectStorageReader() = default;
+
+    /// @brief Detects format of the data used by `task` in @p executor.
+    /// @returns reader or nullptr if data cannot be read directly.
+    [[nodiscard]]
+    static std::unique_ptr<DirectStorageReader>
+    create(const TaskWarriorExecutor &executor);
+
+    /// @returns directory where `task` keeps data (rc.data.location).
+    [[nodiscard]]
+    static std::optional<QString>
+    readDataLocation(const TaskWarriorExecutor &executor);
+
+    /// @brief Same list as FilteredTasksListReader produces.
+    /// @returns std::nullopt if data could not be read.
+    [[nodiscard]]
+    std::optional<QList<DetailedTaskInfo>>
+    readUrgencySortedTasks(const AllAtOnceKeywordsFinder &filter) const;
+
+    /// @brief Same list as RecurringTaskTemplate::readAll() produces.
+    /// @returns std::nullopt if data could not be read.
+    [[nodiscard]]
+    std::optional<QList<RecurringTaskTemplate>> readRecurringTemplates() const;
+
+    /// @brief Storage readers may skip attributes which are not used here,
+    /// so those are not decoded.
+    /// @returns key of StoredTask::attributes for storage @p key, or
+    /// std::nullopt if the attribute is not read by this class.
+    /// @note Known keys are shared strings, so only prefixed keys (tags,
+    /// dependencies and annotations) are allocated.
+    [[nodiscard]]
+    static std::optional<QString> usedKey(QByteArrayView key);
+
+  protected:
+    /// @brief Children must read all tasks having one of @p statuses.
+    /// @returns std::nullopt on any error.
+    [[nodiscard]]
+    virtual std::optional<QList<StoredTask>>
+    readTasks(const QStringList &statuses) const = 0;
+};
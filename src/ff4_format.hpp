@@ -0,0 +1,131 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+#include <qtypes.h>
+
+/// @brief Parsing of the FF4 format, which is used by Taskwarrior 2.x for
+/// lines of pending.data and completed.data:
+/// [description:"Buy milk" entry:"1767225600" status:"pending" uuid:"..."]
+namespace Ff4
+{
+/// @brief Iterates attributes of the single @p line without copying it.
+/// @tparam taCallable - Callable which should accept key and still encoded
+/// value as QByteArrayView, value should be decoded by decodeValue() if it is
+/// needed.
+/// @returns false if @p line is not valid FF4.
+template <typename taCallable>
+bool forEachAttribute(QByteArrayView line, const taCallable &onAttribute)
+{
+    line = line.trimmed();
+    if (line.size() < 2 || line.front() != '[' || line.back() != ']') {
+        return false;
+    }
+    const qsizetype end = line.size() - 1;
+    qsizetype pos = 1;
+    while (pos < end) {
+        if (line.at(pos) == ' ') {
+            ++pos;
+            continue;
+        }
+        const qsizetype colon = line.indexOf(':', pos);
+        if (colon < 0 || colon + 1 >= end || line.at(colon + 1) != '"') {
+            return false;
+        }
+        const qsizetype valueBegin = colon + 2;
+        qsizetype quote = valueBegin;
+        while (quote < end && line.at(quote) != '"') {
+            quote += line.at(quote) == '\\' ? 2 : 1;
+        }
+        if (quote >= end) {
+            return false;
+        }
+        onAttribute(line.sliced(pos, colon - pos),
+                    line.sliced(valueBegin, quote - valueBegin));
+        pos = quote + 1;
+    }
+    return true;
+}
+
+/// @brief Decodes @p value as it is written by `task`: JSON escapes and
+/// &open; &close; instead of brackets.
+inline QString decodeValue(QByteArrayView value)
+{
+    if (!value.contains('\\') && !value.contains('&')) {
+        return QString::fromUtf8(value);
+    }
+
+    QByteArray unescaped;
+    unescaped.reserve(value.size());
+    for (qsizetype i = 0; i < value.size(); ++i) {
+        const char c = value.at(i);
+        if (c != '\\' || i + 1 == value.size()) {
+            unescaped.append(c);
+            continue;
+        }
+        const char escaped = value.at(++i);
+        switch (escaped) {
+        case 'b':
+            unescaped.append('\b');
+            break;
+        case 'f':
+            unescaped.append('\f');
+            break;
+        case 'n':
+            unescaped.append('\n');
+            break;
+        case 'r':
+            unescaped.append('\r');
+            break;
+        case 't':
+            unescaped.append('\t');
+            break;
+        case 'u': {
+            static constexpr qsizetype kHexDigits = 4;
+            // Reads XXXX of the \uXXXX escape starting at escape_pos.
+            const auto readCode = [&value](qsizetype escape_pos,
+                                           bool &ok) -> char16_t {
+                const qsizetype begin = escape_pos + 2;
+                ok = false;
+                if (begin + kHexDigits > value.size()) {
+                    return 0;
+                }
+                return value.sliced(begin, kHexDigits)
+                    .toUShort(&ok, 16); // NOLINT
+            };
+            bool ok = false;
+            const char16_t code = readCode(i - 1, ok);
+            if (!ok) {
+                unescaped.append("\\u");
+                break;
+            }
+            i += kHexDigits;
+            // Characters outside of BMP are written as surrogate pair of
+            // 2 escapes: \uD83D\uDE00.
+            if (QChar::isHighSurrogate(code) && i + 2 < value.size() &&
+                value.at(i + 1) == '\\' && value.at(i + 2) == 'u') {
+                bool low_ok = false;
+                const char16_t low = readCode(i + 1, low_ok);
+                if (low_ok && QChar::isLowSurrogate(low)) {
+                    const char32_t ucs4 = QChar::surrogateToUcs4(code, low);
+                    unescaped.append(QString::fromUcs4(&ucs4, 1).toUtf8());
+                    i += 2 + kHexDigits;
+                    break;
+                }
+            }
+            unescaped.append(QString(QChar(code)).toUtf8());
+            break;
+        }
+        default:
+            // \" \\ \/
+            unescaped.append(escaped);
+            break;
+        }
+    }
+    return QString::fromUtf8(unescaped)
+        .replace("&open;", "[")
+        .replace("&close;", "]")
+        .replace("&dquot;", "\"");
+}
+} // namespace Ff4
@@ -0,0 +1,159 @@
+#include "ff4_storage_reader.hpp"
+
+#include "direct_storage_reader.hpp"
+#include "ff4_format.hpp"
+#include "ordered_chunks.hpp"
+#include "split_string.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDir>
+#include <QFile>
+#include <QLatin1String>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using TAttributeViews = std::vector<std::pair<QByteArrayView, QByteArrayView>>;
+
+/// @brief Parses lines [ @p first, @p last ) of @p lines and returns tasks
+/// with one of @p statuses, ID is the line number if @p assign_ids is set.
+/// @returns std::nullopt if some line is corrupted.
+template <typename taLineIt>
+std::optional<QList<StoredTask>>
+parseLines(const std::vector<QByteArrayView> &lines, taLineIt first,
+           taLineIt last, const QStringList &statuses, bool assign_ids)
+{
+    QList<StoredTask> res;
+    TAttributeViews attributes;
+    for (auto it = first; it != last; ++it) {
+        attributes.clear();
+        const bool parsed = Ff4::forEachAttribute(
+            *it, [&attributes](QByteArrayView key, QByteArrayView value) {
+                attributes.emplace_back(key, value);
+            });
+        if (!parsed) {
+            return std::nullopt;
+        }
+
+        // Status is plain word, so it is checked without decoding.
+        const auto status = std::find_if(
+            attributes.cbegin(), attributes.cend(),
+            [](const auto &attr) { return attr.first == "status"; });
+        if (status == attributes.cend() ||
+            !statuses.contains(QLatin1String(status->second.data(),
+                                             status->second.size()))) {
+            continue;
+        }
+
+        StoredTask task;
+        task.id = assign_ids
+                      ? static_cast<int>(std::distance(lines.begin(), it)) + 1
+                      : 0;
+        task.attributes.reserve(static_cast<qsizetype>(attributes.size()));
+        for (const auto &[key, value] : attributes) {
+            if (key == "uuid") {
+                task.uuid = QString::fromLatin1(value);
+                continue;
+            }
+            // UDAs, "modified", "mask" and alike are skipped undecoded.
+            if (auto used = DirectStorageReader::usedKey(key)) {
+                task.attributes.insert(std::move(*used),
+                                       Ff4::decodeValue(value));
+            }
+        }
+        res << std::move(task);
+    }
+    return res;
+}
+
+/// @brief Parses mapped @p content of the data file and appends tasks with
+/// one of @p statuses to @p output. Lines are independent, so long files
+/// (completed.data mostly) are parsed in parallel chunks.
+/// @returns false if file is corrupted.
+bool parseDataFile(QByteArrayView content, const QStringList &statuses,
+                   bool assign_ids, QList<StoredTask> &output)
+{
+    using TLineIt = std::vector<QByteArrayView>::const_iterator;
+    const auto lines = splitRawLines(content);
+    std::atomic<bool> corrupted{ false };
+    auto tasks = OrderedChunks::parse(
+        lines.cbegin(), lines.cend(),
+        [&](TLineIt from, TLineIt to) {
+            auto chunk = parseLines(lines, from, to, statuses, assign_ids);
+            if (!chunk) {
+                corrupted = true;
+                return QList<StoredTask>{};
+            }
+            return std::move(*chunk);
+        },
+        [](TLineIt) { return true; });
+    if (corrupted) {
+        return false;
+    }
+    output.append(std::move(tasks));
+    return true;
+}
+
+/// @brief Maps file @p path and parses it.
+/// @returns false if file exists but could not be read or parsed.
+bool readDataFile(const QString &path, const QStringList &statuses,
+                  bool assign_ids, QList<StoredTask> &output)
+{
+    QFile file(path);
+    if (!file.exists()) {
+        return true;
+    }
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::cerr << "Failed to open " << path.toStdString() << std::endl;
+        return false;
+    }
+    if (file.size() == 0) {
+        return true;
+    }
+    if (uchar *mapped = file.map(0, file.size())) {
+        const QByteArrayView content(mapped, file.size());
+        const bool res = parseDataFile(content, statuses, assign_ids, output);
+        file.unmap(mapped);
+        return res;
+    }
+    // Some file systems do not support mapping.
+    const QByteArray content = file.readAll();
+    return parseDataFile(content, statuses, assign_ids, output);
+}
+} // namespace
+
+Ff4StorageReader::Ff4StorageReader(QString path_to_data_dir)
+    : m_path_to_data_dir(std::move(path_to_data_dir))
+{
+}
+
+std::optional<QList<StoredTask>>
+Ff4StorageReader::readTasks(const QStringList &statuses) const
+{
+    const QDir dir(m_path_to_data_dir);
+    QList<StoredTask> res;
+    if (!readDataFile(dir.absoluteFilePath(kPendingFileName), statuses, true,
+                      res)) {
+        return std::nullopt;
+    }
+    // completed.data is the largest file and it is rarely needed.
+    const bool needsCompleted =
+        statuses.contains("completed") || statuses.contains("deleted");
+    if (needsCompleted &&
+        !readDataFile(dir.absoluteFilePath(kCompletedFileName), statuses,
+                      false, res)) {
+        return std::nullopt;
+    }
+    return res;
+}
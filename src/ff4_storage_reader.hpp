@@ -0,0 +1,30 @@
+#pragma once
+
+#include "direct_storage_reader.hpp"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+/// @brief Reads Taskwarrior 2.x storage: pending.data and completed.data in
+/// FF4 format. Files are memory mapped and lines are parsed in place, only
+/// attributes of the matching tasks are decoded.
+/// @note IDs are line numbers in pending.data. It is how `task` numbers tasks
+/// when garbage collection is off, and QTask calls `task` with rc.gc=off.
+class Ff4StorageReader : public DirectStorageReader {
+  public:
+    inline static const QString kPendingFileName = "pending.data";
+    inline static const QString kCompletedFileName = "completed.data";
+
+    explicit Ff4StorageReader(QString path_to_data_dir);
+
+  protected:
+    [[nodiscard]]
+    std::optional<QList<StoredTask>>
+    readTasks(const QStringList &statuses) const override;
+
+  private:
+    QString m_path_to_data_dir;
+};
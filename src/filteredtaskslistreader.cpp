@@ -1,179 +1,131 @@
 #include "filteredtaskslistreader.hpp"
 #include "allatoncekeywordsfinder.hpp"
+#include "json_export_reader.hpp"
 #include "lambda_visitors.hpp"
 #include "task.hpp"
-#include "task_table_stencil.hpp"
 #include "taskwarriorexecutor.hpp"
 
 #include <QDateTime>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
 #include <QString>
 #include <QStringList>
-#include <qnamespace.h>
 
+#include <algorithm>
+#include <optional>
 #include <utility>
 #include <variant>
 
-namespace
-{
-template <typename taProperty, typename taValue>
-void LoadTaskField(taProperty &field, taValue value)
-{
-    field = std::move(value);
-    field.value.setNotModified();
-}
-
-template <typename taProperty>
-void LoadTaskDate(taProperty &field, const QString &date)
-{
-    auto dt = QDateTime::fromString(date.trimmed(), Qt::ISODate);
-    if (dt.isValid()) {
-        LoadTaskField(field, std::move(dt));
-    }
-}
-
-} // namespace
-
 FilteredTasksListReader::FilteredTasksListReader(AllAtOnceKeywordsFinder filter)
     : tasks{}
     , m_filter(std::move(filter))
 {
 }
 
-#define SKIP_CONTINUATION                \
-    if (m != Mode::FirstLineOfNewRecord) \
-    return
-
-const FilteredTasksListReader::ColumnsSchema &
+const FilteredTasksListReader::FieldsSchema &
 FilteredTasksListReader::getSchema() const
 {
     using Task = data_type;
-    using Mode = ColumnDescriptor::LineMode;
 
-    static const ColumnsSchema schema = {
-        {
-            "id",
-            [](const QString &v, Task &t, Mode m) {
-                SKIP_CONTINUATION;
-                t.task_id = v.trimmed();
+    static const FieldsSchema schema = []() {
+        FieldsSchema res = {
+            {
+                "id",
+                [](const QJsonValue &v, Task &t) {
+                    t.task_id = QString::number(v.toInt());
+                },
             },
-        },
-        {
-            "uuid",
-            [](const QString &v, Task &t, Mode m) {
-                SKIP_CONTINUATION;
-                t.task_uuid = v.trimmed();
+            {
+                "uuid",
+                [](const QJsonValue &v, Task &t) {
+                    t.task_uuid = v.toString();
+                },
             },
-        },
-        {
-            "start.active",
-            [](const QString &v, Task &t, Mode m) {
-                SKIP_CONTINUATION;
-                LoadTaskField(t.active, !v.trimmed().isEmpty());
+            {
+                "urgency",
+                [](const QJsonValue &v, Task &t) { t.urgency = v.toDouble(); },
             },
-        },
-        {
-            "recur",
-            [](const QString &v, Task &t, Mode m) {
-                SKIP_CONTINUATION;
-                t.recurrency_period.value.modify([&v](auto &rp) {
-                    if (!v.isEmpty()) {
-                        rp.setRecurrent();
-                    }
-                });
-                t.recurrency_period.value.setNotModified();
+            {
+                "modified",
+                [](const QJsonValue &v, Task &t) {
+                    t.modified = parseExportDateTime(v.toString());
+                },
             },
-        },
-        {
-            "project",
-            [](const QString &v, Task &t, Mode m) {
-                SKIP_CONTINUATION;
-                LoadTaskField(t.project, v.trimmed());
-            },
-        },
-        {
-            "priority",
-            [](const QString &v, Task &t, Mode m) {
-                SKIP_CONTINUATION;
-                LoadTaskField(t.priority, DetailedTaskInfo::priorityFromString(
-                                              v.trimmed()));
-            },
-        },
-        {
-            "scheduled",
-            [](const QString &v, Task &t, Mode m) {
-                SKIP_CONTINUATION;
-                LoadTaskDate(t.sched, v);
-            },
-        },
-        {
-            "due",
-            [](const QString &v, Task &t, Mode m) {
-                SKIP_CONTINUATION;
-                LoadTaskDate(t.due, v);
-            },
-        },
-        {
-            "wait",
-            [](const QString &v, Task &t, Mode m) {
-                SKIP_CONTINUATION;
-                LoadTaskDate(t.wait, v);
+            {
+                "annotations",
+                [](const QJsonValue &v, Task &t) {
+                    const auto array = v.toArray();
+                    t.annotations.reserve(array.size());
+                    for (const auto &annotation : array) {
+                        t.annotations
+                            << annotation.toObject()
+                                   .value("description")
+                                   .toString();
+                    }
+                },
             },
-        },
-        {
-            "description",
-            [](const QString &v, Task &t, Mode m) {
-                // Note, we accept continuation here.
-                if (const auto d = v.trimmed(); !d.isEmpty()) {
-                    // The annotations always start with a timestamp. And they
-                    // always follows the description.
-                    if (m == Mode::AdditionalLineOfExistingRecord) {
-                        const QString first_word =
-                            d.section(' ', 0, 0, QString::SectionSkipEmpty)
-                                .trimmed();
-                        if (QDateTime::fromString(first_word, Qt::ISODate)
-                                .isValid()) {
-                            // We won't handle the annotations at all.
-                            return;
-                        }
+            {
+                // Array since taskwarrior 2.6, comma separated string before.
+                "depends",
+                [](const QJsonValue &v, Task &t) {
+                    if (!v.isArray()) {
+                        t.depends = v.toString().split(',', Qt::SkipEmptyParts);
+                        return;
                     }
-                    if (t.description.get().isEmpty()) {
-                        LoadTaskField(t.description, d);
-                    } else {
-                        LoadTaskField(t.description,
-                                      t.description.get() + '\n' + d);
+                    const auto array = v.toArray();
+                    t.depends.reserve(array.size());
+                    for (const auto &uuid : array) {
+                        t.depends << uuid.toString();
                     }
-                }
+                },
             },
+        };
+        // Properties are read as their static table describes.
+        for (const auto &field : DetailedTaskInfo::fields()) {
+            res.push_back({ field.json_key, field.from_json });
         }
-    };
+        return res;
+    }();
     return schema;
 }
-#undef SKIP_CONTINUATION
 
-QStringList // NOLINT
-FilteredTasksListReader::createCmdParameters(const TableStencil &stencil) const
+void FilteredTasksListReader::setModifiedAfter(const QDateTime &time)
 {
-    const QString columnsArg =
-        QString("rc.report.minimal.columns=%1").arg(stencil.getCmdColumns());
-    const QString labelsArg =
-        QString("rc.report.minimal.labels=%1").arg(stencil.getCmdLabels());
+    m_modified_after = time;
+}
 
-    QStringList cmd = {
-        columnsArg, labelsArg, "rc.report.minimal.sort=urgency-",
-        "+PENDING", "minimal",
-    };
+QStringList FilteredTasksListReader::createCmdParameters() const
+{
+    QStringList cmd = { "+PENDING" };
 
     if (m_filter.getIds().has_value()) {
         cmd << *m_filter.getIds();
     }
+    if (m_modified_after.isValid()) {
+        cmd << QString("modified.after:%1")
+                   .arg(m_modified_after.toUTC().toString(
+                       "yyyyMMdd'T'HHmmss'Z'"));
+    }
+    cmd << "export";
 
     return cmd;
 }
 
+void FilteredTasksListReader::finalizeResponse(Response &resp) const
+{
+    // Export is ordered by IDs, while we need the same order as
+    // "rc.report.minimal.sort=urgency-" did.
+    std::stable_sort(resp.begin(), resp.end(),
+                     [](const DetailedTaskInfo &a, const DetailedTaskInfo &b) {
+                         return a.urgency > b.urgency;
+                     });
+}
+
 bool FilteredTasksListReader::readUrgencySortedTaskList(
     const TaskWarriorExecutor &executor)
 {
-    auto response = readAndParseTable(executor);
+    auto response = readAndParseExport(executor);
     const LambdaVisitor visitor{
         [this](Response resp) {
             tasks = std::move(resp);
@@ -184,3 +136,14 @@ bool FilteredTasksListReader::readUrgencySortedTaskList(
 
     return std::visit(visitor, std::move(response));
 }
+
+std::optional<DetailedTaskInfo>
+FilteredTasksListReader::parseTask(QByteArrayView object)
+{
+    static const FilteredTasksListReader reader(AllAtOnceKeywordsFinder({}));
+    Response resp;
+    if (!parseObject(reader.getSchema(), object, resp)) {
+        return std::nullopt;
+    }
+    return std::move(resp.first());
+}
@@ -1,35 +1,50 @@
 #pragma once
 
 #include "allatoncekeywordsfinder.hpp"
-#include "tabular_stencil_base.hpp"
+#include "json_export_reader.hpp"
 #include "task.hpp"
 
+#include <QByteArrayView>
+#include <QDateTime>
 #include <QStringList>
 
+#include <optional>
+
 /// @brief Commands to read tasks list. Tasks will have particulary filled data
 /// fields, and they should be read in full later if details are needed.
-class FilteredTasksListReader : protected TabularStencilBase<DetailedTaskInfo> {
+class FilteredTasksListReader : protected JsonExportReaderBase<DetailedTaskInfo> {
   public:
-    using Response = TabularStencilBase<DetailedTaskInfo>::Response;
+    using Response = JsonExportReaderBase<DetailedTaskInfo>::Response;
     Response tasks;
 
   public:
     explicit FilteredTasksListReader(AllAtOnceKeywordsFinder filter);
 
+    /// @brief Limits list to the tasks modified after @p time.
+    void setModifiedAfter(const QDateTime &time);
+
     /// @brief Queries taskwarrior for list of the tasks. Result is sorted by
     /// internal urgency.
     [[nodiscard]]
     bool readUrgencySortedTaskList(const TaskWarriorExecutor &executor);
 
-    // TabularStencilBase interface
+    /// @brief Parses single task JSON, as `task export` and hooks print it,
+    /// into the same fields as list has.
+    /// @returns std::nullopt if @p object is not valid JSON object.
+    [[nodiscard]]
+    static std::optional<DetailedTaskInfo> parseTask(QByteArrayView object);
+
+    // JsonExportReaderBase interface
   protected:
     [[nodiscard]]
-    const ColumnsSchema &getSchema() const override;
+    const FieldsSchema &getSchema() const override;
 
     [[nodiscard]]
-    QStringList // NOLINT
-    createCmdParameters(const TableStencil &stencil) const override;
+    QStringList createCmdParameters() const override;
+
+    void finalizeResponse(Response &resp) const override;
 
   private:
     AllAtOnceKeywordsFinder m_filter;
+    QDateTime m_modified_after;
 };
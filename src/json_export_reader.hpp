@@ -0,0 +1,228 @@
+#pragma once
+
+#include "string_intern_pool.hpp"
+#include "task_date_time.hpp"
+#include "taskwarriorexecutor.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QJsonValue>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <qtypes.h>
+
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <variant>
+#include <vector>
+
+/// @brief Splits JSON printed by `task export` into separated top level
+/// objects. Output can be fed by any chunks as it arrives, each object is
+/// reported as soon as its closing brace was received.
+/// @note It does not validate JSON, it only tracks nesting and strings, so
+/// objects could be parsed separately later.
+class JsonObjectsSplitter {
+  public:
+    /// @brief Consumes next @p chunk of the output and calls @p onObject for
+    /// each top level object completed by this chunk.
+    /// @tparam taCallable - Callable which should accept QByteArrayView of the
+    /// single object, view is valid only during the call.
+    template <typename taCallable>
+    void feed(QByteArrayView chunk, const taCallable &onObject)
+    {
+        qsizetype objectBegin = m_depth > 0 ? 0 : -1;
+        for (qsizetype i = 0, sz = chunk.size(); i < sz; ++i) {
+            const char c = chunk[i];
+            if (m_depth == 0) {
+                // Array brackets, commas and spaces between objects are
+                // skipped.
+                if (c == '{') {
+                    objectBegin = i;
+                    m_depth = 1;
+                }
+                continue;
+            }
+            if (m_in_string) {
+                if (m_escaped) {
+                    m_escaped = false;
+                } else if (c == '\\') {
+                    m_escaped = true;
+                } else if (c == '"') {
+                    m_in_string = false;
+                }
+                continue;
+            }
+            switch (c) {
+            case '"':
+                m_in_string = true;
+                break;
+            case '{':
+            case '[':
+                ++m_depth;
+                break;
+            case '}':
+            case ']':
+                if (--m_depth == 0) {
+                    const auto tail =
+                        chunk.sliced(objectBegin, i + 1 - objectBegin);
+                    if (m_pending.isEmpty()) {
+                        onObject(tail);
+                    } else {
+                        m_pending.append(tail);
+                        onObject(QByteArrayView(m_pending));
+                        m_pending.truncate(0);
+                    }
+                    objectBegin = -1;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        if (m_depth > 0) {
+            m_pending.append(chunk.sliced(objectBegin));
+        }
+    }
+
+    /// @returns true if there is no unfinished object, i.e. all fed output
+    /// was reported.
+    [[nodiscard]]
+    bool isIdle() const
+    {
+        return m_depth == 0;
+    }
+
+  private:
+    QByteArray m_pending;
+    int m_depth{ 0 };
+    bool m_in_string{ false };
+    bool m_escaped{ false };
+};
+
+/// @brief Parses date-time in the format used by `task export`
+/// (20251104T000000Z), which is always UTC.
+/// @returns local date-time or invalid QDateTime if @p value has other format.
+inline QDateTime parseExportDateTime(QStringView value)
+{
+    const auto msecs = FixedWidthDate::parseExportMSecs(value);
+    return msecs ? QDateTime::fromMSecsSinceEpoch(*msecs) : QDateTime();
+}
+
+/// @brief Base class to request and parse `task export` output.
+/// It must be subclassed, children are responsible to provide details.
+/// @note Output is parsed while `task` is still printing it.
+template <typename taDataClass>
+class JsonExportReaderBase {
+  public:
+    using data_type = taDataClass;
+    using Response = QList<taDataClass>;
+    struct ErrorParsingJson {};
+    using ResponseOrError =
+        std::variant<Response, TaskWarriorExecutor::TExecError,
+                     ErrorParsingJson>;
+
+    virtual ~JsonExportReaderBase() = default;
+
+    /// @brief Calls `task` binary with parameters provided by children and
+    /// parses exported objects to the list of @tparam taDataClass.
+    /// @returns List<taDataClass> or errors.
+    ResponseOrError readAndParseExport(const TaskWarriorExecutor &executor) const
+    {
+        const auto &schema = getSchema();
+        if (schema.empty()) {
+            throw std::logic_error(
+                "Empty FieldsSchema was provided by child class.");
+        }
+
+        const auto cmdParams = createCmdParameters() << "rc.json.array=on";
+
+        // Several lists may be read at once, each one interns to own pool.
+        const StringInternPool::LocalScope interned;
+        Response resp;
+        JsonObjectsSplitter splitter;
+        bool allParsed = true;
+        const auto res = executor.execTaskProgramStreaming(
+            cmdParams, [&](const QByteArray &chunk) {
+                splitter.feed(chunk, [&](QByteArrayView object) {
+                    allParsed = parseObject(schema, object, resp) && allParsed;
+                });
+            });
+        if (!res) {
+            return res.getError();
+        }
+        if (!allParsed || !splitter.isIdle()) {
+            return ErrorParsingJson{};
+        }
+        finalizeResponse(resp);
+        return resp;
+    }
+
+  protected:
+    struct FieldDescriptor {
+        QString json_key;
+        std::function<void(const QJsonValue & /*value*/, taDataClass &)>
+            field_handler;
+    };
+    using FieldsSchema = std::vector<FieldDescriptor>;
+
+    /// @brief Children classes should return JSON keys (as it is exported by
+    /// taskwarriror) with bound handlers. Handler is not called if key is
+    /// missing in the object.
+    [[nodiscard]] virtual const FieldsSchema &getSchema() const = 0;
+
+    /// @brief Children must build and @return final cmd parameters usable for
+    /// taskwarrior call, including filter and `export` command itself.
+    [[nodiscard]] virtual QStringList createCmdParameters() const = 0;
+
+    /// @brief Children may post-process whole response, like sort it.
+    virtual void finalizeResponse(Response & /*resp*/) const {}
+
+    /// @brief Parses already received output of `task export`.
+    /// @returns std::nullopt if some object could not be parsed.
+    static std::optional<Response> parseExportOutput(const FieldsSchema &schema,
+                                                     QByteArrayView output)
+    {
+        Response resp;
+        JsonObjectsSplitter splitter;
+        bool allParsed = true;
+        splitter.feed(output, [&](QByteArrayView object) {
+            allParsed = parseObject(schema, object, resp) && allParsed;
+        });
+        if (!allParsed || !splitter.isIdle()) {
+            return std::nullopt;
+        }
+        return resp;
+    }
+
+    /// @brief Parses single exported @p object and appends it to @p resp.
+    /// @returns false if @p object is not valid JSON object.
+    static bool parseObject(const FieldsSchema &schema, QByteArrayView object,
+                            Response &resp)
+    {
+        QJsonParseError error{};
+        // fromRawData() avoids copy, object outlives the call.
+        const auto doc = QJsonDocument::fromJson(
+            QByteArray::fromRawData(object.data(), object.size()), &error);
+        if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+            return false;
+        }
+        const QJsonObject json = doc.object();
+
+        resp.emplace_back();
+        auto &output = resp.last();
+        for (const auto &field : schema) {
+            const auto value = json.value(field.json_key);
+            if (!value.isUndefined()) {
+                field.field_handler(value, output);
+            }
+        }
+        return true;
+    }
+};
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QtConcurrent> //NOLINT
+
+#include <cstdint>
+#include <utility>
+
+/// @brief Runs loading on the global thread pool and passes result to the
+/// thread of @p context (GUI thread). Each start gets next generation number,
+/// result is passed only if no other start happened after it, so stale data
+/// never overwrites fresh one.
+/// @tparam taResult - type returned by the worker, it must be copyable.
+/// @note Object must be a member of @p context, so it lives as long as
+/// watchers do.
+template <typename taResult>
+class LatestAsyncResult {
+  public:
+    using Generation = std::uint64_t;
+
+    explicit LatestAsyncResult(QObject *context)
+        : m_context(context)
+    {
+    }
+
+    /// @brief Calls @p worker in background and @p receiver with its result
+    /// in the thread of context, unless newer loading was started meanwhile.
+    /// @returns generation of the started loading.
+    template <typename taWorker, typename taReceiver>
+    Generation start(taWorker worker, taReceiver receiver)
+    {
+        const auto generation = ++m_generation;
+        ++m_running;
+        auto *watcher = new QFutureWatcher<taResult>(m_context);
+        QObject::connect(
+            watcher, &QFutureWatcher<taResult>::finished, m_context,
+            [this, watcher, generation, receiver = std::move(receiver)]() {
+                // This is GUI thread.
+                watcher->deleteLater();
+                --m_running;
+                if (generation == m_generation) {
+                    receiver(watcher->result());
+                }
+            });
+        watcher->setFuture(QtConcurrent::run(std::move(worker)));
+        return generation;
+    }
+
+    /// @brief Drops results of all started loadings.
+    void invalidate() { ++m_generation; }
+
+    /// @returns true if some started loading did not finish yet.
+    [[nodiscard]]
+    bool isRunning() const
+    {
+        return m_running > 0;
+    }
+
+  private:
+    QObject *m_context;
+    Generation m_generation{ 0 };
+    int m_running{ 0 };
+};
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <qtypes.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/// @brief Computes row operations which turn old list into the new one, when
+/// each element has unique key (like task's UUID). Operations are ordered the
+/// way QAbstractItemModel expects them to be signaled, each one is expressed
+/// in coordinates of the list as it is right before that operation.
+/// @note Elements which keep relative order (longest increasing subsequence)
+/// are never moved, so a single task changing place costs a single move.
+class ListDiff {
+  public:
+    struct Operation {
+        enum class Kind : std::uint8_t { Remove, Move, Insert };
+        Kind kind;
+        /// @brief 1st affected row of the current list.
+        int row;
+        /// @brief Count of removed or inserted rows, always 1 for move.
+        int count;
+        /// @brief Move only: row before which element is moved (as
+        /// QAbstractItemModel::beginMoveRows() expects it).
+        int destination;
+        /// @brief Insert only: index of the 1st inserted element in the new
+        /// list.
+        int source;
+    };
+    using Operations = std::vector<Operation>;
+
+    /// @returns operations or std::nullopt if keys are not unique or if more
+    /// than @p max_moves elements must be moved or inserted. In last case
+    /// caller should better reset whole list.
+    template <typename taKey>
+    [[nodiscard]]
+    static std::optional<Operations> compute(const QList<taKey> &old_keys,
+                                             const QList<taKey> &new_keys,
+                                             const qsizetype max_moves)
+    {
+        const auto newSize = static_cast<int>(new_keys.size());
+        QHash<taKey, int> newIndexes;
+        newIndexes.reserve(newSize);
+        for (int i = 0; i < newSize; ++i) {
+            const auto it = newIndexes.constFind(new_keys.at(i));
+            if (it != newIndexes.cend()) {
+                return std::nullopt;
+            }
+            newIndexes.insert(new_keys.at(i), i);
+        }
+
+        Operations ops;
+        // Index in the new list for each element of the old one, or -1.
+        std::vector<int> current;
+        current.reserve(old_keys.size());
+        std::vector<bool> inOld(newSize, false);
+        for (const auto &key : old_keys) {
+            const int target = newIndexes.value(key, -1);
+            if (target >= 0) {
+                if (inOld[target]) {
+                    return std::nullopt;
+                }
+                inOld[target] = true;
+            }
+            current.push_back(target);
+        }
+
+        // Removals go backward, so rows of not yet removed ranges stay valid.
+        for (int i = static_cast<int>(current.size()) - 1; i >= 0; --i) {
+            if (current[i] >= 0) {
+                continue;
+            }
+            int first = i;
+            while (first > 0 && current[first - 1] < 0) {
+                --first;
+            }
+            ops.push_back({ Operation::Kind::Remove, first, i - first + 1, 0,
+                            0 });
+            i = first;
+        }
+        current.erase(std::remove(current.begin(), current.end(), -1),
+                      current.end());
+
+        const auto stable = longestIncreasingSubsequence(current);
+        const auto movedCount =
+            newSize - static_cast<qsizetype>(stable.size());
+        if (movedCount > max_moves) {
+            return std::nullopt;
+        }
+        std::vector<bool> isStable(newSize, false);
+        for (const int target : stable) {
+            isStable[target] = true;
+        }
+
+        // Each not stable element is placed right before the 1st stable one
+        // which must follow it. Elements are placed in order of the new list,
+        // so elements between 2 stable ones end up sorted. That gives fixed
+        // order of the slots: each gap before stable element keeps original
+        // places of the not stable elements and then their final places.
+        // Rows are counted over present slots, so no linear search is made.
+        const auto oldSize = static_cast<int>(current.size());
+        std::vector<int> originalSlot(newSize, -1);
+        std::vector<int> finalSlot(newSize, -1);
+        int slotsCount = 0;
+        int nextPlaced = 0;
+        const auto placeFinalsBefore = [&](int end) {
+            for (; nextPlaced < end; ++nextPlaced) {
+                if (!isStable[nextPlaced]) {
+                    finalSlot[nextPlaced] = slotsCount++;
+                }
+            }
+        };
+        for (const int target : current) {
+            if (isStable[target]) {
+                placeFinalsBefore(target);
+                nextPlaced = target + 1;
+            }
+            originalSlot[target] = slotsCount++;
+        }
+        placeFinalsBefore(newSize);
+
+        PresentSlots present(slotsCount);
+        for (const int target : current) {
+            present.add(originalSlot[target], 1);
+        }
+        int presentCount = oldSize;
+
+        std::size_t nextStable = 0;
+        for (int k = 0; k < newSize; ++k) {
+            while (nextStable < stable.size() && stable[nextStable] <= k) {
+                ++nextStable;
+            }
+            if (isStable[k]) {
+                continue;
+            }
+            const int anchor =
+                nextStable < stable.size()
+                    ? present.countBefore(originalSlot[stable[nextStable]])
+                    : presentCount;
+            if (!inOld[k]) {
+                if (!ops.empty() &&
+                    ops.back().kind == Operation::Kind::Insert &&
+                    ops.back().row + ops.back().count == anchor &&
+                    ops.back().source + ops.back().count == k) {
+                    ++ops.back().count;
+                } else {
+                    ops.push_back(
+                        { Operation::Kind::Insert, anchor, 1, 0, k });
+                }
+                present.add(finalSlot[k], 1);
+                ++presentCount;
+                continue;
+            }
+            const int from = present.countBefore(originalSlot[k]);
+            if (from + 1 == anchor) {
+                // Already in place, original slot is right before anchor.
+                continue;
+            }
+            ops.push_back({ Operation::Kind::Move, from, 1, anchor, 0 });
+            present.add(originalSlot[k], -1);
+            present.add(finalSlot[k], 1);
+        }
+        return ops;
+    }
+
+  private:
+    /// @brief Fenwick tree of the slots flags, it counts present slots before
+    /// given one in O(log n).
+    class PresentSlots {
+      public:
+        explicit PresentSlots(int size)
+            : m_tree(size + 1, 0)
+        {
+        }
+
+        void add(int slot, int delta)
+        {
+            for (auto i = static_cast<std::size_t>(slot) + 1; i < m_tree.size();
+                 i += i & (~i + 1)) {
+                m_tree[i] += delta;
+            }
+        }
+
+        [[nodiscard]]
+        int countBefore(int slot) const
+        {
+            int res = 0;
+            for (auto i = static_cast<std::size_t>(slot); i > 0;
+                 i -= i & (~i + 1)) {
+                res += m_tree[i];
+            }
+            return res;
+        }
+
+      private:
+        std::vector<int> m_tree;
+    };
+
+    /// @returns values of the longest strictly increasing subsequence of
+    /// @p values.
+    static std::vector<int>
+    longestIncreasingSubsequence(const std::vector<int> &values)
+    {
+        // tails[l] is index of the smallest tail of subsequences of length
+        // l + 1.
+        std::vector<int> tails;
+        std::vector<int> previous(values.size(), -1);
+        for (int i = 0, sz = static_cast<int>(values.size()); i < sz; ++i) {
+            const auto pos = std::lower_bound(
+                tails.begin(), tails.end(), values[i],
+                [&values](int index, int value) {
+                    return values[index] < value;
+                });
+            if (pos != tails.begin()) {
+                previous[i] = *(pos - 1);
+            }
+            if (pos == tails.end()) {
+                tails.push_back(i);
+            } else {
+                *pos = i;
+            }
+        }
+        std::vector<int> res(tails.size());
+        for (int i = tails.empty() ? -1 : tails.back(),
+                 l = static_cast<int>(tails.size()) - 1;
+             i >= 0; i = previous[i], --l) {
+            res[l] = values[i];
+        }
+        return res;
+    }
+};
@@ -54,7 +54,8 @@ int main(int argc, char *argv[])
                 return EXIT_SUCCESS;
             auto t = dlg->getTask();
             Taskwarrior task_provider;
-            return (task_provider.addTask(t)) ? EXIT_SUCCESS : EXIT_FAILURE;
+            return task_provider.addTask(t).result() ? EXIT_SUCCESS
+                                                     : EXIT_FAILURE;
         }
     }
 
@@ -2,12 +2,14 @@
 
 #include <QAbstractItemView>
 #include <QApplication>
+#include <QClipboard>
 #include <QCoreApplication>
 #include <QDebug>
 #include <QDesktopServices>
 #include <QDialog>
 #include <QEvent>
 #include <QGridLayout>
+#include <QHideEvent>
 #include <QHeaderView>
 #include <QItemSelectionModel>
 #include <QLineEdit>
@@ -17,10 +19,10 @@
 #include <QMessageBox>
 #include <QModelIndexList>
 #include <QObject>
+#include <QShowEvent>
 #include <QStringList>
 #include <QSystemTrayIcon>
 #include <QTableView>
-#include <QTimer>
 #include <QToolBar>
 #include <QVariant>
 #include <QWindowStateChangeEvent>
@@ -34,12 +36,15 @@
 #include "agendadialog.hpp"
 #include "configmanager.hpp"
 #include "datetimedialog.hpp"
+#include "poll_scheduler.hpp"
 #include "qtutil.hpp"
 #include "recurringdialog.hpp"
 #include "settingsdialog.hpp"
 #include "tagsedit.hpp"
 #include "task.hpp"
 #include "task_ids_providers.hpp"
+#include "tasks_snapshot.hpp"
+#include "tasks_snapshot_store.hpp"
 #include "taskdescriptiondelegate.hpp"
 #include "taskdialog.hpp"
 #include "taskhintproviderdelegate.hpp"
@@ -92,7 +97,6 @@ MainWindow::MainWindow()
               return tasksListToIds(getSelectedTaskInModel(), kTaskUuidGetter);
           },
           this))
-
 {
     if (!m_task_provider->init()) {
         QMessageBox::critical(
@@ -128,23 +132,19 @@ MainWindow::MainWindow()
     ConfigManager::config().get(ConfigManager::HideWindowOnStartup) ? hide()
                                                                     : show();
 
-    m_do_not_lock_ui.setSingleShot(true);
-    m_do_not_lock_ui.setInterval(45000);
-    connect(&m_do_not_lock_ui, &QTimer::timeout, this,
-            [this]() { m_tasks_view->setEnabled(true); });
-
-    connect(m_data_model, &TasksModel::modelReset, this, [this]() {
-        if (m_tasks_view) {
-            QTimer::singleShot(50, m_tasks_view, [this]() {
-                m_do_not_lock_ui.stop();
-                m_tasks_view->setEnabled(true);
-                m_tasks_view->resizeColumnToContents(0);
-            });
-        }
-    });
-
     connect(m_data_model, &TasksModel::globalUrgencyChanged, m_tray_icon,
             &SystemTrayIcon::updateStatusIcon);
+    connect(m_data_model, &TasksModel::mutationsFailed, this,
+            [this](int failed_count) {
+                QMessageBox::warning(
+                    this, tr("Error"),
+                    failed_count == 1
+                        ? tr("Taskwarrior failed to apply the change, it was "
+                             "reverted.")
+                        : tr("Taskwarrior failed to apply %1 changes, those "
+                             "were reverted.")
+                              .arg(failed_count));
+            });
 }
 
 MainWindow::~MainWindow() { m_task_provider.reset(); }
@@ -276,27 +276,25 @@ void MainWindow::initToolsMenu()
     auto *agenda_action = new QAction("&Agenda view", this);
     tools_menu->addAction(agenda_action);
     agenda_action->setShortcut(kAgendaViewShortcut);
-    connect(agenda_action, &QAction::triggered, this, [&]() {
-        if (auto tasks = m_task_provider->getUrgencySortedTasks()) {
-            auto *dlg = new AgendaDialog(std::move(*tasks), this);
-            dlg->open();
-            QObject::connect(dlg, &QDialog::finished, dlg,
-                             &QDialog::deleteLater);
-        }
+    connect(agenda_action, &QAction::triggered, this, [this]() {
+        m_agenda_requested = true;
+        openRequestedDialogs(m_data_model->snapshots()->current());
     });
 
     auto *recurring_action = new QAction("&Recurring templates", this);
     tools_menu->addAction(recurring_action);
     recurring_action->setShortcut(kRecurrentViewShortcut);
-    connect(recurring_action, &QAction::triggered, this, [&]() {
-        if (auto tasks = m_task_provider->getRecurringTasks()) {
-            auto *dlg = new RecurringDialog(std::move(*tasks), this);
-            dlg->open();
-            QObject::connect(dlg, &QDialog::finished, dlg,
-                             &QDialog::deleteLater);
-        }
+    connect(recurring_action, &QAction::triggered, this, [this]() {
+        m_recurring_requested = true;
+        m_data_model->snapshots()->requestRecurring();
+        openRequestedDialogs(m_data_model->snapshots()->current());
     });
 
+    // Dialogs requested before the lists were read are opened when those are
+    // ready.
+    connect(m_data_model->snapshots(), &TasksSnapshotStore::snapshotChanged,
+            this, &MainWindow::openRequestedDialogs);
+
     // FIXME:/TODO: not sure what is it, but connected slot is WRONG.
     //  auto *history_stats_action = new QAction("&Statistics", this);
     //  history_stats_action->setEnabled(false);
@@ -307,6 +305,23 @@ void MainWindow::initToolsMenu()
     tools_menu->setVisible(false);
 }
 
+void MainWindow::openRequestedDialogs(const TasksSnapshot::Ptr &snapshot)
+{
+    if (m_agenda_requested && snapshot->version > 0) {
+        m_agenda_requested = false;
+        auto *dlg = new AgendaDialog(
+            m_task_provider->filterTasks(*snapshot), this);
+        dlg->open();
+        QObject::connect(dlg, &QDialog::finished, dlg, &QDialog::deleteLater);
+    }
+    if (m_recurring_requested && snapshot->recurring.has_value()) {
+        m_recurring_requested = false;
+        auto *dlg = new RecurringDialog(*snapshot->recurring, this);
+        dlg->open();
+        QObject::connect(dlg, &QDialog::finished, dlg, &QDialog::deleteLater);
+    }
+}
+
 void MainWindow::initHelpMenu()
 {
     QMenu *help_menu = menuBar()->addMenu(tr("&Help"));
@@ -362,8 +377,9 @@ void MainWindow::connectTaskToolbarActions()
         // It will be enabled back by incoming UndoTracker::undoAvail if
         // possible. Just ensuring here it will not be fast clicked.
         m_toolbar_actions.m_undo_action->setEnabled(false);
-        m_task_provider->undoTask();
-        m_data_model->refreshIfChangedOnDisk();
+        if (m_task_provider->undoTask()) {
+            m_data_model->refreshModel();
+        }
     });
 
     connect(m_toolbar_actions.m_refresh_action, &QAction::triggered,
@@ -380,10 +396,13 @@ void MainWindow::connectTaskToolbarActions()
             new DateTimeDialog(QDateTime::currentDateTime().addDays(1), this);
         dlg->open();
         QObject::connect(dlg, &QDialog::accepted, [this, dlg]() {
-            if (m_task_provider->waitTask(getSelectedTaskShortIds(),
-                                          dlg->getDateTime())) {
-                m_data_model->refreshIfChangedOnDisk();
-            }
+            const auto datetime = dlg->getDateTime();
+            const auto uuids = getSelectedTaskUuids();
+            m_data_model->applyOptimistic(
+                m_task_provider->waitTask(uuids, datetime), uuids,
+                [datetime](DetailedTaskInfo &task) {
+                    task.set(task.wait, datetime);
+                });
         });
         QObject::connect(dlg, &QDialog::finished, dlg, &QDialog::deleteLater);
     });
@@ -393,14 +412,22 @@ void MainWindow::connectTaskToolbarActions()
 
     connect(m_toolbar_actions.m_start_action, &QAction::triggered, this,
             [this]() {
-                m_task_provider->startTasks(getSelectedTaskInModel());
-                m_data_model->refreshIfChangedOnDisk();
+                m_data_model->applyOptimistic(
+                    m_task_provider->startTasks(getSelectedTaskInModel()),
+                    getSelectedTaskUuids(),
+                    [](DetailedTaskInfo &task) {
+                        task.set(task.active, true);
+                    });
             });
 
     connect(m_toolbar_actions.m_stop_action, &QAction::triggered, this,
             [this]() {
-                m_task_provider->stopTasks(getSelectedTaskInModel());
-                m_data_model->refreshIfChangedOnDisk();
+                m_data_model->applyOptimistic(
+                    m_task_provider->stopTasks(getSelectedTaskInModel()),
+                    getSelectedTaskUuids(),
+                    [](DetailedTaskInfo &task) {
+                        task.set(task.active, false);
+                    });
             });
 }
 
@@ -467,22 +494,31 @@ void MainWindow::quitApp()
 bool MainWindow::eventFilter(QObject *watched, QEvent *event)
 {
     auto set_task_priority = [&](DetailedTaskInfo::Priority p) {
-        const auto *smodel = m_tasks_view->selectionModel();
-        if (!smodel->hasSelection()) {
+        const auto uuids = getSelectedTaskUuids();
+        if (uuids.isEmpty()) {
             return;
         }
-        for (const QModelIndex idx : smodel->selectedRows()) {
-            auto item = m_data_model->itemData(idx);
-            if (!item[0].isNull()) {
-                m_task_provider->setPriority(item[0].toString(), p);
-                break;
-            }
+        // All selected tasks are written by single `task` call.
+        QList<DetailedTaskInfo> changed;
+        changed.reserve(uuids.size());
+        for (const auto &uuid : uuids) {
+            DetailedTaskInfo task;
+            task.task_uuid = uuid;
+            task.set(task.priority, p);
+            changed << task;
         }
+        m_data_model->applyOptimistic(
+            m_task_provider->writeTasks(std::move(changed)), uuids,
+            [p](DetailedTaskInfo &task) { task.set(task.priority, p); });
     };
 
     if (watched == m_tasks_view && event->type() == QEvent::KeyPress) {
         const auto keyEvent = dynamic_cast<QKeyEvent *>(event);
         assert(keyEvent);
+        if (keyEvent->matches(QKeySequence::Paste)) {
+            onPasteTasks();
+            return true;
+        }
 
         switch (keyEvent->key()) {
         case Qt::Key_Escape:
@@ -520,6 +556,19 @@ void MainWindow::changeEvent(QEvent *evt)
     QMainWindow::changeEvent(evt);
 }
 
+void MainWindow::showEvent(QShowEvent *event)
+{
+    // Minimizing also sends show/hide events.
+    PollScheduler::instance().setWindowVisible(true);
+    QMainWindow::showEvent(event);
+}
+
+void MainWindow::hideEvent(QHideEvent *event)
+{
+    PollScheduler::instance().setWindowVisible(false);
+    QMainWindow::hideEvent(event);
+}
+
 void MainWindow::closeEvent(QCloseEvent *event)
 {
     if (!m_is_quit && m_tray_icon->isVisible()) {
@@ -541,6 +590,11 @@ std::optional<QString> MainWindow::getSelectedTaskShortId() const
     return sel.front();
 }
 
+QStringList MainWindow::getSelectedTaskUuids() const
+{
+    return tasksListToIds(getSelectedTaskInModel(), kTaskUuidGetter);
+}
+
 QStringList MainWindow::getSelectedTaskShortIds() const
 {
     return tasksListToIds(getSelectedTaskInModel(), kTaskIdShortGetter);
@@ -603,30 +657,56 @@ void MainWindow::onAddTask()
                      &AddTaskDialog::acceptContinue);
     QObject::connect(dlg, &QDialog::accepted, [this, dlg]() {
         Q_ASSERT(dlg);
-        auto t = dlg->getTask();
-        if (m_task_provider->addTask(t)) {
-            m_data_model->refreshIfChangedOnDisk();
-        }
+        // New task has no ID yet, it is shown when list is re-read.
+        m_data_model->applyOptimistic(m_task_provider->addTask(dlg->getTask()),
+                                      {});
     });
     QObject::connect(dlg, &QDialog::rejected, m_data_model,
                      &TasksModel::refreshIfChangedOnDisk);
     QObject::connect(dlg, &AddTaskDialog::createTaskAndContinue, [this, dlg]() {
         Q_ASSERT(dlg);
-        auto t = dlg->getTask();
-        if (m_task_provider->addTask(t)) {
-            m_data_model->refreshIfChangedOnDisk();
-            emit acceptContinueCreatingTasks();
-        } else {
-            dlg->close();
-        }
+        m_data_model->applyOptimistic(m_task_provider->addTask(dlg->getTask()),
+                                      {});
+        emit acceptContinueCreatingTasks();
     });
     QObject::connect(dlg, &QDialog::finished, dlg, &QDialog::deleteLater);
 }
 
+void MainWindow::onPasteTasks()
+{
+    // Each not empty line of the clipboard is the description of new task.
+    QList<DetailedTaskInfo> tasks;
+    const auto lines = QApplication::clipboard()->text().split('\n');
+    for (const auto &line : lines) {
+        const auto description = line.trimmed();
+        if (!description.isEmpty()) {
+            DetailedTaskInfo task;
+            task.set(task.description, description);
+            tasks << task;
+        }
+    }
+    if (tasks.isEmpty()) {
+        return;
+    }
+    const auto question_to_show =
+        (tasks.size() == 1)
+            ? tr("Create task \"%1\"?").arg(tasks.first().description.get())
+            : tr("Create %1 tasks from clipboard?").arg(tasks.size());
+    if (QMessageBox::question(this, tr("Confirm action"), question_to_show,
+                              QMessageBox::Yes | QMessageBox::No) ==
+        QMessageBox::Yes) {
+        // All tasks are created by single `task import`, those are shown when
+        // list is re-read.
+        m_data_model->applyOptimistic(
+            m_task_provider->writeTasks(std::move(tasks)), {});
+    }
+}
+
 void MainWindow::onDeleteTasks()
 {
-    const auto selectedTasks = getSelectedTaskShortIds();
-    const auto selectedCount = selectedTasks.size();
+    // Queued command runs later, when IDs could be renumbered already.
+    const auto uuids = getSelectedTaskUuids();
+    const auto selectedCount = uuids.size();
     if (selectedCount == 0) {
         return;
     }
@@ -638,10 +718,8 @@ void MainWindow::onDeleteTasks()
                               QMessageBox::Yes | QMessageBox::No) ==
         QMessageBox::Yes) {
         m_tasks_view->selectionModel()->clearSelection();
-        m_tasks_view->setEnabled(false);
-        m_do_not_lock_ui.start();
-        m_task_provider->deleteTask(selectedTasks);
-        m_data_model->refreshIfChangedOnDisk();
+        m_data_model->applyOptimistic(m_task_provider->deleteTask(uuids),
+                                      uuids);
     }
 }
 
@@ -650,15 +728,23 @@ void MainWindow::onSetTasksDone()
     if (!m_tasks_view->selectionModel()->hasSelection()) {
         return;
     }
-    m_task_provider->setTaskDone(getSelectedTaskShortIds());
+    const auto uuids = getSelectedTaskUuids();
+    const auto done = m_task_provider->setTaskDone(uuids);
     m_tasks_view->selectionModel()->clearSelection();
-    m_data_model->refreshIfChangedOnDisk();
+    m_data_model->applyOptimistic(done, uuids);
 }
 
 void MainWindow::onApplyFilter()
 {
-    if (m_task_provider->applyFilter(m_task_filter->getTags())) {
-        m_data_model->refreshModel();
+    const bool applied =
+        m_task_provider->applyFilter(m_task_filter->getTags());
+    if (auto *delegate = qobject_cast<TaskDescriptionDelegate *>(
+            m_tasks_view->itemDelegateForColumn(2 /* description */))) {
+        delegate->setHighlightedText(m_task_provider->fuzzySearchText());
+        m_tasks_view->viewport()->update();
+    }
+    if (applied) {
+        m_data_model->applyFilter();
         return;
     }
     m_data_model->refreshIfChangedOnDisk();
@@ -685,7 +771,11 @@ void MainWindow::showEditTaskDialog([[maybe_unused]] const QModelIndex &idx)
         return;
     }
     const auto &id_str = *id_opt;
-    const auto task = m_task_provider->getTask(id_str);
+    // Details of the visible rows are usually loaded already.
+    const auto selected = getSelectedTaskInModel();
+    const auto task = !selected.isEmpty() && selected.front().isFullRead()
+                          ? std::optional(selected.front())
+                          : m_task_provider->getTask(id_str);
     if (!task) {
         m_data_model->refreshIfChangedOnDisk();
         return;
@@ -699,16 +789,18 @@ void MainWindow::showEditTaskDialog([[maybe_unused]] const QModelIndex &idx)
 
     auto dlg = QPointer<EditTaskDialog>(new EditTaskDialog(*task, this));
     QObject::connect(dlg, &EditTaskDialog::deleteTask, this,
-                     [&](const QString &uuid) {
-                         m_task_provider->deleteTask(uuid);
+                     [this](const QString &uuid) {
                          m_tasks_view->selectionModel()->clearSelection();
-                         m_data_model->refreshIfChangedOnDisk();
+                         m_data_model->applyOptimistic(
+                             m_task_provider->deleteTask(uuid), { uuid });
                      });
     QObject::connect(dlg, &QDialog::accepted, [this, dlg, id_str]() {
         Q_ASSERT(dlg);
         auto tmp = dlg->getTask();
-        m_task_provider->editTask(tmp);
-        m_data_model->refreshIfChangedOnDisk();
+        const auto uuid = tmp.task_uuid;
+        m_data_model->applyOptimistic(
+            m_task_provider->editTask(tmp), { uuid },
+            [tmp](DetailedTaskInfo &task) { task.updateFrom(tmp); });
     });
     QObject::connect(dlg, &QDialog::rejected, m_data_model,
                      &TasksModel::refreshIfChangedOnDisk);
@@ -7,15 +7,16 @@
 #include <QCloseEvent>
 #include <QEvent>
 #include <QGridLayout>
+#include <QHideEvent>
 #include <QLineEdit>
 #include <QList>
 #include <QMainWindow>
 #include <QObject>
 #include <QPointer>
+#include <QShowEvent>
 #include <QStringList>
 #include <QSystemTrayIcon>
 #include <QTableView>
-#include <QTimer>
 #include <QVariant>
 
 #include <qnamespace.h>
@@ -24,6 +25,7 @@
 
 #include "tagsedit.hpp"
 #include "task.hpp"
+#include "tasks_snapshot.hpp"
 #include "tasksmodel.hpp"
 #include "tasksview.hpp"
 #include "taskwarrior.hpp"
@@ -58,10 +60,13 @@ class MainWindow : public QMainWindow {
 
     bool eventFilter(QObject *watched, QEvent *event) override;
     void changeEvent(QEvent *) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
     void closeEvent(QCloseEvent *event) override;
 
     [[nodiscard]] std::optional<QString> getSelectedTaskShortId() const;
     [[nodiscard]] QStringList getSelectedTaskShortIds() const;
+    [[nodiscard]] QStringList getSelectedTaskUuids() const;
     [[nodiscard]] QList<DetailedTaskInfo> getSelectedTaskInModel() const;
   public slots:
     /// Add entry to tags filter
@@ -78,6 +83,7 @@ class MainWindow : public QMainWindow {
     void onToggleTaskShell(bool checked);
     void onSettingsMenu();
     void onAddTask();
+    void onPasteTasks();
     void onDeleteTasks();
     void onSetTasksDone();
     void onEnterTaskCommand();
@@ -86,6 +92,7 @@ class MainWindow : public QMainWindow {
     void showEditTaskDialog(const QModelIndex &);
 
     void updateTaskToolbar();
+    void openRequestedDialogs(const TasksSnapshot::Ptr &snapshot);
   signals:
     void acceptContinueCreatingTasks();
 
@@ -130,7 +137,9 @@ class MainWindow : public QMainWindow {
     std::shared_ptr<Taskwarrior> m_task_provider;
     TasksModel *m_data_model;
 
-    QTimer m_do_not_lock_ui;
+    // Dialogs are opened as soon as snapshot has their data.
+    bool m_agenda_requested{ false };
+    bool m_recurring_requested{ false };
 };
 
 } // namespace ui
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrent> //NOLINT
+#include <qtypes.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+/// @brief Parsing of the long outputs, which are split into chunks parsed in
+/// parallel, results are concatenated in the original order.
+namespace OrderedChunks
+{
+/// @brief Inputs having less items are parsed on the calling thread.
+inline constexpr qsizetype kParallelMinItems = 5000;
+/// @brief Less items per chunk do not pay for the threading.
+/// @note Both are checked by DISABLED_BenchmarkParallelScaling test.
+inline constexpr qsizetype kParallelMinItemsPerChunk = 1000;
+
+/// @brief Parses [ @p first, @p last ) by @p parse_range, in parallel chunks
+/// on @p pool if there are at least kParallelMinItems items.
+/// @tparam taParse - Callable (taIt from, taIt to) -> container, which has
+/// append() of the same container (like QList).
+/// @tparam taIsChunkStart - Callable (taIt) -> bool, chunk border is moved
+/// forward until it returns true, so records spanning several items are not
+/// split. Independent items may return true always.
+/// @param pool - nullptr means global pool.
+/// @note The caller does the 1st chunk itself instead of blocking.
+template <typename taIt, typename taParse, typename taIsChunkStart>
+auto parse(taIt first, taIt last, const taParse &parse_range,
+           const taIsChunkStart &isChunkStart, QThreadPool *pool = nullptr)
+{
+    if (pool == nullptr) {
+        pool = QThreadPool::globalInstance();
+    }
+    const auto items = static_cast<qsizetype>(std::distance(first, last));
+    const auto chunksCount = std::min<qsizetype>(
+        pool->maxThreadCount(), items / kParallelMinItemsPerChunk);
+    if (items < kParallelMinItems || chunksCount < 2) {
+        return parse_range(first, last);
+    }
+
+    std::vector<taIt> borders{ first };
+    for (qsizetype i = 1; i < chunksCount; ++i) {
+        auto border = std::next(first, items * i / chunksCount);
+        border = std::max(border, borders.back());
+        while (border != last && !isChunkStart(border)) {
+            ++border;
+        }
+        if (border != borders.back() && border != last) {
+            borders.emplace_back(border);
+        }
+    }
+    borders.emplace_back(last);
+
+    using TResult = decltype(parse_range(first, last));
+    std::vector<QFuture<TResult>> futures;
+    futures.reserve(borders.size() - 1);
+    for (std::size_t i = 1; i + 1 < borders.size(); ++i) {
+        futures.emplace_back(QtConcurrent::run(
+            pool, [&parse_range, from = borders[i], to = borders[i + 1]]() {
+                return parse_range(from, to);
+            }));
+    }
+    TResult res = parse_range(borders[0], borders[1]);
+    for (auto &future : futures) {
+        res.append(future.result());
+    }
+    return res;
+}
+} // namespace OrderedChunks
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+/// @brief Decides if change of data on disk was already patched into rows
+/// from hooks, so full refresh can be skipped.
+/// @note Each change reported by hooks adds one undo transaction. Change on
+/// disk is skipped only if undo count grew by not more than patched calls in
+/// time. Undo (count decreases or stays) and commands which do not call hooks
+/// (count grows more) are always refreshed.
+class PatchedChangesGate {
+  public:
+    /// @brief Hooks are called before data is written, so change on disk is
+    /// expected soon after patching.
+    static constexpr qint64 kValidityMs = 3000;
+
+    /// @brief Rows were patched by @p calls changes reported by hooks at
+    /// @p now_ms.
+    void patched(qsizetype calls, qint64 now_ms)
+    {
+        m_expected_calls =
+            isExpected(now_ms) ? m_expected_calls + calls : calls;
+        m_patched_at_ms = now_ms;
+    }
+
+    /// @brief Rows were changed other way, next change must be refreshed.
+    void invalidate()
+    {
+        m_expected_calls = 0;
+    }
+
+    /// @returns true if change on disk with @p undo_count at @p now_ms must be
+    /// re-read.
+    [[nodiscard]]
+    bool needsRefresh(std::uint64_t undo_count, qint64 now_ms)
+    {
+        const auto previous = std::exchange(m_undo_count, undo_count);
+        if (!isExpected(now_ms) || !previous || undo_count <= *previous ||
+            undo_count - *previous > static_cast<std::uint64_t>(
+                                         m_expected_calls)) {
+            invalidate();
+            return true;
+        }
+        // Data may be written by parts, the rest is expected still.
+        m_expected_calls -= static_cast<qsizetype>(undo_count - *previous);
+        return false;
+    }
+
+  private:
+    [[nodiscard]]
+    bool isExpected(qint64 now_ms) const
+    {
+        return m_expected_calls > 0 && now_ms - m_patched_at_ms <= kValidityMs;
+    }
+
+    qsizetype m_expected_calls{ 0 };
+    qint64 m_patched_at_ms{ 0 };
+    /// @brief Undo count of the last change on disk.
+    std::optional<std::uint64_t> m_undo_count;
+};
@@ -14,8 +14,15 @@
 
 class IPereodicExec { // NOLINT
   public:
+    /// @brief Period which disables own timer, so executions happen only on
+    /// execNow(). It is used when some external scheduler decides timing.
+    static constexpr std::chrono::milliseconds kOnDemandOnly{ 0 };
+
     virtual ~IPereodicExec() = default;
     virtual void execNow() = 0;
+    /// @brief Changes delay between executions, it is applied after the
+    /// current one.
+    virtual void setPeriod(std::chrono::milliseconds period) = 0;
 };
 
 /// @tparam taPereodicCallable callable which executed in dedicated thread and
@@ -56,9 +63,7 @@ class PereodicAsynExec : public IPereodicExec {
          * vary (kCheckPeriod + async_duration), sacrificing precise timing for
          * reliability.
          * * 2. Multi-Shot (Rejected approach):
-         * A steady, periodic timer risks starting a new  private:
-    taPereodicCallable m_callable;
-    taPereodicParamsProvider m_params_provider; check before the
+         * A steady, periodic timer risks starting a new check before the
          * previous asynchronous database reading (which takes ~100ms with 9
          * tasks present) has finished, leading to race conditions or
          * unnecessary overlapping requests, especially when dealing with large
@@ -67,7 +72,7 @@ class PereodicAsynExec : public IPereodicExec {
         m_timer.setSingleShot(true);
         m_timer.setInterval(kCheckPeriod.count());
         QObject::connect(&m_timer, &QTimer::timeout, &m_timer,
-                         [this]() { execNow(); });
+                         [this]() { start(false); });
 
         QObject::connect(
             &m_future_reader, &QFutureWatcher<ReturnType>::finished,
@@ -81,7 +86,16 @@ class PereodicAsynExec : public IPereodicExec {
                               "taPereodicCallable return type! "
                               "It must accept a parameter of type ReturnType.");
                 m_result_receiver(m_future_reader.future().result());
-                m_timer.start();
+                m_running = false;
+                // Request which came while thread was running is not lost,
+                // it is executed right now instead of waiting for the timer.
+                if (m_rerun_requested.exchange(false)) {
+                    start(true);
+                    return;
+                }
+                if (m_timer.interval() > 0) {
+                    m_timer.start();
+                }
             },
             Qt::QueuedConnection);
     }
@@ -103,16 +117,42 @@ class PereodicAsynExec : public IPereodicExec {
     }
 
     /// @brief Tries to execute check regardless of the current timer state.
+    /// If thread is running already, single follow-up execution is scheduled
+    /// right after it, so changes which happened during current execution are
+    /// not missed.
     /// @note It is safe to call from any thread. taPereodicParamsProvider()
     /// will be called in the same thread as caller.
     void execNow() override
+    {
+        start(true);
+    }
+
+    /// @note It must be called from the GUI thread.
+    void setPeriod(std::chrono::milliseconds period) override
+    {
+        if (period == kOnDemandOnly) {
+            m_timer.stop();
+        }
+        m_timer.setInterval(period.count());
+    }
+
+  private:
+    /// @param rerunIfBusy - schedule follow-up execution if thread is running.
+    /// Timer does not need it, it is restarted after current execution anyway.
+    void start(const bool rerunIfBusy)
     {
         if (!testAndFlip(m_avoid_overlapping_execs, false)) {
+            requestRerun(rerunIfBusy);
             return;
         }
-        if (!m_future_reader.isFinished()) {
+        // Result is delivered by queued call, thread is considered running
+        // until receiver got it.
+        if (m_running) {
+            requestRerun(rerunIfBusy);
+            m_avoid_overlapping_execs = false;
             return;
         }
+        m_running = true;
 
         const auto future = QtConcurrent::run(
             [this](auto tuple) {
@@ -124,7 +164,13 @@ class PereodicAsynExec : public IPereodicExec {
         m_avoid_overlapping_execs = false;
     }
 
-  private:
+    void requestRerun(const bool rerunIfBusy)
+    {
+        if (rerunIfBusy) {
+            m_rerun_requested = true;
+        }
+    }
+
     taPereodicCallable m_callable;
     taPereodicParamsProvider m_params_provider;
     taResultReceiver m_result_receiver;
@@ -132,6 +178,8 @@ class PereodicAsynExec : public IPereodicExec {
     QFutureWatcher<ReturnType> m_future_reader;
     QTimer m_timer;
     std::atomic<bool> m_avoid_overlapping_execs{ false };
+    std::atomic<bool> m_running{ false };
+    std::atomic<bool> m_rerun_requested{ false };
 
     static inline bool testAndFlip(std::atomic<bool> &var, const bool expected)
     {
@@ -0,0 +1,197 @@
+#include "poll_scheduler.hpp"
+
+#include "pereodic_async_executor.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QObject>
+#include <QTimer>
+#include <QtGlobal>
+#include <qnamespace.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace
+{
+/// @brief Job is executed earlier by this part of its period if timer woke up
+/// for other job anyway.
+constexpr qint64 kCoalesceDivider = 10;
+
+bool isUserInput(const QEvent::Type type)
+{
+    switch (type) {
+    case QEvent::KeyPress:
+    case QEvent::MouseButtonPress:
+    case QEvent::MouseMove:
+    case QEvent::Wheel:
+    case QEvent::TouchBegin:
+        return true;
+    default:
+        return false;
+    }
+}
+} // namespace
+
+PollScheduler &PollScheduler::instance()
+{
+    // Parented to application, so it is destroyed while Qt is still alive.
+    static auto *const instance =
+        new PollScheduler(QCoreApplication::instance());
+    return *instance;
+}
+
+PollScheduler::PollScheduler(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+    m_since_input.start();
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &PollScheduler::runDue);
+    if (auto *app = QCoreApplication::instance()) {
+        app->installEventFilter(this);
+    }
+}
+
+void PollScheduler::add(QObject *owner, IPereodicExec *job,
+                        const std::chrono::milliseconds period)
+{
+    job->setPeriod(IPereodicExec::kOnDemandOnly);
+    const auto now = m_clock.elapsed();
+    m_jobs.push_back(
+        { job, period, now, now + effectivePeriod(period).count() });
+    connect(owner, &QObject::destroyed, this, [this, job]() { remove(job); });
+    restartTimer();
+}
+
+void PollScheduler::setPeriod(IPereodicExec *job,
+                              const std::chrono::milliseconds period)
+{
+    const auto it =
+        std::find_if(m_jobs.begin(), m_jobs.end(),
+                     [job](const Job &j) { return j.exec == job; });
+    if (it == m_jobs.end()) {
+        return;
+    }
+    it->period = period;
+    reschedule();
+}
+
+void PollScheduler::remove(IPereodicExec *job)
+{
+    m_jobs.erase(std::remove_if(m_jobs.begin(), m_jobs.end(),
+                                [job](const Job &j) { return j.exec == job; }),
+                 m_jobs.end());
+    restartTimer();
+}
+
+void PollScheduler::setWindowVisible(const bool visible)
+{
+    if (m_window_visible == visible) {
+        return;
+    }
+    m_window_visible = visible;
+    if (visible) {
+        m_since_input.restart();
+        m_idle = false;
+        catchUp();
+    } else {
+        reschedule();
+    }
+}
+
+std::chrono::milliseconds
+PollScheduler::effectivePeriod(const std::chrono::milliseconds period) const
+{
+    const int factor =
+        (m_window_visible ? 1 : kHiddenBackoff) * (m_idle ? kIdleBackoff : 1);
+    if (factor == 1) {
+        return period;
+    }
+    return std::max(period, std::min(period * factor, kMaxBackedOffPeriod));
+}
+
+bool PollScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    if (isUserInput(event->type())) {
+        m_since_input.restart();
+        setIdle(false);
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void PollScheduler::runDue()
+{
+    // Idle state is checked lazily, there is no need to wake up for it.
+    if (m_since_input.hasExpired(kIdleAfter.count())) {
+        setIdle(true);
+    }
+    const auto now = m_clock.elapsed();
+    for (auto &job : m_jobs) {
+        const auto slack =
+            effectivePeriod(job.period).count() / kCoalesceDivider;
+        if (job.next_run <= now + slack) {
+            run(job, now);
+        }
+    }
+    restartTimer();
+}
+
+void PollScheduler::catchUp()
+{
+    const auto now = m_clock.elapsed();
+    for (auto &job : m_jobs) {
+        if (now - job.last_run >= job.period.count()) {
+            run(job, now);
+        }
+    }
+    reschedule();
+}
+
+void PollScheduler::run(Job &job, const qint64 now)
+{
+    job.last_run = now;
+    job.next_run = now + effectivePeriod(job.period).count();
+    job.exec->execNow();
+}
+
+void PollScheduler::reschedule()
+{
+    for (auto &job : m_jobs) {
+        job.next_run = job.last_run + effectivePeriod(job.period).count();
+    }
+    restartTimer();
+}
+
+void PollScheduler::restartTimer()
+{
+    if (m_jobs.empty()) {
+        m_timer.stop();
+        return;
+    }
+    qint64 next = std::numeric_limits<qint64>::max();
+    for (const auto &job : m_jobs) {
+        next = std::min(next, job.next_run);
+    }
+    // While nobody looks at the window, second precision is enough and lets
+    // OS group wake ups.
+    m_timer.setTimerType(m_window_visible && !m_idle ? Qt::CoarseTimer
+                                                     : Qt::VeryCoarseTimer);
+    m_timer.start(
+        static_cast<int>(std::max<qint64>(0, next - m_clock.elapsed())));
+}
+
+void PollScheduler::setIdle(const bool idle)
+{
+    if (m_idle == idle) {
+        return;
+    }
+    m_idle = idle;
+    if (idle) {
+        reschedule();
+    } else {
+        catchUp();
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "pereodic_async_executor.hpp"
+
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QObject>
+#include <QTimer>
+#include <QtGlobal>
+
+#include <chrono>
+#include <vector>
+
+/// @brief Single timer which runs all registered background polls.
+/// Polls which are due close to each other are executed by the same wake up.
+/// Polls are done rarer while main window is hidden or user does not touch
+/// the application and are caught up as soon as window is shown again.
+/// @note All methods must be called from the GUI thread.
+class PollScheduler : public QObject {
+    Q_OBJECT
+  public:
+    /// @brief Polls are this times rarer while main window is hidden.
+    static constexpr int kHiddenBackoff = 6;
+    /// @brief Polls are this times rarer while there is no user input.
+    static constexpr int kIdleBackoff = 3;
+    /// @brief Backing off never makes period longer than this.
+    static constexpr std::chrono::milliseconds kMaxBackedOffPeriod =
+        std::chrono::minutes(30);
+    /// @brief Application is idle if there was no input during this time.
+    static constexpr std::chrono::milliseconds kIdleAfter =
+        std::chrono::minutes(10);
+
+    /// @brief Scheduler used by all watchers of the application.
+    static PollScheduler &instance();
+
+    explicit PollScheduler(QObject *parent = nullptr);
+
+    /// @brief Takes over timing of the @p job, its own timer is disabled.
+    /// @param owner - registration is removed when it is destroyed, it should
+    /// be the object which owns @p job.
+    /// @note First execution still must be requested by execNow().
+    void add(QObject *owner, IPereodicExec *job,
+             std::chrono::milliseconds period);
+
+    void setPeriod(IPereodicExec *job, std::chrono::milliseconds period);
+
+    void remove(IPereodicExec *job);
+
+    /// @brief Main window reports its visibility by this.
+    void setWindowVisible(bool visible);
+
+    /// @returns period which is used now instead of @p period.
+    [[nodiscard]]
+    std::chrono::milliseconds
+    effectivePeriod(std::chrono::milliseconds period) const;
+
+  protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+  private:
+    struct Job {
+        IPereodicExec *exec;
+        std::chrono::milliseconds period;
+        qint64 last_run;
+        qint64 next_run;
+    };
+
+    void runDue();
+    /// @brief Executes jobs which missed their not backed off period.
+    void catchUp();
+    void run(Job &job, qint64 now);
+    /// @brief Recomputes next executions from the last ones and restarts
+    /// timer.
+    void reschedule();
+    void restartTimer();
+    void setIdle(bool idle);
+
+    std::vector<Job> m_jobs;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    QElapsedTimer m_since_input;
+    /// @brief It becomes true on first show.
+    bool m_window_visible{ false };
+    bool m_idle{ false };
+};
@@ -2,6 +2,7 @@
 #include "tabular_stencil_base.hpp"
 #include "taskwarriorexecutor.hpp"
 
+#include <QByteArrayView>
 #include <QList>
 #include <QString>
 
@@ -23,18 +24,20 @@ class RecurringTasksReader : public TabularStencilBase<RecurringTaskTemplate> {
         static const ColumnsSchema schema = {
             {
                 "id",
-                [](const QString &v, RecurringTaskTemplate &t,
+                nullptr,
+                [](QByteArrayView v, RecurringTaskTemplate &t,
                    ColumnDescriptor::LineMode m) {
                     SKIP_CONTINUATION;
-                    t.uuid = v.trimmed();
+                    t.uuid = QString::fromLatin1(v);
                 },
             },
             {
                 "recur",
-                [](const QString &v, RecurringTaskTemplate &t,
+                nullptr,
+                [](QByteArrayView v, RecurringTaskTemplate &t,
                    ColumnDescriptor::LineMode m) {
                     SKIP_CONTINUATION;
-                    t.period = v.trimmed();
+                    t.period = QString::fromLatin1(v);
                 },
             },
             {
@@ -0,0 +1,117 @@
+#include "rendered_document_cache.hpp"
+
+#include "qtutil.hpp"
+
+#include <QAbstractTextDocumentLayout>
+#include <QFont>
+#include <QFontMetrics>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+#include <QString>
+#include <QTextBlock>
+#include <QTextDocument>
+#include <QTextFragment>
+#include <QTextLayout>
+#include <QTextLine>
+#include <QtMinMax>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+QString makeKey(const QString &text, const QSize &size, const QFont &font)
+{
+    return QString("%1x%2 %3\n%4")
+        .arg(size.width())
+        .arg(size.height())
+        .arg(font.key(), text);
+}
+
+/// @returns areas of the links, so hit test does not need layout queries.
+QList<RenderedDocumentCache::Entry::Anchor>
+collectAnchors(const QTextDocument &document)
+{
+    QList<RenderedDocumentCache::Entry::Anchor> res;
+    const auto *layout = document.documentLayout();
+    for (auto block = document.begin(); block.isValid();
+         block = block.next()) {
+        const auto *text_layout = block.layout();
+        const auto origin = layout->blockBoundingRect(block).topLeft();
+        for (auto it = block.begin(); !it.atEnd(); ++it) {
+            const auto fragment = it.fragment();
+            if (!fragment.isValid() || !fragment.charFormat().isAnchor()) {
+                continue;
+            }
+            const int start = fragment.position() - block.position();
+            const int end = start + fragment.length();
+            for (int i = 0; i < text_layout->lineCount(); ++i) {
+                const auto line = text_layout->lineAt(i);
+                const int from = std::max(start, line.textStart());
+                const int to =
+                    std::min(end, line.textStart() + line.textLength());
+                if (from >= to) {
+                    continue;
+                }
+                const QRectF rect(QPointF(line.cursorToX(from), line.y()),
+                                  QPointF(line.cursorToX(to),
+                                          line.y() + line.height()));
+                res << RenderedDocumentCache::Entry::Anchor{
+                    rect.normalized().translated(origin),
+                    fragment.charFormat().anchorHref()
+                };
+            }
+        }
+    }
+    return res;
+}
+} // namespace
+
+QString RenderedDocumentCache::Entry::anchorAt(const QPointF &point) const
+{
+    const auto it = std::find_if(
+        anchors.cbegin(), anchors.cend(),
+        [&point](const auto &anchor) { return anchor.rect.contains(point); });
+    return it == anchors.cend() ? QString() : it->href;
+}
+
+const RenderedDocumentCache::Entry &
+RenderedDocumentCache::get(const QString &text, const QSize &size,
+                           const QFont &font)
+{
+    const auto key = makeKey(text, size, font);
+    if (const auto *entry = m_entries.object(key)) {
+        return *entry;
+    }
+
+    auto *entry = new Entry();
+    auto &document = entry->document;
+    setContentOfTextDocument(document, text);
+    if (m_decorator) {
+        m_decorator(document);
+    }
+    document.setTextWidth(size.width());
+
+    // Note, here we assume 1 line rows. If ever it could be more than 1 line
+    // per 1 row, it should be revised.
+    const QFontMetrics fm(font);
+    entry->elide_needed =
+        document.size().height() / qMax<qreal>(1.0, fm.height()) > 1.5f;
+
+    document.setPageSize(size);
+    entry->anchors = collectAnchors(document);
+
+    // Cache takes ownership, entry stays until following insertions.
+    m_entries.insert(key, entry);
+    return *entry;
+}
+
+void RenderedDocumentCache::setDecorator(Decorator decorator)
+{
+    m_decorator = std::move(decorator);
+    clear();
+}
+
+void RenderedDocumentCache::clear() { m_entries.clear(); }
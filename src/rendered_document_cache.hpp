@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QCache>
+#include <QFont>
+#include <QList>
+#include <QPointF>
+#include <QRectF>
+#include <QSize>
+#include <QString>
+#include <QTextDocument>
+
+#include <functional>
+
+/// @brief Laid out markdown descriptions by text and cell size, so painting
+/// rows and hovering links do not parse and lay out the same text again. The
+/// least recently used documents are dropped when cache is full.
+class RenderedDocumentCache {
+  public:
+    static constexpr int kMaxDocuments = 512;
+
+    /// @brief Changes freshly parsed document before layout is cached, it is
+    /// used for highlighting.
+    using Decorator = std::function<void(QTextDocument &)>;
+
+    struct Entry {
+        struct Anchor {
+            QRectF rect;
+            QString href;
+        };
+
+        QTextDocument document;
+        /// @brief True if text does not fit into single line of the cell.
+        bool elide_needed{ false };
+        /// @brief Areas of the links in document coordinates.
+        QList<Anchor> anchors;
+
+        /// @returns link at @p point or empty string.
+        [[nodiscard]]
+        QString anchorAt(const QPointF &point) const;
+    };
+
+    /// @returns document of @p text laid out for a cell of @p size.
+    /// @note Reference is valid until the next call.
+    [[nodiscard]]
+    const Entry &get(const QString &text, const QSize &size, const QFont &font);
+
+    /// @brief Sets @p decorator of the new documents and drops cached ones.
+    void setDecorator(Decorator decorator);
+
+    void clear();
+
+  private:
+    QCache<QString, Entry> m_entries{ kMaxDocuments };
+    Decorator m_decorator;
+};
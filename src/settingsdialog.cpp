@@ -24,6 +24,11 @@ SettingsDialog::SettingsDialog(QWidget *parent)
           new QCheckBox(tr("Hide QTask window on startup"), this))
     , m_save_filter_on_exit(new QCheckBox(tr("Save task filter on exit"), this))
     , m_mute_notifications_cb(new QCheckBox(tr("Mute notifications"), this))
+    , m_read_storage_directly_cb(new QCheckBox(
+          tr("Read tasks directly from Taskwarrior database (faster)"),
+          this))
+    , m_forward_task_changes_cb(new QCheckBox(
+          tr("Update tasks list instantly using Taskwarrior hooks"), this))
     , m_buttons(new QDialogButtonBox(QDialogButtonBox::Ok |
                                          QDialogButtonBox::Apply |
                                          QDialogButtonBox::Close,
@@ -32,7 +37,9 @@ SettingsDialog::SettingsDialog(QWidget *parent)
         { ConfigManager::TaskBin, m_task_bin_edit },
         { ConfigManager::HideWindowOnStartup, m_hide_on_startup_cb },
         { ConfigManager::SaveFilterOnExit, m_save_filter_on_exit },
-        { ConfigManager::MuteNotifications, m_mute_notifications_cb }
+        { ConfigManager::MuteNotifications, m_mute_notifications_cb },
+        { ConfigManager::ReadStorageDirectly, m_read_storage_directly_cb },
+        { ConfigManager::ForwardTaskChanges, m_forward_task_changes_cb }
     }
 
 {
@@ -58,14 +65,22 @@ void SettingsDialog::initUI()
     main_layout->addWidget(m_hide_on_startup_cb, 1, 0, 1, 2);
     main_layout->addWidget(m_save_filter_on_exit, 2, 0, 1, 2);
     main_layout->addWidget(m_mute_notifications_cb, 3, 0, 1, 2);
+    main_layout->addWidget(m_read_storage_directly_cb, 4, 0, 1, 2);
+    m_read_storage_directly_cb->setToolTip(
+        tr("Tasks are still modified by the task executable. If database "
+           "cannot be read, the task executable is used for reading too."));
+    main_layout->addWidget(m_forward_task_changes_cb, 5, 0, 1, 2);
+    m_forward_task_changes_cb->setToolTip(
+        tr("Installs on-add and on-modify hooks, which pass changed tasks to "
+           "QTask while it is running."));
 
     // Spacer
-    main_layout->setRowMinimumHeight(4, 10);
+    main_layout->setRowMinimumHeight(6, 10);
 
     // Buttons
     connect(m_buttons, &QDialogButtonBox::clicked, this,
             &SettingsDialog::onButtonBoxClicked);
-    main_layout->addWidget(m_buttons, 5, 0, 1, 2);
+    main_layout->addWidget(m_buttons, 7, 0, 1, 2);
 
     setLayout(main_layout);
 
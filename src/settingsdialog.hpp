@@ -38,6 +38,8 @@ class SettingsDialog : public QDialog {
     QCheckBox *const m_hide_on_startup_cb;
     QCheckBox *const m_save_filter_on_exit;
     QCheckBox *const m_mute_notifications_cb;
+    QCheckBox *const m_read_storage_directly_cb;
+    QCheckBox *const m_forward_task_changes_cb;
     QDialogButtonBox *const m_buttons;
 
     // Binds config keys with widgets.
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <QByteArrayView>
 #include <QRegularExpression>
 #include <QRegularExpressionMatch>
 #include <QString>
 
+#include <cstddef>
+#include <cstring>
 #include <initializer_list>
+#include <vector>
 
 /// @brief Takes 1st word as key and everything else - as value.
 /// Key must be aligned to begin of the string, any amount of space/tabs can
@@ -43,3 +47,27 @@ struct SplitString {
         return !key.isEmpty();
     }
 };
+
+/// @brief Splits raw @p output into lines without copying it.
+/// @returns views of non empty lines, those are valid while @p output is.
+/// @note "\r\n" line endings are accepted too.
+inline std::vector<QByteArrayView> splitRawLines(QByteArrayView output)
+{
+    std::vector<QByteArrayView> lines;
+    const char *pos = output.data();
+    const char *const end = pos + output.size();
+    while (pos < end) {
+        const auto *eol = static_cast<const char *>(
+            std::memchr(pos, '\n', static_cast<std::size_t>(end - pos)));
+        const char *next = eol != nullptr ? eol + 1 : end;
+        const char *lineEnd = eol != nullptr ? eol : end;
+        if (lineEnd > pos && *(lineEnd - 1) == '\r') {
+            --lineEnd;
+        }
+        if (lineEnd > pos) {
+            lines.emplace_back(pos, lineEnd - pos);
+        }
+        pos = next;
+    }
+    return lines;
+}
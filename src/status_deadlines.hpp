@@ -0,0 +1,133 @@
+#pragma once
+
+#include "task.hpp"
+#include "task_date_time.hpp"
+
+#include <QDateTime>
+#include <QList>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <vector>
+
+/// @brief Min-heap of the moments when dates of the tasks change their
+/// DatesRelation to now, so nobody needs to re-check all tasks periodically.
+/// Each date has at most 2 transitions: Future to Approaching when warning
+/// interval begins and Approaching to Past right after the date.
+class StatusDeadlines {
+  public:
+    /// @brief Milliseconds since epoch.
+    using TimeMs = qint64;
+
+    /// @brief Deadlines removed by takePassed().
+    struct Passed {
+        /// @brief Sorted unique indexes of the tasks which changed relation.
+        QList<int> rows;
+        /// @brief Some scheduled or wait date became Past. Those change
+        /// urgency by step (TaskUrgency::compute()), so order of the tasks
+        /// could change, while other transitions only change colors.
+        bool reorders{ false };
+    };
+
+    /// @brief Replaces deadlines by ones of @p tasks, deadlines refer tasks by
+    /// index in this list.
+    void rebuild(const QList<DetailedTaskInfo> &tasks, TimeMs now)
+    {
+        std::vector<Deadline> deadlines;
+        deadlines.reserve(static_cast<std::size_t>(tasks.size()));
+        for (int row = 0, sz = static_cast<int>(tasks.size()); row < sz;
+             ++row) {
+            const auto &task = tasks.at(row);
+            addDeadline(deadlines, row, task.due.get(), now);
+            addDeadline(deadlines, row, task.sched.get(), now);
+            addDeadline(deadlines, row, task.wait.get(), now);
+        }
+        m_heap = Heap(std::greater<>{}, std::move(deadlines));
+    }
+
+    /// @returns the earliest deadline or std::nullopt if no date will change
+    /// its relation anymore.
+    [[nodiscard]]
+    std::optional<TimeMs> next() const
+    {
+        if (m_heap.empty()) {
+            return std::nullopt;
+        }
+        return m_heap.top().at;
+    }
+
+    /// @brief Removes all deadlines passed at @p now and queues following
+    /// transitions of the same dates.
+    [[nodiscard]]
+    Passed takePassed(TimeMs now)
+    {
+        Passed res;
+        while (!m_heap.empty() && m_heap.top().at <= now) {
+            const auto passed = m_heap.top();
+            m_heap.pop();
+            res.rows << passed.row;
+            // Transition to Past is the one after the date itself.
+            res.reorders = res.reorders ||
+                           (passed.role != ETaskDateTimeRole::Due &&
+                            passed.at > passed.date);
+            if (const auto following =
+                    nextTransition(passed.date, passed.warning, now)) {
+                m_heap.push({ *following, passed.row, passed.date,
+                              passed.warning, passed.role });
+            }
+        }
+        std::sort(res.rows.begin(), res.rows.end());
+        res.rows.erase(std::unique(res.rows.begin(), res.rows.end()),
+                       res.rows.end());
+        return res;
+    }
+
+    /// @returns the first moment after @p now when relation of @p date with
+    /// @p warning interval changes or std::nullopt if it is Past already.
+    [[nodiscard]]
+    static std::optional<TimeMs> nextTransition(TimeMs date, TimeMs warning,
+                                                TimeMs now)
+    {
+        // Matches TaskDateTime::relationToNow().
+        if (now < date - warning) {
+            return date - warning;
+        }
+        if (now <= date) {
+            return date + 1;
+        }
+        return std::nullopt;
+    }
+
+  private:
+    struct Deadline {
+        TimeMs at;
+        int row;
+        TimeMs date;
+        TimeMs warning;
+        ETaskDateTimeRole role;
+
+        bool operator>(const Deadline &other) const { return at > other.at; }
+    };
+    using Heap =
+        std::priority_queue<Deadline, std::vector<Deadline>, std::greater<>>;
+
+    template <ETaskDateTimeRole taRole>
+    static void addDeadline(std::vector<Deadline> &deadlines, int row,
+                            const TaskDateTime<taRole> &date, TimeMs now)
+    {
+        if (!date.has_value()) {
+            return;
+        }
+        const TimeMs dateMs = date.toMSecsSinceEpoch();
+        const TimeMs warningMs = TaskDateTime<taRole>::warning_interval().count();
+        if (const auto at = nextTransition(dateMs, warningMs, now)) {
+            deadlines.push_back({ *at, row, dateMs, warningMs, taRole });
+        }
+    }
+
+    Heap m_heap;
+};
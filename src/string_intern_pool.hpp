@@ -0,0 +1,122 @@
+#pragma once
+
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+#include <mutex>
+
+/// @brief Process-wide pool of the strings repeated by many tasks, like
+/// projects and tags. QString is implicitly shared, so all tasks keep single
+/// copy of the text returned by intern().
+/// @note It is thread safe, lists are read in background threads.
+class StringInternPool {
+  public:
+    /// @brief While it exists, intern() on the same thread uses own pool
+    /// without locking. Its strings are merged into the process pool once
+    /// on destruction. It is meant for the chunks of the lists parsed in
+    /// parallel, so those do not wait for each other per string.
+    /// @note Scopes may be nested, inner one is merged on its own.
+    class LocalScope {
+      public:
+        LocalScope()
+            : m_outer(t_local)
+        {
+            t_local = &m_strings;
+        }
+
+        ~LocalScope()
+        {
+            t_local = m_outer;
+            instance().merge(m_strings);
+        }
+
+        LocalScope(const LocalScope &) = delete;
+        LocalScope &operator=(const LocalScope &) = delete;
+        LocalScope(LocalScope &&) = delete;
+        LocalScope &operator=(LocalScope &&) = delete;
+
+      private:
+        QSet<QString> m_strings;
+        QSet<QString> *m_outer;
+    };
+
+    /// @returns string equal to @p text which shares data with pooled one.
+    [[nodiscard]]
+    static QString intern(const QString &text)
+    {
+        if (text.isEmpty()) {
+            return {};
+        }
+        if (t_local != nullptr) {
+            return insertOrFind(*t_local, text);
+        }
+        auto &pool = instance();
+        const std::lock_guard lock(pool.m_mutex);
+        return insertOrFind(pool.m_strings, text);
+    }
+
+    /// @returns @p texts with each element interned.
+    [[nodiscard]]
+    static QStringList intern(QStringList texts)
+    {
+        for (auto &text : texts) {
+            text = intern(text);
+        }
+        return texts;
+    }
+
+    /// @brief Drops strings which nothing except the pool refers to, e.g.
+    /// projects of the tasks which are not listed anymore.
+    static void evictUnused()
+    {
+        auto &pool = instance();
+        const std::lock_guard lock(pool.m_mutex);
+        pool.m_strings.removeIf(
+            [](const QString &text) { return text.isDetached(); });
+    }
+
+    /// @returns count of the different strings in pool.
+    [[nodiscard]]
+    static qsizetype size()
+    {
+        auto &pool = instance();
+        const std::lock_guard lock(pool.m_mutex);
+        return pool.m_strings.size();
+    }
+
+  private:
+    StringInternPool() = default;
+
+    static StringInternPool &instance()
+    {
+        static StringInternPool pool;
+        return pool;
+    }
+
+    static QString insertOrFind(QSet<QString> &strings, const QString &text)
+    {
+        const auto it = strings.constFind(text);
+        if (it != strings.cend()) {
+            return *it;
+        }
+        strings.insert(text);
+        return text;
+    }
+
+    /// @brief Adds strings of local pool, which are not known yet.
+    void merge(const QSet<QString> &strings)
+    {
+        if (strings.isEmpty()) {
+            return;
+        }
+        const std::lock_guard lock(m_mutex);
+        m_strings.unite(strings);
+    }
+
+    std::mutex m_mutex;
+    QSet<QString> m_strings;
+
+    inline static thread_local QSet<QString> *t_local = nullptr;
+};
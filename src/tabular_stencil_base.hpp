@@ -1,10 +1,13 @@
 #pragma once
 
+#include "ordered_chunks.hpp"
+#include "split_string.hpp"
 #include "task_table_stencil.hpp"
 #include "taskwarriorexecutor.hpp"
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iterator>
@@ -12,13 +15,21 @@
 #include <variant>
 #include <vector>
 
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDate>
+#include <QDateTime>
 #include <QList>
 #include <QString>
 #include <QStringList>
+#include <QThreadPool>
+#include <QTime>
 #include <qtypes.h>
 
 /// @brief Base class to request and parse tables in output.
 /// It must be subclassed, children are responsible to provide details.
+/// @note The pending list is read by JsonExportReaderBase, tables are left
+/// for short reports, like recurring templates, those are parsed as raw bytes.
 template <typename taDataClass>
 class TabularStencilBase {
   public:
@@ -51,32 +62,36 @@ class TabularStencilBase {
                                << "rc.print.empty.columns=yes"
                                << "rc.dateformat=Y-M-DTH:N:S";
 
-        const auto res = executor.execTaskProgramWithDefaults(cmdParams);
+        // Output is kept as raw bytes, lines and cells are views into it, so
+        // only cells which handlers need as QString are decoded.
+        QByteArray stdOut;
+        const auto res = executor.execTaskProgramStreaming(
+            cmdParams,
+            [&stdOut](const QByteArray &chunk) { stdOut.append(chunk); });
         if (!res) {
             return res.getError();
         }
 
-        auto stdOut = res.getStdout();
-        stdOut.removeAll("");
-        if (!isTaskSentData(stdOut)) {
+        const auto lines = splitRawLines(stdOut);
+        if (!isTaskSentData(lines.size())) {
             return QList<taDataClass>{}; // Empty response.
         }
 
-        if (!stencil.processLabelString(stdOut.at(kRowIndexOfDividers))) {
+        if (!stencil.processLabelString(
+                QString::fromLatin1(lines.at(kRowIndexOfDividers)))) {
             return ErrorParsingLabels{}; // Could not parse labels properly.
         }
 
-        return parseConsoleOutput(schema, stencil, stdOut);
+        return parseRawConsoleOutput(schema, stencil, lines);
     }
 
-    /// @returns true if task outputed something except header and footer.
-    static bool isTaskSentData(const QStringList &task_output) // NOLINT
+    /// @returns true if output of @p lines_count non empty lines has something
+    /// except header and footer.
+    static constexpr bool isTaskSentData(qsizetype lines_count)
     {
-        // Empty lines are expected to be removed at all for this function to
-        // work.
         static constexpr qsizetype kRowsAmountWhenEmptyResponse =
             kHeadersSize + kFooterSize;
-        return task_output.size() > kRowsAmountWhenEmptyResponse;
+        return lines_count > kRowsAmountWhenEmptyResponse;
     }
 
     // Expected values in reading TaskWarrior responses.
@@ -96,6 +111,32 @@ class TabularStencilBase {
         std::function<void(const QString /*value*/ &, taDataClass &,
                            LineMode lineMode)>
             column_handler;
+        /// @brief Optional handler of not decoded value, if it is set it is
+        /// used instead of column_handler. It is for columns which are never
+        /// Unicode (ids, dates, flags), so no QString is allocated for them.
+        std::function<void(QByteArrayView /*value*/, taDataClass &,
+                           LineMode lineMode)>
+            raw_handler{};
+
+        void handle(const QString &value, taDataClass &output,
+                    LineMode lineMode) const
+        {
+            if (raw_handler) {
+                raw_handler(QByteArrayView(value.toUtf8()), output, lineMode);
+            } else {
+                column_handler(value, output, lineMode);
+            }
+        }
+
+        void handle(QByteArrayView value, taDataClass &output,
+                    LineMode lineMode) const
+        {
+            if (raw_handler) {
+                raw_handler(value, output, lineMode);
+            } else {
+                column_handler(QString::fromUtf8(value), output, lineMode);
+            }
+        }
     };
     using ColumnsSchema = std::vector<ColumnDescriptor>;
 
@@ -121,47 +162,106 @@ class TabularStencilBase {
         return names;
     }
 
-    static Response parseConsoleOutput(const ColumnsSchema &schema,
-                                       const TableStencil &stencil,
-                                       const QStringList &stdOut) // NOLINT
+    /// @brief Parses table's not decoded @p lines as returned by
+    /// splitRawLines(). Cells are passed to handlers as views, only cells
+    /// without raw_handler are decoded.
+    /// @param pool - long outputs are split into chunks parsed on @p pool (see
+    /// OrderedChunks), nullptr means global pool. Order of the records is
+    /// kept the same as printed by `task`.
+    /// @note Lines which have Unicode before the last column cannot be sliced
+    /// by byte offsets, those are decoded and parsed as QString.
+    static Response
+    parseRawConsoleOutput(const ColumnsSchema &schema,
+                          const TableStencil &stencil,
+                          const std::vector<QByteArrayView> &lines, // NOLINT
+                          QThreadPool *pool = nullptr)
+    {
+        if (!isTaskSentData(static_cast<qsizetype>(lines.size()))) {
+            return {};
+        }
+        using TLineIt = std::vector<QByteArrayView>::const_iterator;
+        const auto last = std::prev(lines.end(), kFooterSize);
+        // Chunk may start only at new record, otherwise continuation lines
+        // would be attached to nothing.
+        return OrderedChunks::parse(
+            std::next(lines.begin(), kHeadersSize), last,
+            [&schema, &stencil](TLineIt from, TLineIt to) {
+                return parseRawLines(schema, stencil, from, to);
+            },
+            [&stencil](TLineIt line) {
+                return !stencil.rawColumnAt(*line, 0).isEmpty();
+            },
+            pool);
+    }
+
+    /// @brief Parses date-time printed with rc.dateformat=Y-M-DTH:N:S, which
+    /// is requested by readAndParseTable(), without decoding it to QString.
+    /// @returns local QDateTime or invalid one if @p value has other format.
+    static QDateTime parseTableDateTime(QByteArrayView value)
+    {
+        // yyyy-MM-ddTHH:mm:ss
+        static constexpr qsizetype kExpectedLength = 19;
+        value = value.trimmed();
+        if (value.size() != kExpectedLength || value.at(4) != '-' ||
+            value.at(7) != '-' || value.at(10) != 'T' || value.at(13) != ':' ||
+            value.at(16) != ':') {
+            return {};
+        }
+        bool allDigits = true;
+        const auto number = [&value, &allDigits](qsizetype from,
+                                                 qsizetype len) {
+            int res = 0;
+            for (qsizetype i = from; i < from + len; ++i) {
+                const char c = value.at(i);
+                allDigits = allDigits && c >= '0' && c <= '9';
+                res = res * 10 + (c - '0');
+            }
+            return res;
+        };
+        const QDate date(number(0, 4), number(5, 2), number(8, 2));
+        const QTime time(number(11, 2), number(14, 2), number(17, 2));
+        if (!allDigits || !date.isValid() || !time.isValid()) {
+            return {};
+        }
+        return QDateTime(date, time);
+    }
+
+  private:
+    /// @brief Parses lines [ @p first, @p last ) of table's body.
+    template <typename taLineIt>
+    static Response parseRawLines(const ColumnsSchema &schema,
+                                  const TableStencil &stencil,
+                                  taLineIt first, taLineIt last)
     {
         Response resp;
-        resp.reserve(stdOut.size() - kHeadersSize - kFooterSize);
+        resp.reserve(std::distance(first, last));
 
-        // Pre-condition to detect continuation is that 1st column
-        // is NEVER continues. It should be ensured by children.
         bool continuation = false;
-        const auto addAndGet = [&resp]() -> taDataClass & {
-            resp.emplace_back();
-            return resp.last();
+        const auto onColumn = [&schema, &resp, &continuation](
+                                  auto index, [[maybe_unused]] const auto &name,
+                                  const auto &value) {
+            continuation = index == 0 ? value.isEmpty() : continuation;
+            if (continuation && resp.empty()) {
+                return;
+            }
+            const auto mode =
+                continuation
+                    ? ColumnDescriptor::LineMode::AdditionalLineOfExistingRecord
+                    : ColumnDescriptor::LineMode::FirstLineOfNewRecord;
+            if (!continuation && index == 0) {
+                resp.emplace_back();
+            }
+            schema.at(index).handle(value, resp.last(), mode);
         };
-        for (auto line_it = std::next(stdOut.begin(), kHeadersSize),
-                  last_it = std::prev(stdOut.end(), kFooterSize);
-             line_it != last_it; ++line_it) {
-            const auto &line = *line_it;
 
+        for (; first != last; ++first) {
+            const auto line = *first;
             if (line.trimmed().isEmpty()) {
                 continue;
             }
-            stencil.forEachColumn(
-                line, [&schema, &resp, &addAndGet, &continuation](
-                          auto index, [[maybe_unused]] const auto &name,
-                          const auto &value) {
-                    continuation = index == 0 ? value.isEmpty() : continuation;
-                    if (continuation && resp.empty()) {
-                        // We got situation when output starts by
-                        // continuation...impossible.
-                        return;
-                    }
-                    const auto mode =
-                        continuation
-                            ? ColumnDescriptor::LineMode::
-                                  AdditionalLineOfExistingRecord
-                            : ColumnDescriptor::LineMode::FirstLineOfNewRecord;
-                    auto &output =
-                        continuation || index > 0 ? resp.last() : addAndGet();
-                    schema.at(index).column_handler(value, output, mode);
-                });
+            if (!stencil.forEachRawColumn(line, onColumn)) {
+                stencil.forEachColumn(QString::fromUtf8(line), onColumn);
+            }
         }
 
         return resp;
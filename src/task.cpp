@@ -4,17 +4,21 @@
 #include "qtutil.hpp"
 #include "recurrence_instance_data.hpp"
 #include "split_string.hpp"
-#include "tabular_stencil_base.hpp"
+#include "string_intern_pool.hpp"
 #include "task_date_time.hpp"
 #include "task_ids_providers.hpp"
 #include "taskwarriorexecutor.hpp"
 
 #include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonValue>
 #include <QList>
 #include <QRegularExpression>
 #include <QString>
 #include <QStringList>
 #include <QStringLiteral>
+#include <QUuid>
 #include <QVariant>
 #include <QtAssert>
 #include <qnamespace.h>
@@ -29,6 +33,7 @@
 #include <optional>
 #include <stdexcept>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <utility>
 
@@ -94,35 +99,285 @@ QString formatDateTime(const TaskDateTime<taRole> &dt)
                      dt.has_value() ? dt->toString(Qt::ISODate) : QString());
 }
 
-// Converts many properties into 1 command line.
-template <typename taLeft, typename... taMany>
-void AppendPropertiesToCmdList(QStringList &output, const taLeft &leftProperty,
-                               taMany &&...manyProperties)
+QJsonValue priorityToJson(const DetailedTaskInfo::Priority pri)
 {
-    if (leftProperty.value.isModified()) {
-        output << leftProperty.getStringsForCmd();
+    if (pri == DetailedTaskInfo::Priority::Unset) {
+        return {};
     }
-    if constexpr (sizeof...(manyProperties) > 0) {
-        AppendPropertiesToCmdList(output,
-                                  std::forward<taMany>(manyProperties)...);
+    return QString(priorityToChar(pri));
+}
+
+QJsonValue stringToJson(const QString &value)
+{
+    return value.isEmpty() ? QJsonValue() : QJsonValue(value);
+}
+
+QJsonValue descriptionToJson(const QString &value)
+{
+    return value.trimmed();
+}
+
+QJsonValue tagsToJson(const QStringList &tags)
+{
+    return tags.isEmpty() ? QJsonValue() : QJsonArray::fromStringList(tags);
+}
+
+template <ETaskDateTimeRole taRole>
+QJsonValue dateTimeToJson(const TaskDateTime<taRole> &dt)
+{
+    if (!dt.has_value()) {
+        return {};
+    }
+    return FixedWidthDate::formatExportMSecs(dt.toMSecsSinceEpoch());
+}
+
+// Task keeps time it was started at while it is active.
+QJsonValue activeToJson(const DetailedTaskInfo &task,
+                        const QJsonValue &exported, const QDateTime &now)
+{
+    if (!task.active.get()) {
+        return {};
+    }
+    if (exported.isString()) {
+        return exported;
+    }
+    return FixedWidthDate::formatExportMSecs(now.toMSecsSinceEpoch());
+}
+
+template <auto taMember>
+bool isFieldModified(const DetailedTaskInfo &task)
+{
+    return task.isModified(task.*taMember);
+}
+
+template <auto taMember>
+void setFieldNotModified(DetailedTaskInfo &task)
+{
+    task.setNotModified(task.*taMember);
+}
+
+template <auto taMember, auto taFormatter>
+QStringList fieldToCmd(const DetailedTaskInfo &task)
+{
+    return { taFormatter((task.*taMember).get()) };
+}
+
+template <auto taMember, auto taFormatter>
+QJsonValue fieldToJson(const DetailedTaskInfo &task, const QJsonValue &,
+                       const QDateTime &)
+{
+    return taFormatter((task.*taMember).get());
+}
+
+// Sets value which came from taskwarrior, so it is not modified.
+template <auto taMember, typename taValue>
+void loadField(DetailedTaskInfo &task, taValue value)
+{
+    task.set(task.*taMember, std::move(value));
+    task.setNotModified(task.*taMember);
+}
+
+using Info = DetailedTaskInfo;
+
+template <auto taMember>
+void loadJsonDate(const QJsonValue &date, Info &task)
+{
+    using Date = std::decay_t<decltype((task.*taMember).get())>;
+    if (const auto msecs = FixedWidthDate::parseExportMSecs(date.toString())) {
+        loadField<taMember>(task, Date::fromMSecsSinceEpoch(*msecs));
+    }
+}
+
+template <auto taMember>
+void loadStorageDate(const QString &epoch, Info &task)
+{
+    using Date = std::decay_t<decltype((task.*taMember).get())>;
+    bool ok = false;
+    const qint64 secs = epoch.toLongLong(&ok);
+    if (ok) {
+        loadField<taMember>(task, Date::fromMSecsSinceEpoch(secs * 1000));
+    }
+}
+
+void loadJsonTags(const QJsonValue &value, Info &task)
+{
+    QStringList tags;
+    const auto array = value.toArray();
+    tags.reserve(array.size());
+    for (const auto &tag : array) {
+        tags << StringInternPool::intern(tag.toString());
     }
+    loadField<&Info::tags>(task, std::move(tags));
+}
+
+void loadStorageTags(const QString &value, Info &task)
+{
+    loadField<&Info::tags>(
+        task, StringInternPool::intern(value.split(',', Qt::SkipEmptyParts)));
+}
+
+// Loaders below get the same strings from JSON and from data files.
+void loadPriority(const QString &value, Info &task)
+{
+    loadField<&Info::priority>(task, Info::priorityFromString(value));
+}
+
+void loadProject(const QString &value, Info &task)
+{
+    loadField<&Info::project>(task, StringInternPool::intern(value));
+}
+
+void loadActive(const QString &start, Info &task)
+{
+    loadField<&Info::active>(task, !start.isEmpty());
+}
+
+void loadRecurrence(const QString &period, Info &task)
+{
+    task.modify(task.recurrency_period, [&period](auto &rp) {
+        if (!period.isEmpty()) {
+            rp.setRecurrent(period);
+        }
+    });
+    task.setNotModified(task.recurrency_period);
+}
+
+void loadDescription(const QString &value, Info &task)
+{
+    loadField<&Info::description>(task, value.trimmed());
+}
+
+template <auto taLoader>
+void loadJsonString(const QJsonValue &value, Info &task)
+{
+    taLoader(value.toString(), task);
+}
+
+template <auto taMember, ETaskDateTimeRole taRole, int taTokens, int taDate,
+          int taTime>
+void setInformationDate(const QString &value, Info &task)
+{
+    static const DateTimeParser parser{ taTokens, taDate, taTime };
+    task.set(task.*taMember, parser.parseDateTimeString<taRole>(value));
+}
+
+template <auto taMember, std::size_t taIndex>
+constexpr TaskFieldInfo
+makeFieldInfo(const char *json_key, const char *information_label,
+              QStringList (*to_cmd)(const Info &),
+              void (*from_json)(const QJsonValue &, Info &),
+              void (*from_storage)(const QString &, Info &),
+              void (*from_information)(const QString &, Info &),
+              QJsonValue (*to_json)(const Info &, const QJsonValue &,
+                                    const QDateTime &))
+{
+    return { taIndex,
+             json_key,
+             information_label,
+             &isFieldModified<taMember>,
+             &setFieldNotModified<taMember>,
+             to_cmd,
+             from_json,
+             from_storage,
+             to_json,
+             from_information };
 }
 
-// Cleanses "modified" flag for all given properties.
-template <typename taLeft, typename... taMany>
-bool SetPropertiesNotChanged(const bool wasTaskCallOk, taLeft &leftProperty,
-                             taMany &&...manyProperties)
+#define TASK_FIELD(member) \
+    makeFieldInfo<&Info::member, TASK_PROPERTY_INDEX(member)>
+
+// Must follow TASK_PROPERTIES_LIST order, commands are built in that order.
+constexpr std::array<TaskFieldInfo, kTaskPropertiesCount> kTaskFields = {
+    TASK_FIELD(priority)(
+        "priority", "Priority",
+        &fieldToCmd<&Info::priority, &formatPriority>,
+        &loadJsonString<&loadPriority>, &loadPriority,
+        [](const QString &v, Info &t) {
+            t.set(t.priority, Info::priorityFromString(v));
+        },
+        &fieldToJson<&Info::priority, &priorityToJson>),
+    TASK_FIELD(project)(
+        "project", "Project", &fieldToCmd<&Info::project, &formatProject>,
+        &loadJsonString<&loadProject>, &loadProject,
+        [](const QString &v, Info &t) {
+            t.set(t.project, StringInternPool::intern(v));
+        },
+        &fieldToJson<&Info::project, &stringToJson>),
+    TASK_FIELD(tags)(
+        "tags", "Tags", &fieldToCmd<&Info::tags, &formatTags>, &loadJsonTags,
+        &loadStorageTags,
+        [](const QString &v, Info &t) {
+            t.set(t.tags, StringInternPool::intern(
+                              DateTimeParser::splitSpaceSeparatedString(v)));
+        },
+        &fieldToJson<&Info::tags, &tagsToJson>),
+    TASK_FIELD(sched)(
+        "scheduled", "Scheduled",
+        &fieldToCmd<&Info::sched, &formatDateTime<ETaskDateTimeRole::Sched>>,
+        &loadJsonDate<&Info::sched>, &loadStorageDate<&Info::sched>,
+        &setInformationDate<&Info::sched, ETaskDateTimeRole::Sched, 2, 0, 1>,
+        &fieldToJson<&Info::sched, &dateTimeToJson<ETaskDateTimeRole::Sched>>),
+    TASK_FIELD(due)(
+        "due", "Due",
+        &fieldToCmd<&Info::due, &formatDateTime<ETaskDateTimeRole::Due>>,
+        &loadJsonDate<&Info::due>, &loadStorageDate<&Info::due>,
+        &setInformationDate<&Info::due, ETaskDateTimeRole::Due, 2, 0, 1>,
+        &fieldToJson<&Info::due, &dateTimeToJson<ETaskDateTimeRole::Due>>),
+    // Waiting until 2025-11-04 00:00:00
+    // so "until" word becomes 0th token of the value.
+    TASK_FIELD(wait)(
+        "wait", "Waiting",
+        &fieldToCmd<&Info::wait, &formatDateTime<ETaskDateTimeRole::Wait>>,
+        &loadJsonDate<&Info::wait>, &loadStorageDate<&Info::wait>,
+        &setInformationDate<&Info::wait, ETaskDateTimeRole::Wait, 3, 1, 2>,
+        &fieldToJson<&Info::wait, &dateTimeToJson<ETaskDateTimeRole::Wait>>),
+    // It is present only while task is active. Active has dedicated
+    // start/stop commands, it is not formatted for cmd, but import sets it.
+    TASK_FIELD(active)(
+        "start", "Start", nullptr, &loadJsonString<&loadActive>, &loadActive,
+        [](const QString &, Info &t) { t.set(t.active, true); },
+        &activeToJson),
+    // We do not pass reccurency_period to cmd and import yet.
+    TASK_FIELD(recurrency_period)(
+        "recur", "Recurrence", nullptr, &loadJsonString<&loadRecurrence>,
+        &loadRecurrence,
+        [](const QString &v, Info &t) {
+            // class RecurrentInstancePeriod does not want empty lines.
+            if (!v.isEmpty() && !v.contains("type")) {
+                t.modify(t.recurrency_period,
+                         [&v](RecurrentInstancePeriod &period) {
+                             period.setRecurrent(v);
+                         });
+            }
+        },
+        nullptr),
+    // Unlike table output, JSON keeps annotations separated, so we do not
+    // need to guess where description ends. It is multiline in "information"
+    // response, so it is read there by execReadExisting().
+    TASK_FIELD(description)(
+        "description", "Description",
+        &fieldToCmd<&Info::description, &formatDescription>,
+        &loadJsonString<&loadDescription>, &loadDescription, nullptr,
+        &fieldToJson<&Info::description, &descriptionToJson>),
+};
+
+#undef TASK_FIELD
+
+constexpr bool isInPropertiesOrder()
 {
-    if (wasTaskCallOk) {
-        leftProperty.value.setNotModified();
-        if constexpr (sizeof...(manyProperties) > 0) {
-            SetPropertiesNotChanged(wasTaskCallOk,
-                                    std::forward<taMany>(manyProperties)...);
+    for (std::size_t i = 0; i < kTaskFields.size(); ++i) {
+        if (kTaskFields.at(i).property_index != i) {
+            return false;
         }
     }
-    return wasTaskCallOk;
+    return true;
 }
 
+static_assert(kTaskFields.size() == Info::propertiesCount(),
+              "Each property of TASK_PROPERTIES_LIST must be in kTaskFields.");
+static_assert(isInPropertiesOrder(),
+              "kTaskFields must follow TASK_PROPERTIES_LIST order.");
+
 // Expected values in reading TaskWarrior responses for "information" query
 // (vertical layout). Note, tabular readers (horizontal layout) may have own
 // footers.
@@ -133,7 +388,15 @@ constexpr qsizetype kFooterSize = 1;
 // returns true if task outputed something except header and footer.
 bool isTaskSentData(const QStringList &task_output)
 {
-    return TabularStencilBase<void>::isTaskSentData(task_output);
+    // Empty lines are expected to be removed at all for this function to
+    // work.
+    return task_output.size() > kHeadersSize + kFooterSize;
+}
+
+// returns true if `task` can find task by @p id, which is ID or UUID.
+bool isTaskReference(const QString &id)
+{
+    return isInteger(id) || !QUuid::fromString(id).isNull();
 }
 
 template <qsizetype taExpectedColumnsAmount>
@@ -177,73 +440,35 @@ class InformationResponseSetters {
     /// it could be parsed properly, otherwise does nothing.
     void setField(const SplitString &split_string)
     {
-        using handler_t =
-            void (InformationResponseSetters::*)(const SplitString &);
-        const std::unordered_map<QString, handler_t> kTagToHandler = {
-            { "ID", &InformationResponseSetters::handleID },
-            { "UUID", &InformationResponseSetters::handleUUID },
-            { "Project", &InformationResponseSetters::handleProject },
-            { "Priority", &InformationResponseSetters::handlePriority },
-            { "Tags", &InformationResponseSetters::handleTags },
-            { "Start", &InformationResponseSetters::handleStart },
-            { "Waiting", &InformationResponseSetters::handleWaiting },
-            { "Scheduled", &InformationResponseSetters::handleScheduled },
-            { "Due", &InformationResponseSetters::handleDue },
-            { "Recurrence", &InformationResponseSetters::handleRecurrence },
-        };
-
-        const auto it = kTagToHandler.find(split_string.key);
-        if (it != kTagToHandler.end()) {
-            const handler_t handler = it->second;
-            (this->*handler)(split_string);
+        if (split_string.key == "ID") {
+            task.task_id = split_string.value;
+            return;
+        }
+        if (split_string.key == "UUID") {
+            task.task_uuid = split_string.value;
+            return;
+        }
+        const auto *field = labeledFields().value(split_string.key);
+        if (field != nullptr) {
+            field->from_information(split_string.value, task);
         }
     }
 
   private:
     DetailedTaskInfo &task;
 
-    // Handlers for each key.
-    void handleID(const SplitString &line) { task.task_id = line.value; }
-    void handleUUID(const SplitString &line) { task.task_uuid = line.value; }
-    void handleProject(const SplitString &line) { task.project = line.value; }
-    void handleStart(const SplitString &) { task.active = true; }
-    void handlePriority(const SplitString &line)
-    {
-        task.priority = DetailedTaskInfo::priorityFromString(line.value);
-    }
-    void handleTags(const SplitString &line)
-    {
-        task.tags = DateTimeParser::splitSpaceSeparatedString(line.value);
-    }
-    void handleWaiting(const SplitString &line)
-    {
-        // Waiting until 2025-11-04 00:00:00
-        // so "until" word becomes 0th token of SplitString::value
-        static const DateTimeParser parser{ 3, 1, 2 };
-        task.wait =
-            parser.parseDateTimeString<ETaskDateTimeRole::Wait>(line.value);
-    }
-    void handleScheduled(const SplitString &line)
-    {
-        static const DateTimeParser parser{ 2, 0, 1 };
-        task.sched =
-            parser.parseDateTimeString<ETaskDateTimeRole::Sched>(line.value);
-    }
-    void handleDue(const SplitString &line)
-    {
-        static const DateTimeParser parser{ 2, 0, 1 };
-        task.due =
-            parser.parseDateTimeString<ETaskDateTimeRole::Due>(line.value);
-    }
-    void handleRecurrence(const SplitString &line)
+    static const QHash<QString, const TaskFieldInfo *> &labeledFields()
     {
-        // class RecurrentInstancePeriod does not want empty lines.
-        if (!line.value.isEmpty() && !line.value.contains("type")) {
-            task.recurrency_period.value.modify(
-                [&line](RecurrentInstancePeriod &period) {
-                    period.setRecurrent(line.value);
-                });
-        }
+        static const auto fields = []() {
+            QHash<QString, const TaskFieldInfo *> res;
+            for (const auto &field : kTaskFields) {
+                if (field.from_information != nullptr) {
+                    res.insert(field.information_label, &field);
+                }
+            }
+            return res;
+        }();
+        return fields;
     }
 };
 
@@ -333,18 +558,6 @@ class StatResponseSetters {
 
 DetailedTaskInfo::DetailedTaskInfo(QString task_id)
     : task_id(std::move(task_id))
-    , description(&formatDescription)
-    , project(&formatProject)
-    , tags(&formatTags)
-    , sched(&formatDateTime<ETaskDateTimeRole::Sched>)
-    , due(&formatDateTime<ETaskDateTimeRole::Due>)
-    , wait(&formatDateTime<ETaskDateTimeRole::Wait>)
-    , priority(&formatPriority, Priority::Unset)
-    // active has dedicated start/stop commands, it should not be formatted for
-    // cmd
-    , active("", false)
-    // we do not pass reccurency_period to cmd yet
-    , recurrency_period("", {})
 {
 }
 
@@ -379,15 +592,30 @@ void DetailedTaskInfo::updateFrom(const DetailedTaskInfo &other)
     const auto otherProps = other.asTuple();
 
     [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-        auto updater = [](auto &left, const auto &right) {
+        auto updater = [this](auto &left, const auto &right) {
             if (left.get() != right.get()) {
-                left = right;
+                set(left, right.get());
             }
         };
         (updater(std::get<Is>(myProps), std::get<Is>(otherProps)), ...);
     }(std::make_index_sequence<std::tuple_size_v<decltype(myProps)>>{});
 }
 
+bool DetailedTaskInfo::hasSameData(const DetailedTaskInfo &other) const
+{
+    if (task_id != other.task_id || task_uuid != other.task_uuid) {
+        return false;
+    }
+    const auto myProps = asTuple();
+    const auto otherProps = other.asTuple();
+
+    return [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        return ((std::get<Is>(myProps).get() ==
+                 std::get<Is>(otherProps).get()) &&
+                ...);
+    }(std::make_index_sequence<std::tuple_size_v<decltype(myProps)>>{});
+}
+
 bool DetailedTaskInfo::execAddNewTask(const TaskWarriorExecutor &executor)
 {
     const auto exec_res = executor.execTaskProgramWithDefaults(
@@ -395,29 +623,34 @@ bool DetailedTaskInfo::execAddNewTask(const TaskWarriorExecutor &executor)
     if (!exec_res) {
         return false;
     }
-    SetPropertiesNotChanged(true, TASK_PROPERTIES_LIST);
+    setAllNotModified();
     return true;
 }
 
 bool DetailedTaskInfo::execModifyExisting(const TaskWarriorExecutor &executor)
 {
-    if (task_id.isEmpty() || !isInteger(task_id)) {
+    const auto &reference = stableReference();
+    if (!isTaskReference(reference)) {
+        return false;
+    }
+    const auto exec_res = executor.execTaskProgramWithDefaults(
+        QStringList{ reference, "modify" }
+        << getAddModifyCmdArgsFieldsRepresentation());
+    if (!exec_res) {
         return false;
     }
-    return SetPropertiesNotChanged(
-        executor.execTaskProgramWithDefaults(
-            QStringList{ "modify", task_id }
-            << getAddModifyCmdArgsFieldsRepresentation()),
-        TASK_PROPERTIES_LIST);
+    setAllNotModified();
+    return true;
 }
 
 bool DetailedTaskInfo::execReadExisting(const TaskWarriorExecutor &executor)
 {
-    if (task_id.isEmpty() || !isInteger(task_id)) {
+    const auto &reference = stableReference();
+    if (!isTaskReference(reference)) {
         return false;
     }
     const auto exec_res = executor.execTaskProgramWithDefaults(
-        QStringList{ "information", task_id });
+        QStringList{ reference, "information" });
     if (!exec_res) {
         return false;
     }
@@ -438,8 +671,8 @@ bool DetailedTaskInfo::execReadExisting(const TaskWarriorExecutor &executor)
 
     // By default task is not reccurent and it is NOT indicated on full read.
     // If it is reccurent, it will have explicit period mentioned.
-    recurrency_period.value.modify(
-        [](RecurrentInstancePeriod &period) { period.setNonRecurrent(); });
+    modify(recurrency_period,
+           [](RecurrentInstancePeriod &period) { period.setNonRecurrent(); });
 
     InformationResponseSetters setters(*this);
     std::for_each(
@@ -452,15 +685,15 @@ bool DetailedTaskInfo::execReadExisting(const TaskWarriorExecutor &executor)
             if (!split_string.isValid()) {
                 if (description_status ==
                     MultilineDescriptionStatus::InProgress) {
-                    description =
-                        description.get() + "\n" + whole_line.trimmed();
+                    set(description,
+                        description.get() + "\n" + whole_line.trimmed());
                 }
                 return;
             }
             if (split_string.key == "Description") {
                 const auto descr1 = split_string.value.trimmed();
                 if (!descr1.isEmpty()) {
-                    description = descr1;
+                    set(description, descr1);
                     description_status = MultilineDescriptionStatus::InProgress;
                 }
                 return;
@@ -470,7 +703,7 @@ bool DetailedTaskInfo::execReadExisting(const TaskWarriorExecutor &executor)
         });
 
     // After reading those are "not modified".
-    SetPropertiesNotChanged(true, TASK_PROPERTIES_LIST);
+    setAllNotModified();
     markFullRead();
     return true;
 }
@@ -482,17 +715,16 @@ bool DetailedTaskInfo::isFullRead() const
 }
 
 BatchTasksManager::BatchTasksManager(const QList<DetailedTaskInfo> &tasks)
-    : BatchTasksManager(tasksListToIds(tasks, kTaskIdShortGetter))
+    : BatchTasksManager(tasksListToIds(tasks, kTaskUuidGetter))
 {
 }
 
 BatchTasksManager::BatchTasksManager(QStringList tasks)
     : m_tasks_ids(std::move(tasks))
 {
-    const auto new_end = std::remove_if(
-        m_tasks_ids.begin(), m_tasks_ids.end(), [](const QString &task_id) {
-            return task_id.isEmpty() || !isInteger(task_id);
-        });
+    const auto new_end =
+        std::remove_if(m_tasks_ids.begin(), m_tasks_ids.end(),
+                       [](const QString &id) { return !isTaskReference(id); });
     m_tasks_ids.erase(new_end, m_tasks_ids.end());
 }
 
@@ -531,17 +763,36 @@ bool BatchTasksManager::execVerb(const QString &verb,
     if (m_tasks_ids.empty()) {
         return true;
     }
-    return executor.execTaskProgramWithDefaults(
-        { { verb, m_tasks_ids.join(','), after_ids } });
+    QStringList params = m_tasks_ids;
+    params << verb;
+    if (!after_ids.isEmpty()) {
+        params << after_ids;
+    }
+    return executor.execTaskProgramWithDefaults(params);
 }
 
 QStringList DetailedTaskInfo::getAddModifyCmdArgsFieldsRepresentation() const
 {
     QStringList result;
-    AppendPropertiesToCmdList(result, TASK_PROPERTIES_LIST);
+    for (const auto &field : kTaskFields) {
+        if (field.to_cmd != nullptr && field.is_modified(*this)) {
+            result << field.to_cmd(*this);
+        }
+    }
     return result;
 }
 
+void DetailedTaskInfo::setAllNotModified()
+{
+    modifiedFlags = 0u;
+}
+
+const std::array<TaskFieldInfo, kTaskPropertiesCount> &
+DetailedTaskInfo::fields()
+{
+    return kTaskFields;
+}
+
 TaskWarriorDbState::Optional
 TaskWarriorDbState::readCurrent(const TaskWarriorExecutor &executor)
 {
@@ -2,30 +2,81 @@
 #define TASK_HPP
 
 #include <QDateTime>
+#include <QJsonValue>
 #include <QList>
 #include <QString>
 #include <QStringList>
+#include <QtGlobal>
 #include <qtypes.h>
 #include <qvariant.h>
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <optional>
 #include <tuple>
+#include <utility>
 
 #include "recurrence_instance_data.hpp"
 #include "task_date_time.hpp"
 #include "taskproperty.hpp"
 #include "taskwarriorexecutor.hpp"
 
-// This should contain ALL TaskProperty<> fields in DetailedTaskInfo.
+// This should contain ALL TaskField<> fields in DetailedTaskInfo.
 // Description must be LAST, as it goes multiline sometimes.
 #define TASK_PROPERTIES_LIST                                              \
     priority, project, tags, sched, due, wait, active, recurrency_period, \
         description
 
+/// @brief Amount of the properties in TASK_PROPERTIES_LIST.
+inline constexpr std::size_t kTaskPropertiesCount = 9u;
+
+/// @brief Has a member per property in TASK_PROPERTIES_LIST order, so offset
+/// of the member is index of the property.
+struct TaskPropertiesOrder {
+    char TASK_PROPERTIES_LIST;
+};
+
+static_assert(sizeof(TaskPropertiesOrder) == kTaskPropertiesCount,
+              "kTaskPropertiesCount must match TASK_PROPERTIES_LIST.");
+
+/// @brief Index of the property @p member in TASK_PROPERTIES_LIST.
+#define TASK_PROPERTY_INDEX(member) offsetof(TaskPropertiesOrder, member)
+
+class DetailedTaskInfo;
+
+/// @brief Static description of one property of DetailedTaskInfo: how `task`
+/// names it and how it is read and written. Tasks keep only values, all the
+/// rest is in the single table returned by DetailedTaskInfo::fields().
+struct TaskFieldInfo {
+    /// @brief Position of the property in TASK_PROPERTIES_LIST.
+    std::size_t property_index;
+    /// @brief Attribute name in `task export` output and in task data files.
+    const char *json_key;
+    /// @brief Label in `task information` output.
+    const char *information_label;
+    bool (*is_modified)(const DetailedTaskInfo &);
+    void (*set_not_modified)(DetailedTaskInfo &);
+    /// @brief Arguments of `add` and `modify`, nullptr if property is not
+    /// written by those.
+    QStringList (*to_cmd)(const DetailedTaskInfo &);
+    /// @brief Loads not modified value from `task export` JSON.
+    void (*from_json)(const QJsonValue &, DetailedTaskInfo &);
+    /// @brief Loads not modified value from attribute of task data files,
+    /// where dates are epoch seconds and lists are comma separated.
+    void (*from_storage)(const QString &, DetailedTaskInfo &);
+    /// @brief Value for `task import` JSON, which replaces @p exported one,
+    /// null if key must be removed. @p now stamps properties which `task`
+    /// sets to the time of the change. nullptr if property is not imported.
+    QJsonValue (*to_json)(const DetailedTaskInfo &, const QJsonValue &exported,
+                          const QDateTime &now);
+    /// @brief Sets value from `task information` line, nullptr if property
+    /// needs special handling there.
+    void (*from_information)(const QString &, DetailedTaskInfo &);
+};
+
 /// @note Classes here are responsible to produce proper commands to the
 /// taskwarrior and parse it's results intact with own fields. Actual execution
 /// of the commands is done elsewhere via TaskWarriorExecutor.
@@ -44,23 +95,87 @@ class DetailedTaskInfo {
     QString task_id;
     // task_uuid is unique long id, it must remain the same always (I guess).
     QString task_uuid;
+    // urgency is computed by taskwarrior on reading (or by TaskUrgency when
+    // storage is read directly), it is used to keep lists ordered the same
+    // way `task` does. It is never written back.
+    double urgency{ 0.0 };
+    // modified is the last time task was changed, it is read only by list
+    // readers to fetch changes later, never written back.
+    QDateTime modified;
+    // annotations are texts of the task's annotations, those are read by
+    // list readers only to be searched by filter, never written back.
+    QStringList annotations;
+    // depends are UUIDs of the tasks this one depends on, those are read by
+    // list readers only to notice changed blocking, never written back.
+    QStringList depends;
 
     // Note, update TASK_PROPERTIES_LIST macros if you add/remove some
     // here.
-    TaskProperty<QString> description;
-    TaskProperty<QString> project;
-    TaskProperty<QStringList> tags; // current tags list
-    TaskProperty<TaskDateTime<ETaskDateTimeRole::Sched>> sched;
-    TaskProperty<TaskDateTime<ETaskDateTimeRole::Due>> due;
-    TaskProperty<TaskDateTime<ETaskDateTimeRole::Wait>> wait;
-    TaskProperty<Priority> priority;
-    TaskProperty<bool> active;
-    TaskProperty<RecurrentInstancePeriod> recurrency_period;
+    TaskField<QString, TASK_PROPERTY_INDEX(description)> description;
+    TaskField<QString, TASK_PROPERTY_INDEX(project)> project;
+    TaskField<QStringList, TASK_PROPERTY_INDEX(tags)> tags; // current tags list
+    TaskField<TaskDateTime<ETaskDateTimeRole::Sched>,
+              TASK_PROPERTY_INDEX(sched)>
+        sched;
+    TaskField<TaskDateTime<ETaskDateTimeRole::Due>, TASK_PROPERTY_INDEX(due)>
+        due;
+    TaskField<TaskDateTime<ETaskDateTimeRole::Wait>, TASK_PROPERTY_INDEX(wait)>
+        wait;
+    TaskField<Priority, TASK_PROPERTY_INDEX(priority)> priority;
+    // active has dedicated start/stop commands, it is not formatted for cmd.
+    TaskField<bool, TASK_PROPERTY_INDEX(active)> active;
+    TaskField<RecurrentInstancePeriod, TASK_PROPERTY_INDEX(recurrency_period)>
+        recurrency_period;
+
+    /// @brief Sets @p field of this task to @p value and marks it modified.
+    template <typename taStored, std::size_t taIndex, typename taValue>
+    void set(TaskField<taStored, taIndex> &field, taValue &&value)
+    {
+        modify(field, [&value](taStored &target) {
+            target = std::forward<taValue>(value);
+        });
+    }
+
+    /// @brief Passes value of @p field to @p callback, which changes it in
+    /// place, and marks it modified.
+    /// @param callback should be like: void func(taStored&)
+    template <typename taStored, std::size_t taIndex, typename taCallable>
+    void modify(TaskField<taStored, taIndex> &field, const taCallable &callback)
+    {
+        Q_ASSERT(&field == &std::get<taIndex>(asTuple()));
+        callback(field.m_value);
+        modifiedFlags |= modifiedBit(taIndex);
+    }
+
+    /// @returns true if @p field was changed after it was read or written.
+    template <typename taStored, std::size_t taIndex>
+    [[nodiscard]]
+    bool isModified(const TaskField<taStored, taIndex> & /*field*/) const
+    {
+        return (modifiedFlags & modifiedBit(taIndex)) != 0;
+    }
+
+    /// @brief Clears "modified" flag of @p field, so it is considered "not
+    /// set".
+    template <typename taStored, std::size_t taIndex>
+    void setNotModified(const TaskField<taStored, taIndex> & /*field*/)
+    {
+        modifiedFlags &= static_cast<std::uint16_t>(~modifiedBit(taIndex));
+    }
+
+    /// @returns static table of the properties in TASK_PROPERTIES_LIST order.
+    [[nodiscard]]
+    static const std::array<TaskFieldInfo, kTaskPropertiesCount> &fields();
 
     /// @brief Copies different fields from @p other object. If field was equal,
     /// keeps "modified" state as it was before.
     void updateFrom(const DetailedTaskInfo &other);
 
+    /// @returns true if @p other has the same ID, UUID and values of all
+    /// properties, i.e. it would be displayed the same way.
+    [[nodiscard]]
+    bool hasSameData(const DetailedTaskInfo &other) const;
+
     /// @brief tries to add this object as new task to taskwarrior.
     /// @returns true if task was added
     /// @note Does not require task_id field initially set and field is not
@@ -73,10 +188,18 @@ class DetailedTaskInfo {
     bool execModifyExisting(const TaskWarriorExecutor &executor);
 
     /// @brief Tries to read all data from task_warrior and fill this object.
-    /// @note task_id field must be set prior the call.
+    /// @note task_uuid or task_id field must be set prior the call.
     /// @returns true if object was properly read.
     bool execReadExisting(const TaskWarriorExecutor &executor);
 
+    /// @returns UUID if it is known or ID otherwise. Commands are queued, so
+    /// UUID must be used, IDs could be renumbered before they run.
+    [[nodiscard]]
+    const QString &stableReference() const
+    {
+        return task_uuid.isEmpty() ? task_id : task_uuid;
+    }
+
     /// @returns true if this object has all possible data read from `task`.
     [[nodiscard]]
     bool isFullRead() const;
@@ -104,10 +227,26 @@ class DetailedTaskInfo {
     };
 
     ReadAs dataState{ ReadAs::ParticularRead };
+    /// @brief "modified" flags of the properties, bit per property in
+    /// TASK_PROPERTIES_LIST order.
+    std::uint16_t modifiedFlags{ 0u };
+
+    static_assert(kTaskPropertiesCount <= 16u,
+                  "Modified flags must fit into modifiedFlags.");
+
+    [[nodiscard]]
+    static constexpr std::uint16_t modifiedBit(std::size_t index)
+    {
+        return static_cast<std::uint16_t>(1u << index);
+    }
 
     [[nodiscard]]
     QStringList getAddModifyCmdArgsFieldsRepresentation() const;
 
+    /// @brief Clears "modified" flag of all properties, e.g. after they were
+    /// written to or read from taskwarrior.
+    void setAllNotModified();
+
     [[nodiscard]]
     auto asTuple()
     {
@@ -134,7 +273,7 @@ QStringList tasksListToIds(const taTasksContainer &tasks,
 }
 
 /// @brief This object allows Start/Stop/Done/Delete task(s) (1 or more at
-/// once).
+/// once). Tasks are referenced by UUIDs (preferred) or IDs.
 class BatchTasksManager {
   public:
     explicit BatchTasksManager(const QList<DetailedTaskInfo> &tasks);
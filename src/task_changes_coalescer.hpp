@@ -0,0 +1,111 @@
+#pragma once
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QList>
+#include <QString>
+#include <qtypes.h>
+
+#include <cstring>
+#include <utility>
+
+/// @brief Single task as it was passed to taskwarrior's hook (the same JSON
+/// as `task export` prints, but without "id" and "urgency").
+struct ChangedTaskJson {
+    QString uuid;
+    QString status;
+    QByteArray json;
+};
+
+/// @brief Collects lines written by hook scripts (one JSON object per line)
+/// and keeps only the latest state of each task. So burst of changes, like
+/// bulk import or `task N-M modify`, is reported as one batch.
+/// @note Input can be fed by any chunks, unfinished line is kept until its
+/// end arrives.
+class TaskChangesCoalescer {
+  public:
+    struct Batch {
+        /// @brief Latest state of each changed task in order of 1st change.
+        QList<ChangedTaskJson> changes;
+        /// @brief false if some line could not be parsed, so @p changes do
+        /// not describe everything which happened.
+        bool complete{ true };
+        /// @brief Count of the hook calls (lines), each is one change stored
+        /// by `task`, while @p changes keep one entry per task.
+        qsizetype calls{ 0 };
+    };
+
+    /// @brief Consumes next @p chunk of the written lines.
+    void feed(QByteArrayView chunk)
+    {
+        while (!chunk.isEmpty()) {
+            const auto *eol = static_cast<const char *>(
+                std::memchr(chunk.data(), '\n', chunk.size()));
+            if (eol == nullptr) {
+                m_partial_line.append(chunk);
+                return;
+            }
+            const auto lineSize = eol - chunk.data();
+            if (m_partial_line.isEmpty()) {
+                addLine(chunk.first(lineSize));
+            } else {
+                m_partial_line.append(chunk.first(lineSize));
+                addLine(m_partial_line);
+                m_partial_line.truncate(0);
+            }
+            chunk = chunk.sliced(lineSize + 1);
+        }
+    }
+
+    /// @returns count of the distinct tasks collected so far.
+    [[nodiscard]]
+    qsizetype size() const
+    {
+        return m_batch.changes.size();
+    }
+
+    /// @returns collected changes and starts new batch. Unfinished line is
+    /// kept.
+    [[nodiscard]]
+    Batch take()
+    {
+        m_index_by_uuid.clear();
+        return std::exchange(m_batch, {});
+    }
+
+  private:
+    void addLine(QByteArrayView line)
+    {
+        if (line.endsWith('\r')) {
+            line.chop(1);
+        }
+        if (line.isEmpty()) {
+            return;
+        }
+        ++m_batch.calls;
+        QJsonParseError error{};
+        const auto doc = QJsonDocument::fromJson(line.toByteArray(), &error);
+        const auto uuid = doc.object().value("uuid").toString();
+        if (error.error != QJsonParseError::NoError || uuid.isEmpty()) {
+            m_batch.complete = false;
+            return;
+        }
+        ChangedTaskJson change{ uuid, doc.object().value("status").toString(),
+                                line.toByteArray() };
+        const auto it = m_index_by_uuid.constFind(uuid);
+        if (it != m_index_by_uuid.cend()) {
+            m_batch.changes[*it] = std::move(change);
+            return;
+        }
+        m_index_by_uuid.insert(uuid, m_batch.changes.size());
+        m_batch.changes << std::move(change);
+    }
+
+    QByteArray m_partial_line;
+    Batch m_batch;
+    QHash<QString, qsizetype> m_index_by_uuid;
+};
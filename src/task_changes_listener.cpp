@@ -0,0 +1,313 @@
+#include "task_changes_listener.hpp"
+
+#include "configmanager.hpp"
+#include "direct_storage_reader.hpp"
+#include "task_changes_coalescer.hpp"
+#include "taskwarriorexecutor.hpp"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileDevice>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QStandardPaths>
+#include <QString>
+#include <QTemporaryDir>
+#include <QtConcurrent> //NOLINT
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace
+{
+using namespace std::chrono_literals;
+
+/// @brief Each hook call is separated process, bulk operations call hooks
+/// one by one, so changes are collected for a while.
+constexpr auto kSettleTime = 50ms;
+
+/// @brief Spool is restarted when QTask read it and it became that big.
+constexpr qint64 kMaxSpoolSize = 1024 * 1024;
+
+/// @brief Scripts with this line are ours and can be removed.
+constexpr auto kHookMarker = "# Installed by QTask";
+
+/// @returns spool path in the directory only user can access. Runtime
+/// location is such one, otherwise @p fallback is made in temp directory.
+/// Shared temp is not used directly: others could create or link spool there
+/// and read changed tasks.
+QString spoolFilePath(std::unique_ptr<QTemporaryDir> &fallback)
+{
+    QString dir =
+        QStandardPaths::writableLocation(QStandardPaths::RuntimeLocation);
+    if (dir.isEmpty()) {
+        // It is created with 0700 permissions.
+        fallback = std::make_unique<QTemporaryDir>();
+        if (!fallback->isValid()) {
+            return {};
+        }
+        dir = fallback->path();
+    }
+    return QDir(dir).absoluteFilePath("qtask-task-changes.jsonl");
+}
+
+/// @returns directory where `task` looks for hooks (rc.hooks.location, which
+/// is "hooks" inside data location by default).
+std::optional<QString> readHooksLocation(const TaskWarriorExecutor &executor)
+{
+    const auto res =
+        executor.execTaskProgramWithDefaults({ "_get", "rc.hooks.location" });
+    if (res && !res.getStdout().isEmpty()) {
+        QString location = res.getStdout().first().trimmed();
+        if (location.startsWith('~')) {
+            location.replace(0, 1, QDir::homePath());
+        }
+        if (!location.isEmpty()) {
+            return location;
+        }
+    }
+    const auto data = DirectStorageReader::readDataLocation(executor);
+    if (!data) {
+        return std::nullopt;
+    }
+    return QDir(*data).absoluteFilePath("hooks");
+}
+
+bool isOurHook(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return file.read(512).contains(kHookMarker);
+}
+
+/// @brief Removes our hooks from @p hooks_dir, user's files are kept.
+void removeOurHooks(const QString &hooks_dir)
+{
+    const QDir dir(hooks_dir);
+    for (const auto *name : { TaskChangesListener::kOnAddHookName,
+                              TaskChangesListener::kOnModifyHookName }) {
+        const auto path = dir.absoluteFilePath(name);
+        if (isOurHook(path)) {
+            QFile::remove(path);
+        }
+    }
+}
+
+QByteArray shellQuoted(const QString &text)
+{
+    QByteArray quoted = text.toLocal8Bit();
+    quoted.replace('\'', "'\\''");
+    return '\'' + quoted + '\'';
+}
+} // namespace
+
+TaskChangesListener::TaskChangesListener(QObject *parent)
+    : QObject(parent)
+    , m_spool_path(spoolFilePath(m_spool_dir))
+{
+    m_settle_timer.setSingleShot(true);
+    m_settle_timer.setInterval(kSettleTime);
+    connect(&m_settle_timer, &QTimer::timeout, this,
+            &TaskChangesListener::readSpool);
+    connect(&m_watcher, &QFileSystemWatcher::fileChanged, this,
+            &TaskChangesListener::onSpoolChanged);
+    connect(&ConfigManager::config().notifier(), &ConfigEvents::settingsChanged,
+            this, &TaskChangesListener::applyConfig);
+    applyConfig();
+}
+
+TaskChangesListener::~TaskChangesListener()
+{
+    // Hooks must stop collecting changes while we are not running, and
+    // `task` should not spawn them at all.
+    stopListening();
+    if (!m_hooks_dir.isEmpty()) {
+        removeOurHooks(m_hooks_dir);
+    }
+}
+
+bool TaskChangesListener::isListening() const
+{
+    return m_watcher.files().contains(m_spool_path);
+}
+
+QByteArray TaskChangesListener::makeHookScript(const bool on_modify,
+                                               const QString &spool_path,
+                                               const qint64 pid)
+{
+    QByteArray script = "#!/bin/sh\n";
+    script += kHookMarker;
+    script += ", it forwards changed task to running QTask.\n";
+    script += "spool=" + shellQuoted(spool_path) + "\n";
+    script += "pid=" + QByteArray::number(pid) + "\n";
+    if (on_modify) {
+        // Original task is not needed, the last line is the result.
+        script += "read -r original\n";
+    }
+    // Taskwarrior expects task back, otherwise it is rejected.
+    script += "read -r task\n"
+              "printf '%s\\n' \"$task\"\n"
+              // Spool is left by crashed QTask, its PID says it is gone.
+              "if [ -f \"$spool\" ] && kill -0 \"$pid\" 2>/dev/null; then\n"
+              "    printf '%s\\n' \"$task\" >> \"$spool\" 2>/dev/null\n"
+              "fi\n"
+              "exit 0\n";
+    return script;
+}
+
+void TaskChangesListener::applyConfig()
+{
+    const bool enabled =
+        ConfigManager::config().get(ConfigManager::ForwardTaskChanges);
+    if (enabled == m_enabled) {
+        return;
+    }
+    m_enabled = enabled;
+    if (m_enabled) {
+        startListening();
+    } else {
+        stopListening();
+    }
+
+    using TLocation = std::optional<QString>;
+    auto *locationReader = new QFutureWatcher<TLocation>(this);
+    connect(locationReader, &QFutureWatcher<TLocation>::finished, this,
+            [this, locationReader, enabled]() {
+                // This is GUI thread.
+                locationReader->deleteLater();
+                const auto location = locationReader->result();
+                if (!location) {
+                    return;
+                }
+                if (enabled) {
+                    installHooks(*location);
+                    return;
+                }
+                removeOurHooks(*location);
+                m_hooks_dir.clear();
+            });
+    locationReader->setFuture(QtConcurrent::run(
+        [](QString pathToBinary) -> TLocation {
+            try {
+                // This is non-GUI thread.
+                return readHooksLocation(TaskWarriorExecutor(
+                    std::move(pathToBinary),
+                    TaskWarriorExecutor::TSkipBinaryValidation{}));
+            } catch (...) { // NOLINT
+            }
+            return std::nullopt;
+        },
+        ConfigManager::config().get(ConfigManager::TaskBin)));
+}
+
+void TaskChangesListener::installHooks(const QString &hooks_dir)
+{
+    if (!QDir().mkpath(hooks_dir)) {
+        qWarning() << "Cannot create hooks directory" << hooks_dir;
+        return;
+    }
+    const QDir dir(hooks_dir);
+    for (const bool on_modify : { false, true }) {
+        const auto path =
+            dir.absoluteFilePath(on_modify ? kOnModifyHookName : kOnAddHookName);
+        // User's own file with the same name is never overwritten.
+        if (QFile::exists(path) && !isOurHook(path)) {
+            qWarning() << "Hook" << path << "exists and it is not ours.";
+            continue;
+        }
+        const auto script = makeHookScript(on_modify, m_spool_path,
+                                           QCoreApplication::applicationPid());
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+            file.write(script) < 0) {
+            qWarning() << "Cannot write hook" << path;
+            continue;
+        }
+        file.setPermissions(QFileDevice::ReadOwner | QFileDevice::WriteOwner |
+                            QFileDevice::ExeOwner | QFileDevice::ReadGroup |
+                            QFileDevice::ExeGroup);
+        m_hooks_dir = hooks_dir;
+    }
+}
+
+void TaskChangesListener::startListening()
+{
+    if (m_spool_path.isEmpty()) {
+        qWarning() << "Cannot create private directory for spool.";
+        return;
+    }
+    // Spool left by crashed QTask is replaced. New one is created
+    // exclusively, so it is never someone's file or link.
+    QFile::remove(m_spool_path);
+    QFile spool(m_spool_path);
+    if (!spool.open(QIODevice::WriteOnly | QIODevice::NewOnly) ||
+        !spool.setPermissions(QFileDevice::ReadOwner |
+                              QFileDevice::WriteOwner)) {
+        qWarning() << "Cannot create spool" << m_spool_path;
+        return;
+    }
+    spool.close();
+    m_spool_offset = 0;
+    (void)m_coalescer.take();
+    m_watcher.addPath(m_spool_path);
+}
+
+void TaskChangesListener::stopListening()
+{
+    m_settle_timer.stop();
+    if (isListening()) {
+        m_watcher.removePath(m_spool_path);
+    }
+    QFile::remove(m_spool_path);
+}
+
+void TaskChangesListener::onSpoolChanged()
+{
+    // Timer is not restarted, so endless stream of changes is still
+    // reported regularly.
+    if (!m_settle_timer.isActive()) {
+        m_settle_timer.start();
+    }
+}
+
+void TaskChangesListener::readSpool()
+{
+    QFile spool(m_spool_path);
+    if (!spool.open(QIODevice::ReadWrite)) {
+        return;
+    }
+    if (spool.size() < m_spool_offset) {
+        // Someone truncated it.
+        m_spool_offset = 0;
+    }
+    if (!spool.seek(m_spool_offset)) {
+        return;
+    }
+    const QByteArray appended = spool.readAll();
+    m_spool_offset += appended.size();
+    m_coalescer.feed(appended);
+
+    // Hook could append something right now, so we lose it. It is fine,
+    // because such change is still reported as changed data on disk.
+    if (m_spool_offset > kMaxSpoolSize) {
+        spool.resize(0);
+        m_spool_offset = 0;
+    }
+    if (m_coalescer.size() == 0) {
+        return;
+    }
+    auto batch = m_coalescer.take();
+    if (batch.changes.size() > kMaxReportedChanges) {
+        // Changed data on disk is reported anyway, it re-reads whole list.
+        return;
+    }
+    emit tasksWereChanged(batch);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "task_changes_coalescer.hpp"
+
+#include <QByteArray>
+#include <QFileSystemWatcher>
+#include <QObject>
+#include <QString>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+#include <memory>
+
+/// @brief Receives tasks changed by any `task` command through on-add and
+/// on-modify hooks installed by QTask (see ConfigManager::ForwardTaskChanges).
+/// @note Hooks append each changed task to the spool file, but only if it
+/// exists and QTask process is alive. Spool and hooks exist only while
+/// listener is alive, so `task` does not collect anything while QTask is not
+/// running. Hooks never wait for QTask.
+class TaskChangesListener : public QObject {
+    Q_OBJECT
+  public:
+    /// @brief Batches bigger than this are not reported, it is cheaper to
+    /// re-read whole list.
+    static constexpr qsizetype kMaxReportedChanges = 50;
+
+    static constexpr auto kOnAddHookName = "on-add.qtask";
+    static constexpr auto kOnModifyHookName = "on-modify.qtask";
+
+    explicit TaskChangesListener(QObject *parent = nullptr);
+    ~TaskChangesListener() override;
+    TaskChangesListener(const TaskChangesListener &) = delete;
+    TaskChangesListener &operator=(const TaskChangesListener &) = delete;
+    TaskChangesListener(TaskChangesListener &&) = delete;
+    TaskChangesListener &operator=(TaskChangesListener &&) = delete;
+
+    /// @returns true if hooks are installed and spool is watched.
+    [[nodiscard]]
+    bool isListening() const;
+
+    /// @returns text of the hook script which forwards tasks to @p spool_path
+    /// while process @p pid is alive.
+    /// @param on_modify - on-modify hook receives 2 lines (original and
+    /// modified task), on-add receives 1.
+    [[nodiscard]]
+    static QByteArray makeHookScript(bool on_modify, const QString &spool_path,
+                                     qint64 pid);
+
+  signals:
+    /// @brief Tasks were changed by `task`, data on disk may be not written
+    /// yet.
+    void tasksWereChanged(const TaskChangesCoalescer::Batch &batch);
+
+  private:
+    /// @brief Installs or removes hooks according to config.
+    void applyConfig();
+    void installHooks(const QString &hooks_dir);
+    void startListening();
+    void stopListening();
+    void onSpoolChanged();
+    void readSpool();
+
+    /// @brief Private directory for the spool, if there is no runtime one.
+    std::unique_ptr<QTemporaryDir> m_spool_dir;
+    /// @brief It is empty if private directory could not be made.
+    QString m_spool_path;
+    /// @brief Where our hooks were installed, they are removed on exit.
+    QString m_hooks_dir;
+    qint64 m_spool_offset{ 0 };
+    bool m_enabled{ false };
+    QFileSystemWatcher m_watcher;
+    QTimer m_settle_timer;
+    TaskChangesCoalescer m_coalescer;
+};
@@ -1,15 +1,23 @@
 #pragma once
 
+#include <QDate>
 #include <QDateTime>
 #include <QString>
+#include <QStringView>
+#include <QTime>
+#include <QTimeZone>
+#include <QtGlobal>
 
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
+#include <limits>
+#include <memory>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <utility>
 
 #include "qtutil.hpp"
 
@@ -23,17 +31,153 @@ enum class DatesRelation : std::uint8_t {
     Future,      // Date is "normal", there is no special warnings.
 };
 
+/// @brief Helpers to read fixed width dates which taskwarrior prints, those
+/// are much cheaper than QDateTime::fromString().
+namespace FixedWidthDate
+{
+/// @returns value of @p length decimal digits of @p text at @p from or
+/// std::nullopt if some character is not a digit or out of @p text.
+[[nodiscard]]
+inline std::optional<int> digits(QStringView text, qsizetype from,
+                                 qsizetype length) noexcept
+{
+    if (from < 0 || from + length > text.size()) {
+        return std::nullopt;
+    }
+    int res = 0;
+    for (qsizetype i = from; i < from + length; ++i) {
+        const auto c = text.at(i).unicode();
+        if (c < u'0' || c > u'9') {
+            return std::nullopt;
+        }
+        res = res * 10 + (c - u'0');
+    }
+    return res;
+}
+
+/// @returns days since 1970-01-01 of the Gregorian date or std::nullopt if
+/// there is no such date.
+[[nodiscard]]
+constexpr std::optional<qint64> daysFromCivil(int year, int month,
+                                              int day) noexcept
+{
+    constexpr int kDaysInMonth[] = { 31, 28, 31, 30, 31, 30,
+                                     31, 31, 30, 31, 30, 31 };
+    if (month < 1 || month > 12 || day < 1) {
+        return std::nullopt;
+    }
+    const bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    if (day > kDaysInMonth[month - 1] + (month == 2 && leap ? 1 : 0)) {
+        return std::nullopt;
+    }
+    // Days of the 400 years eras counted from March, so leap day is the last.
+    const qint64 y = year - (month <= 2 ? 1 : 0);
+    const qint64 era = (y >= 0 ? y : y - 399) / 400;
+    const qint64 yearOfEra = y - era * 400;
+    const qint64 dayOfYear =
+        (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const qint64 dayOfEra =
+        yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+/// @returns milliseconds of the time of day or std::nullopt if it is invalid.
+[[nodiscard]]
+constexpr std::optional<qint64> msecsOfDay(int hour, int minute,
+                                           int second) noexcept
+{
+    if (hour > 23 || minute > 59 || second > 59) {
+        return std::nullopt;
+    }
+    return ((hour * 60LL + minute) * 60LL + second) * 1000LL;
+}
+
+/// @brief Parses date-time in the format used by `task export`
+/// (20251104T000000Z), which is always UTC, so no time zone lookup is needed.
+/// @returns milliseconds since epoch or std::nullopt for other formats.
+[[nodiscard]]
+inline std::optional<qint64> parseExportMSecs(QStringView value) noexcept
+{
+    // yyyyMMddTHHmmssZ
+    static constexpr qsizetype kExpectedLength = 16;
+    if (value.size() != kExpectedLength || value.at(8) != u'T' ||
+        value.at(15) != u'Z') {
+        return std::nullopt;
+    }
+    const auto year = digits(value, 0, 4);
+    const auto month = digits(value, 4, 2);
+    const auto day = digits(value, 6, 2);
+    const auto hour = digits(value, 9, 2);
+    const auto minute = digits(value, 11, 2);
+    const auto second = digits(value, 13, 2);
+    if (!year || !month || !day || !hour || !minute || !second) {
+        return std::nullopt;
+    }
+    const auto days = daysFromCivil(*year, *month, *day);
+    const auto msecs = msecsOfDay(*hour, *minute, *second);
+    if (!days || !msecs) {
+        return std::nullopt;
+    }
+    static constexpr qint64 kMSecsPerDay = 24LL * 60 * 60 * 1000;
+    return *days * kMSecsPerDay + *msecs;
+}
+
+/// @returns @p msecs since epoch as `task export` prints it and `task import`
+/// reads it (20251104T000000Z).
+[[nodiscard]]
+inline QString formatExportMSecs(qint64 msecs)
+{
+    return QDateTime::fromMSecsSinceEpoch(msecs, QTimeZone::utc())
+        .toString("yyyyMMdd'T'HHmmss'Z'");
+}
+
+/// @brief Parses local @p date and @p time as printed with forced
+/// `rc.dateformat=Y-M-DTH:N:S` (2025-11-04 and 00:00:00).
+/// @returns local date-time or invalid QDateTime for other formats.
+[[nodiscard]]
+inline QDateTime parseLocalDateTime(QStringView date, QStringView time)
+{
+    if (date.size() != 10 || date.at(4) != u'-' || date.at(7) != u'-' ||
+        time.size() != 8 || time.at(2) != u':' || time.at(5) != u':') {
+        return {};
+    }
+    const auto year = digits(date, 0, 4);
+    const auto month = digits(date, 5, 2);
+    const auto day = digits(date, 8, 2);
+    const auto hour = digits(time, 0, 2);
+    const auto minute = digits(time, 3, 2);
+    const auto second = digits(time, 6, 2);
+    if (!year || !month || !day || !hour || !minute || !second ||
+        !daysFromCivil(*year, *month, *day) ||
+        !msecsOfDay(*hour, *minute, *second)) {
+        return {};
+    }
+    return { QDate(*year, *month, *day), QTime(*hour, *minute, *second) };
+}
+} // namespace FixedWidthDate
+
 /// @brief This template represents optional date time with assigned task's
-/// role.
+/// role. It keeps milliseconds since epoch, QDateTime is made only when it is
+/// requested, e.g. for display.
 template <ETaskDateTimeRole taRole>
 class TaskDateTime {
   public:
-    TaskDateTime()
-        : m_value(std::nullopt)
-    {
-    }
+    /// @brief Gives access to members of QDateTime made on the fly.
+    class ArrowProxy {
+      public:
+        explicit ArrowProxy(QDateTime value)
+            : m_value(std::move(value))
+        {
+        }
+        const QDateTime *operator->() const { return std::addressof(m_value); }
+
+      private:
+        QDateTime m_value;
+    };
+
+    TaskDateTime() = default;
     explicit TaskDateTime(const QDateTime &dateTime)
-        : m_value(dateTime)
+        : m_msecs(toMSecs(dateTime))
     {
     }
     TaskDateTime(const TaskDateTime &other) = default;
@@ -45,13 +189,7 @@ class TaskDateTime {
     [[nodiscard]]
     bool operator==(const TaskDateTime &other) const noexcept
     {
-        if (!has_value() && !other.has_value()) {
-            return true;
-        }
-        if (has_value() != other.has_value()) {
-            return false;
-        }
-        return value() == other.value();
+        return m_msecs == other.m_msecs;
     }
 
     [[nodiscard]]
@@ -62,85 +200,90 @@ class TaskDateTime {
 
     TaskDateTime &operator=(const QDateTime &dt) noexcept
     {
-        m_value = dt;
+        m_msecs = toMSecs(dt);
         return *this;
     }
 
-    /// @returns true if date-time was set.
-    [[nodiscard]]
-    bool has_value() const noexcept
-    {
-        return m_value.has_value();
-    }
-
-    /// @returns ref to date-time value or
-    /// @throws if optional was not set to date-time value.
+    /// @returns date-time set to @p msecs since epoch.
     [[nodiscard]]
-    QDateTime &operator*()
+    static TaskDateTime fromMSecsSinceEpoch(qint64 msecs) noexcept
     {
-        return value();
+        TaskDateTime res;
+        res.m_msecs = msecs;
+        return res;
     }
 
-    /// @returns const-ref to date-time value or
-    /// @throws if optional was not set to date-time value.
+    /// @returns true if date-time was set.
     [[nodiscard]]
-    const QDateTime &operator*() const
+    bool has_value() const noexcept
     {
-        return value();
+        return m_msecs != kUnset;
     }
 
-    /// @returns ref to date-time value or
+    /// @returns milliseconds since epoch or
     /// @throws if optional was not set to date-time value.
     [[nodiscard]]
-    QDateTime &value()
+    qint64 toMSecsSinceEpoch() const
     {
-        return deref(*this);
+        throwIfUnset();
+        return m_msecs;
     }
 
-    /// @returns const-ref to date-time value or
+    /// @returns local date-time value or
     /// @throws if optional was not set to date-time value.
     [[nodiscard]]
-    const QDateTime &value() const
+    QDateTime operator*() const
     {
-        return deref(*this);
+        return value();
     }
 
-    /// @returns pointer to date-time value or
+    /// @returns local date-time value or
     /// @throws if optional was not set to date-time value.
     [[nodiscard]]
-    QDateTime *operator->()
+    QDateTime value() const
     {
-        return ptr(*this);
+        return QDateTime::fromMSecsSinceEpoch(toMSecsSinceEpoch());
     }
 
-    /// @returns pointer to const date-time value or
+    /// @returns accessor to date-time value or
     /// @throws if optional was not set to date-time value.
     [[nodiscard]]
-    const QDateTime *operator->() const
+    ArrowProxy operator->() const
     {
-        return ptr(*this);
+        return ArrowProxy(value());
     }
 
-    /// @returns relation to given time moment @p now which can be used to
-    /// display warnings.
+    /// @returns relation to given time moment @p now (milliseconds since
+    /// epoch) which can be used to display warnings.
+    /// @note Take now once for all dates checked together, it is cheap then.
     [[nodiscard]]
-    DatesRelation
-    relationToNow(const QDateTime &now = QDateTime::currentDateTime()) const
+    DatesRelation relationToNow(qint64 now) const noexcept
     {
         if (!has_value()) {
             return DatesRelation::Future;
         }
         constexpr std::chrono::milliseconds approachingMs = warning_interval();
-        const auto diffMs = std::chrono::milliseconds(now.msecsTo(value()));
-        if (value() < now) {
+        if (m_msecs < now) {
             return DatesRelation::Past;
         }
-        if (diffMs <= approachingMs) {
+        if (m_msecs - now <= approachingMs.count()) {
             return DatesRelation::Approaching;
         }
         return DatesRelation::Future;
     }
 
+    [[nodiscard]]
+    DatesRelation relationToNow(const QDateTime &now) const noexcept
+    {
+        return relationToNow(now.toMSecsSinceEpoch());
+    }
+
+    [[nodiscard]]
+    DatesRelation relationToNow() const noexcept
+    {
+        return relationToNow(QDateTime::currentMSecsSinceEpoch());
+    }
+
     /// @returns current template parameter as string for logging purposes.
     static constexpr std::string_view role_name()
     {
@@ -193,23 +336,20 @@ class TaskDateTime {
     }
 
   private:
-    using OptionalDateTime = std::optional<QDateTime>;
-    OptionalDateTime m_value;
+    static constexpr qint64 kUnset = std::numeric_limits<qint64>::min();
+    qint64 m_msecs{ kUnset };
 
-    template <typename taSelf>
-    static decltype(auto) deref(taSelf &self)
+    static qint64 toMSecs(const QDateTime &dateTime) noexcept
     {
-        if (!self.has_value()) {
-            throw std::logic_error(std::string("TaskDateTime<") +
-                                   std::string(role_name()) + "> is not set");
-        }
-        return *self.m_value;
+        return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : kUnset;
     }
 
-    template <typename Self>
-    static auto ptr(Self &self)
+    void throwIfUnset() const
     {
-        return std::addressof(deref(self));
+        if (!has_value()) {
+            throw std::logic_error(std::string("TaskDateTime<") +
+                                   std::string(role_name()) + "> is not set");
+        }
     }
 
   public:
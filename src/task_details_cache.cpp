@@ -0,0 +1,54 @@
+#include "task_details_cache.hpp"
+#include "filteredtaskslistreader.hpp"
+#include "json_export_reader.hpp"
+#include "recurrence_instance_data.hpp"
+#include "task.hpp"
+#include "taskwarriorexecutor.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QList>
+#include <QStringList>
+
+#include <optional>
+#include <utility>
+
+std::optional<QList<DetailedTaskInfo>>
+TaskDetailsCache::exportDetails(const TaskWarriorExecutor &executor,
+                                const QStringList &uuids)
+{
+    QList<DetailedTaskInfo> res;
+    if (uuids.isEmpty()) {
+        return res;
+    }
+    res.reserve(uuids.size());
+
+    bool parsed = true;
+    JsonObjectsSplitter splitter;
+    const auto exec_res = executor.execTaskProgramStreaming(
+        QStringList(uuids) << "export",
+        [&splitter, &res, &parsed](const QByteArray &chunk) {
+            splitter.feed(chunk, [&res, &parsed](QByteArrayView object) {
+                auto task = FilteredTasksListReader::parseTask(object);
+                if (!task) {
+                    parsed = false;
+                    return;
+                }
+                // Export has "recur" of recurrent tasks only, so missing one
+                // means task is not recurrent.
+                if (!task->recurrency_period.get().isFullyRead()) {
+                    task->modify(task->recurrency_period,
+                                 [](RecurrentInstancePeriod &period) {
+                                     period.setNonRecurrent();
+                                 });
+                    task->setNotModified(task->recurrency_period);
+                }
+                task->markFullRead();
+                res << std::move(*task);
+            });
+        });
+    if (!exec_res || !parsed || !splitter.isIdle()) {
+        return std::nullopt;
+    }
+    return res;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "task.hpp"
+#include "taskwarriorexecutor.hpp"
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+#include <optional>
+
+/// @brief Full details of the tasks by UUID, so tooltips and editor do not
+/// need to call `task information` per task. It is filled by batches, each one
+/// is single `task export` of many UUIDs.
+/// @note Cache must be invalidated on any change of the data, there is no
+/// other way to know which task was changed.
+class TaskDetailsCache {
+  public:
+    using Generation = std::uint64_t;
+
+    /// @brief The most of UUIDs exported by single batch.
+    static constexpr qsizetype kMaxBatchSize = 200;
+
+    /// @returns cached task or nullptr.
+    [[nodiscard]]
+    const DetailedTaskInfo *find(const QString &uuid) const
+    {
+        const auto it = m_tasks.constFind(uuid);
+        return it == m_tasks.cend() ? nullptr : &it.value();
+    }
+
+    /// @returns UUIDs from @p wanted which are neither cached nor loading yet,
+    /// at most kMaxBatchSize of them. Those are considered loading until
+    /// store() or invalidate() is called.
+    [[nodiscard]]
+    QStringList takeMissing(const QStringList &wanted)
+    {
+        QStringList res;
+        for (const auto &uuid : wanted) {
+            if (res.size() >= kMaxBatchSize) {
+                break;
+            }
+            if (uuid.isEmpty() || m_tasks.contains(uuid) ||
+                m_loading.contains(uuid)) {
+                continue;
+            }
+            m_loading.insert(uuid);
+            res << uuid;
+        }
+        return res;
+    }
+
+    /// @returns generation which must be passed to store() with loaded
+    /// batch.
+    [[nodiscard]]
+    Generation generation() const
+    {
+        return m_generation;
+    }
+
+    /// @brief Keeps @p loaded tasks of @p requested batch, unless cache was
+    /// invalidated after batch was started.
+    void store(Generation generation, const QStringList &requested,
+               const std::optional<QList<DetailedTaskInfo>> &loaded)
+    {
+        if (generation != m_generation) {
+            return;
+        }
+        for (const auto &uuid : requested) {
+            m_loading.remove(uuid);
+        }
+        if (!loaded) {
+            return;
+        }
+        for (const auto &task : *loaded) {
+            if (task.isFullRead()) {
+                m_tasks.insert(task.task_uuid, task);
+            }
+        }
+    }
+
+    /// @brief Drops all cached tasks and results of the started batches.
+    void invalidate()
+    {
+        ++m_generation;
+        m_tasks.clear();
+        m_loading.clear();
+    }
+
+    /// @brief Exports all data of the tasks with @p uuids.
+    /// @returns tasks marked as fully read or std::nullopt on errors.
+    [[nodiscard]]
+    static std::optional<QList<DetailedTaskInfo>>
+    exportDetails(const TaskWarriorExecutor &executor,
+                  const QStringList &uuids);
+
+  private:
+    QHash<QString, DetailedTaskInfo> m_tasks;
+    QSet<QString> m_loading;
+    Generation m_generation{ 0 };
+};
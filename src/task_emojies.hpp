@@ -30,10 +30,11 @@ class StatusEmoji {
         Overdue           // 🔥
     };
 
+    /// @param now milliseconds since epoch, take it once for many tasks.
     explicit StatusEmoji(DetailedTaskInfo task,
-                         QDateTime now = QDateTime::currentDateTime())
+                         qint64 now = QDateTime::currentMSecsSinceEpoch())
         : task(std::move(task))
-        , now(std::move(now))
+        , now(now)
     {
     }
 
@@ -150,7 +151,7 @@ class StatusEmoji {
 
   private:
     DetailedTaskInfo task;
-    QDateTime now;
+    qint64 now;
 
     /// @brief Computes DatesRelation between @p taskDate and @p now and
     /// converts to emoji if supported, to text string otherwise.
@@ -158,7 +159,7 @@ class StatusEmoji {
     template <ETaskDateTimeRole taRole>
     [[nodiscard]] QString static relationToEmoji(
         const TaskDateTime<taRole> &taskDate,
-        const QDateTime &now = QDateTime::currentDateTime())
+        const qint64 now = QDateTime::currentMSecsSinceEpoch())
     {
         const auto rel = taskDate.relationToNow(now);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QByteArrayView>
 #include <QString>
 #include <QStringList>
 #include <qtypes.h>
@@ -7,6 +8,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
 #include <utility>
@@ -107,6 +109,73 @@ class TableStencil {
         }
     }
 
+    /// @brief Same as forEachColumn() but works on not decoded @p line and
+    /// passes columns as views into it, without allocations.
+    /// @tparam taCallable - Callable which should accept column index, column
+    /// name, QByteArrayView value.
+    /// @returns false if @p line has non-ASCII bytes before the last column,
+    /// so byte offsets do not match to the columns; @p callback is not called
+    /// in that case.
+    /// @throws if parsed borders do no match required headers.
+    template <typename taCallable>
+    bool forEachRawColumn(QByteArrayView line, const taCallable &callback) const
+    {
+        const std::size_t count = columns_borders.size();
+        if (count != static_cast<std::size_t>(columns_headers.size()) ||
+            count == 0) {
+            throw std::runtime_error(
+                "processLabelString() was not called before or failed.");
+        }
+
+        const qsizetype lineLen = line.size();
+        // The last column usually is description, it is the only one allowed
+        // to have Unicode.
+        const qsizetype asciiPrefixLen =
+            std::min(columns_borders.back().starts_at, lineLen);
+        const bool isAsciiPrefix = std::all_of(
+            line.begin(), std::next(line.begin(), asciiPrefixLen),
+            [](char c) { return static_cast<unsigned char>(c) < 0x80; });
+        if (!isAsciiPrefix) {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto &border = columns_borders.at(i);
+            QByteArrayView value;
+            if (border.starts_at < lineLen) {
+                const qsizetype actualLength =
+                    std::min(border.length, lineLen - border.starts_at);
+                value = line.sliced(border.starts_at, actualLength).trimmed();
+            }
+            callback(static_cast<qsizetype>(i),
+                     columns_headers.at(static_cast<qsizetype>(i)), value);
+        }
+        return true;
+    }
+
+    /// @returns trimmed value of the column @p index in not decoded @p line.
+    /// @note Byte offsets match to the columns only if @p line is ASCII
+    /// before that column.
+    /// @throws if parsed borders do no match required headers.
+    [[nodiscard]]
+    QByteArrayView rawColumnAt(QByteArrayView line, std::size_t index) const
+    {
+        if (columns_borders.size() !=
+                static_cast<std::size_t>(columns_headers.size()) ||
+            index >= columns_borders.size()) {
+            throw std::runtime_error(
+                "processLabelString() was not called before or failed.");
+        }
+        const auto &border = columns_borders.at(index);
+        if (border.starts_at >= line.size()) {
+            return {};
+        }
+        return line
+            .sliced(border.starts_at,
+                    std::min(border.length, line.size() - border.starts_at))
+            .trimmed();
+    }
+
   private:
     struct TColumnBorder {
         qsizetype starts_at;
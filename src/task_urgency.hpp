@@ -0,0 +1,125 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <optional>
+
+/// @brief Everything of the single task which affects urgency.
+/// @note Dates are seconds since epoch.
+struct UrgencyInputs {
+    enum class Priority : char { Unset = 0, L = 'L', M = 'M', H = 'H' };
+
+    Priority priority{ Priority::Unset };
+    bool has_project{ false };
+    bool has_next_tag{ false };
+    bool active{ false };
+    bool waiting{ false };
+    bool blocked{ false };
+    bool blocking{ false };
+    int tags_count{ 0 };
+    int annotations_count{ 0 };
+    std::optional<qint64> due;
+    std::optional<qint64> scheduled;
+    std::optional<qint64> entry;
+};
+
+/// @brief Computes urgency of the pending task the same way `task` does it
+/// with default `urgency.*` coefficients. It is used when tasks are read
+/// without `task` binary, so lists keep the same order.
+/// @note User defined coefficients (urgency.user.*, changed defaults in
+/// .taskrc) are not accounted.
+class TaskUrgency {
+  public:
+    static constexpr double kNextCoefficient = 15.0;
+    static constexpr double kDueCoefficient = 12.0;
+    static constexpr double kBlockingCoefficient = 8.0;
+    static constexpr double kPriorityHCoefficient = 6.0;
+    static constexpr double kPriorityMCoefficient = 3.9;
+    static constexpr double kPriorityLCoefficient = 1.8;
+    static constexpr double kScheduledCoefficient = 5.0;
+    static constexpr double kActiveCoefficient = 4.0;
+    static constexpr double kAgeCoefficient = 2.0;
+    static constexpr double kAnnotationsCoefficient = 1.0;
+    static constexpr double kTagsCoefficient = 1.0;
+    static constexpr double kProjectCoefficient = 1.0;
+    static constexpr double kWaitingCoefficient = -3.0;
+    static constexpr double kBlockedCoefficient = -5.0;
+    static constexpr double kAgeMaxDays = 365.0;
+
+    /// @returns urgency of the task described by @p in at @p now (seconds
+    /// since epoch).
+    [[nodiscard]]
+    static double compute(const UrgencyInputs &in, qint64 now)
+    {
+        double urgency = 0.0;
+        urgency += kProjectCoefficient * (in.has_project ? 1.0 : 0.0);
+        urgency += kActiveCoefficient * (in.active ? 1.0 : 0.0);
+        urgency += kWaitingCoefficient * (in.waiting ? 1.0 : 0.0);
+        urgency += kBlockedCoefficient * (in.blocked ? 1.0 : 0.0);
+        urgency += kBlockingCoefficient * (in.blocking ? 1.0 : 0.0);
+        urgency += kNextCoefficient * (in.has_next_tag ? 1.0 : 0.0);
+        urgency += kTagsCoefficient * countFactor(in.tags_count);
+        urgency += kAnnotationsCoefficient * countFactor(in.annotations_count);
+        urgency += kPriorityHCoefficient *
+                   (in.priority == UrgencyInputs::Priority::H ? 1.0 : 0.0);
+        urgency += kPriorityMCoefficient *
+                   (in.priority == UrgencyInputs::Priority::M ? 1.0 : 0.0);
+        urgency += kPriorityLCoefficient *
+                   (in.priority == UrgencyInputs::Priority::L ? 1.0 : 0.0);
+        urgency += kScheduledCoefficient *
+                   (in.scheduled.has_value() && *in.scheduled < now ? 1.0
+                                                                    : 0.0);
+        urgency += kDueCoefficient * dueFactor(in.due, now);
+        urgency += kAgeCoefficient * ageFactor(in.entry, now);
+        return urgency;
+    }
+
+  private:
+    static constexpr double kSecondsPerDay = 86400.0;
+
+    static double countFactor(int count)
+    {
+        // It is how `task` scales tags/annotations.
+        switch (count) {
+        case 0:
+            return 0.0;
+        case 1:
+            return 0.8; // NOLINT
+        case 2:
+            return 0.9; // NOLINT
+        default:
+            return 1.0;
+        }
+    }
+
+    static double dueFactor(const std::optional<qint64> &due, qint64 now)
+    {
+        // Linear from 0.2 at 14 days before due to 1.0 at 7 days overdue.
+        static constexpr double kDaysBefore = -14.0;
+        static constexpr double kDaysAfter = 7.0;
+        static constexpr double kMinFactor = 0.2;
+        if (!due.has_value()) {
+            return 0.0;
+        }
+        const double daysOverdue =
+            static_cast<double>(now - *due) / kSecondsPerDay;
+        if (daysOverdue >= kDaysAfter) {
+            return 1.0;
+        }
+        if (daysOverdue >= kDaysBefore) {
+            return ((daysOverdue - kDaysBefore) * (1.0 - kMinFactor) /
+                    (kDaysAfter - kDaysBefore)) +
+                   kMinFactor;
+        }
+        return kMinFactor;
+    }
+
+    static double ageFactor(const std::optional<qint64> &entry, qint64 now)
+    {
+        if (!entry.has_value()) {
+            return 0.0;
+        }
+        const double days = static_cast<double>(now - *entry) / kSecondsPerDay;
+        return days > kAgeMaxDays ? 1.0 : days / kAgeMaxDays;
+    }
+};
@@ -0,0 +1,113 @@
+#include "taskchampion_reader.hpp"
+
+#include "direct_storage_reader.hpp"
+
+#include <QByteArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QList>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include <atomic>
+#include <iostream>
+#include <optional>
+#include <utility>
+
+namespace
+{
+/// @returns name of new connection, unique for each read, so reads from
+/// different threads do not share QSqlDatabase.
+QString uniqueConnectionName()
+{
+    static std::atomic<int> counter{ 0 };
+    return QString("qtask_taskchampion_%1").arg(++counter);
+}
+
+/// @brief Builds query of tasks having one of @p statuses along with their
+/// working set ids.
+QString makeSelectQuery(const QStringList &statuses)
+{
+    // Data is JSON object of strings, which TaskChampion writes compact.
+    // LIKE allows SQLite to skip completed/deleted tasks without parsing,
+    // status is checked again after parsing.
+    QStringList conditions;
+    conditions.reserve(statuses.size());
+    for (const auto &status : statuses) {
+        conditions << QString(R"(t.data LIKE '%"status":"%1"%')").arg(status);
+    }
+    return QString("SELECT t.uuid, t.data, w.id FROM tasks AS t "
+                   "LEFT JOIN working_set AS w ON w.uuid = t.uuid "
+                   "WHERE %1")
+        .arg(conditions.join(" OR "));
+}
+
+std::optional<StoredTask> parseRow(const QSqlQuery &query)
+{
+    QJsonParseError error{};
+    const auto doc =
+        QJsonDocument::fromJson(query.value(1).toByteArray(), &error);
+    if (error.error != QJsonParseError::NoError || !doc.isObject()) {
+        return std::nullopt;
+    }
+    const auto json = doc.object();
+
+    StoredTask task;
+    task.uuid = query.value(0).toString();
+    task.id = query.value(2).isNull() ? 0 : query.value(2).toInt();
+    task.attributes.reserve(json.size());
+    for (auto it = json.constBegin(); it != json.constEnd(); ++it) {
+        task.attributes.insert(it.key(), it.value().toString());
+    }
+    return task;
+}
+} // namespace
+
+TaskChampionReader::TaskChampionReader(QString path_to_db)
+    : m_path_to_db(std::move(path_to_db))
+{
+}
+
+std::optional<QList<StoredTask>>
+TaskChampionReader::readTasks(const QStringList &statuses) const
+{
+    const QString connectionName = uniqueConnectionName();
+    std::optional<QList<StoredTask>> res;
+    {
+        auto db = QSqlDatabase::addDatabase("QSQLITE", connectionName);
+        db.setDatabaseName(m_path_to_db);
+        // `task` may write at the same time, it is short.
+        db.setConnectOptions("QSQLITE_OPEN_READONLY;QSQLITE_BUSY_TIMEOUT=1000");
+        if (db.open()) {
+            QSqlQuery query(db);
+            query.setForwardOnly(true);
+            if (query.exec(makeSelectQuery(statuses))) {
+                res.emplace();
+                while (query.next()) {
+                    auto task = parseRow(query);
+                    if (!task) {
+                        res.reset();
+                        break;
+                    }
+                    if (statuses.contains(task->attributes.value("status"))) {
+                        res->append(std::move(*task));
+                    }
+                }
+            } else {
+                std::cerr << "Failed to read " << m_path_to_db.toStdString()
+                          << ": " << query.lastError().text().toStdString()
+                          << std::endl;
+            }
+        } else {
+            std::cerr << "Failed to open " << m_path_to_db.toStdString() << ": "
+                      << db.lastError().text().toStdString() << std::endl;
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return res;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "direct_storage_reader.hpp"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <optional>
+
+/// @brief Reads Taskwarrior 3.x storage (TaskChampion's SQLite database). The
+/// database is opened read-only on each read from the calling thread, so
+/// object can be used from any thread.
+class TaskChampionReader : public DirectStorageReader {
+  public:
+    inline static const QString kFileName = "taskchampion.sqlite3";
+
+    explicit TaskChampionReader(QString path_to_db);
+
+  protected:
+    [[nodiscard]]
+    std::optional<QList<StoredTask>>
+    readTasks(const QStringList &statuses) const override;
+
+  private:
+    QString m_path_to_db;
+};
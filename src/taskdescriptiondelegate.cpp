@@ -1,55 +1,81 @@
 #include "taskdescriptiondelegate.hpp"
 
-#include <QAbstractTextDocumentLayout>
 #include <QApplication>
+#include <QColor>
 #include <QLinearGradient>
 #include <QObject>
+#include <QPalette>
+#include <QPointF>
 #include <QSize>
 #include <QString>
 #include <QStyleOptionViewItem>
 #include <QStyledItemDelegate>
+#include <QTextCharFormat>
+#include <QTextCursor>
 #include <QTextDocument>
-#include <QtAssert>
-#include <QtMinMax>
 
-#include "qtutil.hpp"
+#include "description_trigram_index.hpp"
 #include "taskhintproviderdelegate.hpp"
 #include "tasksmodel.hpp"
 
 namespace
 {
-/// @returns true if elide is needed.
-bool initDocument(QTextDocument &document, const QStyleOptionViewItem &option,
-                  const QString &whole_text)
+constexpr int kMatchAlpha = 96;
+/// @brief Text is painted after the selection marker.
+constexpr double kFixedOffset = 20.0;
+constexpr int kTextPadding = 2;
+constexpr double kTextOffset = kFixedOffset + kTextPadding;
+
+/// @brief Paints background of the parts of the rendered @p document which
+/// match fuzzy search @p text.
+void highlightMatches(QTextDocument &document, const QString &text,
+                      const QColor &color)
 {
-    setContentOfTextDocument(document, whole_text);
-    document.setTextWidth(option.rect.width());
-
-    // Note, here we assume 1 line rows. If ever it could be more than 1 line
-    // per 1 row, it should be revised.
-    const QFontMetrics fm(option.font);
-    const bool elide_needed =
-        document.size().height() / qMax<qreal>(1.0, fm.height()) > 1.5f;
-
-    document.setPageSize(option.rect.size());
-
-    return elide_needed;
+    QTextCharFormat format;
+    format.setBackground(color);
+    QTextCursor cursor(&document);
+    // Positions of the plain text are the same as of the document, block
+    // separators take 1 character in both.
+    for (const auto &[start, length] : DescriptionTrigramIndex::matchRanges(
+             document.toPlainText(), text)) {
+        cursor.setPosition(static_cast<int>(start));
+        cursor.setPosition(static_cast<int>(start + length),
+                           QTextCursor::KeepAnchor);
+        cursor.mergeCharFormat(format);
+    }
 }
 } // namespace
 
 TaskDescriptionDelegate::TaskDescriptionDelegate(QObject *parent)
     : TaskHintProviderDelegate(parent)
-    , document(new QTextDocument(this))
 {
 }
 
 QString TaskDescriptionDelegate::anchorAt(const QString &markdown,
+                                          const QStyleOptionViewItem &option,
                                           const QPoint &point) const
 {
-    setContentOfTextDocument(*document, markdown);
-    auto textLayout = document->documentLayout();
-    Q_ASSERT(textLayout != nullptr);
-    return textLayout->anchorAt(point);
+    // Links are tested on the same layout which was painted.
+    const auto &entry =
+        documents.get(markdown, option.rect.size(), option.font);
+    return entry.anchorAt(QPointF(point) - QPointF(kTextOffset, 0.0));
+}
+
+void TaskDescriptionDelegate::setHighlightedText(const QString &text)
+{
+    if (text == highlighted_text) {
+        return;
+    }
+    highlighted_text = text;
+    if (text.isEmpty()) {
+        documents.setDecorator({});
+        return;
+    }
+    auto color = QApplication::palette().color(QPalette::Highlight);
+    color.setAlpha(kMatchAlpha);
+    documents.setDecorator([text, color](QTextDocument &document) {
+        highlightMatches(document, text, color);
+    });
 }
 
 void TaskDescriptionDelegate::paint(QPainter *painter,
@@ -58,13 +84,12 @@ void TaskDescriptionDelegate::paint(QPainter *painter,
 {
     auto *model = qobject_cast<const TasksModel *>(index.model());
     const auto rowColor = model->rowColor(index.row());
-    const double fixedOffset = 20.0;
 
     if (option.state & QStyle::State_Selected) {
         const auto highlight = getHighlightColor(option);
         const double length = option.rect.width();
         const double stopPoint =
-            (length > 0) ? std::min(fixedOffset / length, 0.4) : 0.0;
+            (length > 0) ? std::min(kFixedOffset / length, 0.4) : 0.0;
 
         QLinearGradient gradient(option.rect.topLeft(), option.rect.topRight());
         gradient.setColorAt(0.0, highlight);
@@ -78,26 +103,23 @@ void TaskDescriptionDelegate::paint(QPainter *painter,
 
     const auto value = index.data(Qt::DisplayRole);
     if (value.isValid() && !value.isNull()) {
-        const bool elideNeeded =
-            initDocument(*document, option, value.toString());
-
-        const int textPadding = 2;
-        const auto deltaWidth = fixedOffset + textPadding;
+        const auto &entry =
+            documents.get(value.toString(), option.rect.size(), option.font);
 
-        painter->translate(option.rect.topLeft() + QPoint(deltaWidth, 0));
+        painter->translate(option.rect.topLeft() + QPoint(kTextOffset, 0));
         painter->setPen(option.palette.color(QPalette::Text));
 
         const QString ellipsis = QStringLiteral("…");
         const QFontMetrics fm(option.font);
         const int ellipsisWidth = fm.horizontalAdvance(ellipsis);
-        const int ellipsisSpace = elideNeeded ? ellipsisWidth + 3 : 0;
-        document->drawContents(
-            painter, { 0, 0, option.rect.width() - deltaWidth - ellipsisSpace,
+        const int ellipsisSpace = entry.elide_needed ? ellipsisWidth + 3 : 0;
+        entry.document.drawContents(
+            painter, { 0, 0, option.rect.width() - kTextOffset - ellipsisSpace,
                        option.rect.height() });
         // Need to add ...
-        if (elideNeeded) {
+        if (entry.elide_needed) {
             const QPoint ellipsisPos(
-                option.rect.width() - deltaWidth - ellipsisWidth, fm.ascent());
+                option.rect.width() - kTextOffset - ellipsisWidth, fm.ascent());
             painter->drawText(ellipsisPos, ellipsis);
         }
     }
@@ -110,6 +132,8 @@ QSize TaskDescriptionDelegate::sizeHint(const QStyleOptionViewItem &option,
 {
     QStyleOptionViewItem options = option;
     initStyleOption(&options, index);
-    initDocument(*document, options, options.text);
-    return { document->idealWidth(), options.rect.height() };
+    const auto &entry =
+        documents.get(options.text, options.rect.size(), options.font);
+    return { static_cast<int>(entry.document.idealWidth()),
+             options.rect.height() };
 }
@@ -8,6 +8,7 @@
 #include <QStyledItemDelegate>
 #include <QTextDocument>
 
+#include "rendered_document_cache.hpp"
 #include "taskhintproviderdelegate.hpp"
 
 class TaskDescriptionDelegate : public TaskHintProviderDelegate {
@@ -16,7 +17,15 @@ class TaskDescriptionDelegate : public TaskHintProviderDelegate {
   public:
     explicit TaskDescriptionDelegate(QObject *parent = nullptr);
 
-    QString anchorAt(const QString &markdown, const QPoint &point) const;
+    /// @returns link at @p point of the cell painted by @p option, or empty
+    /// string.
+    QString anchorAt(const QString &markdown,
+                     const QStyleOptionViewItem &option,
+                     const QPoint &point) const;
+
+    /// @brief Sets fuzzy search @p text, parts of descriptions matching it
+    /// are highlighted. Empty one disables highlighting.
+    void setHighlightedText(const QString &text);
 
   protected:
     void paint(QPainter *painter, const QStyleOptionViewItem &option,
@@ -26,7 +35,9 @@ class TaskDescriptionDelegate : public TaskHintProviderDelegate {
                    const QModelIndex &index) const override;
 
   private:
-    QTextDocument *document;
+    /// @brief Painting, size hints and hovering share laid out documents.
+    mutable RenderedDocumentCache documents;
+    QString highlighted_text;
 };
 
 #endif // TASKDESCRIPTIONDELEGATE_HPP
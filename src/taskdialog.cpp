@@ -93,27 +93,29 @@ DetailedTaskInfo TaskDialogBase::getTask()
 {
     {
         DetailedTaskInfo task("");
-        task.description = m_task_description->toPlainText();
-        task.priority = DetailedTaskInfo::priorityFromString(
-            m_task_priority->currentText());
+        task.set(task.description, m_task_description->toPlainText());
+        task.set(task.priority, DetailedTaskInfo::priorityFromString(
+                                    m_task_priority->currentText()));
 
         auto project = m_task_project->text();
         project.replace("pro:", "");
         project.replace("project:", "");
-        task.project = project;
+        task.set(task.project, project);
 
         for (const auto &tag : m_task_tags->getTags()) {
             QString t(tag);
             t.remove(QChar('+'));
             t.remove(QChar('-'));
             if (!t.isEmpty()) {
-                task.tags.value.modify([&t](auto &lst) { lst.push_back(t); });
+                task.modify(task.tags, [&t](auto &lst) { lst.push_back(t); });
             }
         }
 
-        task.sched = m_task_sched->getDateTime<ETaskDateTimeRole::Sched>();
-        task.due = m_task_due->getDateTime<ETaskDateTimeRole::Due>();
-        task.wait = m_task_wait->getDateTime<ETaskDateTimeRole::Wait>();
+        task.set(task.sched,
+                 m_task_sched->getDateTime<ETaskDateTimeRole::Sched>());
+        task.set(task.due, m_task_due->getDateTime<ETaskDateTimeRole::Due>());
+        task.set(task.wait,
+                 m_task_wait->getDateTime<ETaskDateTimeRole::Wait>());
 
         m_source_task.updateFrom(task);
     }
@@ -287,7 +289,7 @@ void EditTaskDialog::requestDeleteTask()
                               tr("Delete task #%1?").arg(m_source_task.task_id),
                               QMessageBox::Yes | QMessageBox::No);
     if (reply == QMessageBox::Yes) {
-        emit deleteTask(m_source_task.task_id);
+        emit deleteTask(m_source_task.task_uuid);
         reject();
     }
 }
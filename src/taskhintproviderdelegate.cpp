@@ -1,5 +1,6 @@
 #include "taskhintproviderdelegate.hpp"
 #include "async_task_loader.hpp"
+#include "configmanager.hpp"
 #include "qtutil.hpp"
 #include "task.hpp"
 #include "task_date_time.hpp"
@@ -7,6 +8,7 @@
 #include "tasksmodel.hpp"
 
 #include <QAbstractItemView>
+#include <QDebug>
 #include <QGuiApplication>
 #include <QHelpEvent>
 #include <QModelIndex>
@@ -233,7 +235,12 @@ QString generateTooltip(const DetailedTaskInfo &task, const QString &footer)
 
 TaskHintProviderDelegate::TaskHintProviderDelegate(QObject *parent)
     : QStyledItemDelegate{ parent }
-    , m_task_loader(AsyncTaskLoader::create(this))
+    , m_task_loader(AsyncTaskLoader::create(
+          []() {
+              return AsyncTaskLoader::makeTaskFetcher(
+                  ConfigManager::config().get(ConfigManager::TaskBin));
+          },
+          this))
 {
     static std::once_flag metaTypeRegistrationFlag;
     std::call_once(metaTypeRegistrationFlag, []() {
@@ -265,6 +272,14 @@ TaskHintProviderDelegate::TaskHintProviderDelegate(QObject *parent)
             });
 }
 
+TaskHintProviderDelegate::~TaskHintProviderDelegate()
+{
+    const auto &counters = m_task_loader->counters();
+    qDebug() << "Task hints: loads started" << counters.started << "cancelled"
+             << counters.cancelled << "requests coalesced"
+             << counters.coalesced;
+}
+
 bool TaskHintProviderDelegate::helpEvent(QHelpEvent *event,
                                          QAbstractItemView *view,
                                          const QStyleOptionViewItem &option,
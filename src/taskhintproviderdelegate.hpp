@@ -33,6 +33,14 @@ class TaskHintProviderDelegate : public QStyledItemDelegate {
     };
 
     explicit TaskHintProviderDelegate(QObject *parent = nullptr);
+    /// @note Logs statistic of the hint loads, it shows how much debounce
+    /// saves.
+    ~TaskHintProviderDelegate() override;
+    TaskHintProviderDelegate(const TaskHintProviderDelegate &) = delete;
+    TaskHintProviderDelegate &
+    operator=(const TaskHintProviderDelegate &) = delete;
+    TaskHintProviderDelegate(TaskHintProviderDelegate &&) = delete;
+    TaskHintProviderDelegate &operator=(TaskHintProviderDelegate &&) = delete;
 
     bool helpEvent(QHelpEvent *event, QAbstractItemView *view,
                    const QStyleOptionViewItem &option,
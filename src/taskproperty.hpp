@@ -1,24 +1,9 @@
 #pragma once
 
-#include <QString>
-#include <QStringList>
-
-#include <cassert>
-#include <functional>
-#include <stdexcept>
-#include <type_traits>
+#include <cstddef>
 #include <utility>
-#include <variant>
-
-#include "lambda_visitors.hpp"
-
-template <typename T, typename = void>
-struct is_arg_compatible : std::false_type {};
 
-template <typename T>
-struct is_arg_compatible<T, std::void_t<decltype(std::declval<QString>().arg(
-                                std::declval<const T &>()))>> : std::true_type {
-};
+class DetailedTaskInfo;
 
 /// @brief Property which tracks modifications of the underlying object.
 template <typename taStoredType>
@@ -71,79 +56,26 @@ class ModTrackingProperty {
     bool m_modified{ false };
 };
 
-/// @brief This is some property of the task.
-/// It binds together actual value and a way to write it to taskwarriror.
-/// Also it tracks if it was changed, so only modified fields could be updated.
-/// It can use provided format string or functional formatter.
-/// @note It is NOT thread safe.
-template <typename taStoredType>
-class TaskProperty {
+/// @brief Property of the task which keeps only value. How it is named and
+/// formatted for `task` is the same for all tasks, so it is described once
+/// per field by TaskFieldInfo instead.
+/// @note Modification flags of all properties are bits of one word in
+/// DetailedTaskInfo, so value is changed through it (DetailedTaskInfo::set()
+/// and DetailedTaskInfo::modify()). @p taIndex is position of the property
+/// in TASK_PROPERTIES_LIST and the bit of its flag.
+template <typename taStoredType, std::size_t taIndex>
+class TaskField {
   public:
-    using FormatterToSingleStr = std::function<QString(const taStoredType &)>;
-    using FormatterToManyStr = std::function<QStringList(const taStoredType &)>;
-
-    using Formatter =
-        std::variant<QString, FormatterToSingleStr, FormatterToManyStr>;
-
-    explicit TaskProperty(Formatter formatter,
-                          taStoredType value = taStoredType())
-        : value(std::move(value))
-        , m_formater{ std::move(formatter) }
-    {
-    }
-
-    template <typename TValue>
-    TaskProperty &operator=(TValue &&value)
-    {
-        this->value.modify([&value](taStoredType &target) {
-            target = std::forward<TValue>(value);
-        });
-        return *this;
-    }
+    static constexpr std::size_t kIndex = taIndex;
 
     [[nodiscard]]
     const taStoredType &get() const
     {
-        return value.get();
-    }
-
-    /// @brief Converts property for command line using formatters provided to
-    /// ctor.
-    /// @returns QStringList usable to direct appending to command line call.
-    [[nodiscard]]
-    QStringList getStringsForCmd() const
-    {
-        const LambdaVisitor visitors = {
-            [this](const QString &format) -> QStringList {
-                if constexpr (is_arg_compatible<taStoredType>::value) {
-                    return QStringList() << format.arg(value.get());
-                } else {
-                    throw std::runtime_error(
-                        "taStoredType is incompatible with QString::arg and "
-                        "cannot be formatted via QString pattern.");
-                }
-            },
-            [this](const FormatterToSingleStr &format) {
-                assert(format);
-                if (!format) {
-                    return QStringList{};
-                }
-                return QStringList() << format(value.get());
-            },
-            [this](const FormatterToManyStr &format) {
-                assert(format);
-                if (!format) {
-                    return QStringList{};
-                }
-                return format(value.get());
-            },
-        };
-        return std::visit(visitors, m_formater);
+        return m_value;
     }
 
-  public:
-    ModTrackingProperty<taStoredType> value;
-
   private:
-    Formatter m_formater;
+    friend class DetailedTaskInfo;
+
+    taStoredType m_value{};
 };
@@ -0,0 +1,318 @@
+#pragma once
+
+#include "task.hpp"
+
+#include <QBitArray>
+#include <QChar>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <QStringView>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+/// @brief Keywords of the user's filter which can be evaluated without `task`.
+/// Supported are `project:` (abbreviated down to `pro:`), `+tag`, `-tag` and
+/// bare words, all of them must match.
+/// @note Bare words are searched in descriptions and annotations. `task`
+/// takes them as regular expressions, so words with metacharacters are not
+/// supported.
+class TasksFilterQuery {
+  public:
+    struct Term {
+        enum class Kind : std::uint8_t { Project, HasTag, NoTag, Word };
+        Kind kind;
+        QString value;
+    };
+
+    /// @param case_sensitivity - as `rc.search.case.sensitive` says, it is
+    /// applied to words and projects.
+    /// @returns std::nullopt if some keyword is not supported, so it must be
+    /// resolved by `task ids`.
+    [[nodiscard]]
+    static std::optional<TasksFilterQuery>
+    parse(const QStringList &keywords,
+          Qt::CaseSensitivity case_sensitivity = Qt::CaseSensitive)
+    {
+        TasksFilterQuery query;
+        query.m_case_sensitivity = case_sensitivity;
+        for (const auto &keyword : keywords) {
+            if (keyword.isEmpty() ||
+                keyword.compare("and", Qt::CaseInsensitive) == 0) {
+                continue;
+            }
+            auto term = parseTerm(keyword);
+            if (!term) {
+                return std::nullopt;
+            }
+            query.m_terms << std::move(*term);
+        }
+        return query;
+    }
+
+    /// @brief Removes fuzzy search keywords, which start by `~`, from
+    /// @p keywords.
+    /// @returns text of the removed keywords joined by space.
+    [[nodiscard]]
+    static QString takeFuzzyText(QStringList &keywords)
+    {
+        QStringList words;
+        QStringList rest;
+        for (const auto &keyword : std::as_const(keywords)) {
+            if (keyword.size() > 1 && keyword.front() == '~') {
+                words << keyword.mid(1);
+            } else {
+                rest << keyword;
+            }
+        }
+        keywords = std::move(rest);
+        return words.join(' ');
+    }
+
+    /// @returns true if query matches all tasks.
+    [[nodiscard]]
+    bool isEmpty() const
+    {
+        return m_terms.isEmpty();
+    }
+
+    [[nodiscard]]
+    const QList<Term> &terms() const
+    {
+        return m_terms;
+    }
+
+    [[nodiscard]]
+    Qt::CaseSensitivity caseSensitivity() const
+    {
+        return m_case_sensitivity;
+    }
+
+  private:
+    [[nodiscard]]
+    static std::optional<Term> parseTerm(const QString &keyword)
+    {
+        // Operators, attributes, regular expressions, IDs and UUIDs.
+        static const QRegularExpression kUnsupported(
+            R"(^(or|xor)$|[\s()<>=!~^$:]|^/|^[0-9,\-]+$|^[0-9a-fA-F]{8})",
+            QRegularExpression::CaseInsensitiveOption);
+        static const QRegularExpression kProject(
+            R"(^pro(j(e(c(t)?)?)?)?:(.+)$)",
+            QRegularExpression::CaseInsensitiveOption);
+        // Upper case tags are virtual ones, like +ACTIVE or +OVERDUE.
+        static const QRegularExpression kVirtualTag(R"(^[+-][A-Z]+$)");
+        // `task` matches words as regular expressions. Dot separates
+        // subprojects, so it is taken literally in projects.
+        static const QRegularExpression kRegexMeta(R"([.*?\[|\\])");
+        static const QRegularExpression kProjectRegexMeta(R"([*?\[|\\])");
+
+        if (const auto match = kProject.match(keyword); match.hasMatch()) {
+            const auto project = match.captured(5);
+            if (project.contains(kUnsupported) ||
+                project.contains(kProjectRegexMeta)) {
+                return std::nullopt;
+            }
+            return Term{ Term::Kind::Project, project };
+        }
+        if (keyword.contains(kVirtualTag) || keyword.contains(kUnsupported) ||
+            keyword.contains(kRegexMeta)) {
+            return std::nullopt;
+        }
+        if (keyword.size() > 1 && keyword.front() == '+') {
+            return Term{ Term::Kind::HasTag, keyword.mid(1) };
+        }
+        if (keyword.size() > 1 && keyword.front() == '-') {
+            return Term{ Term::Kind::NoTag, keyword.mid(1) };
+        }
+        if (keyword.front() == '+' || keyword.front() == '-') {
+            return std::nullopt;
+        }
+        return Term{ Term::Kind::Word, keyword };
+    }
+
+    QList<Term> m_terms;
+    Qt::CaseSensitivity m_case_sensitivity{ Qt::CaseSensitive };
+};
+
+/// @brief Inverted indexes of the tasks list: rows by project, tag and word of
+/// description or annotation. Tags are matched case sensitive, words and
+/// projects as query says.
+class TasksFilterIndex {
+  public:
+    explicit TasksFilterIndex(QList<DetailedTaskInfo> tasks)
+        : m_tasks(std::move(tasks))
+    {
+        for (int row = 0, sz = static_cast<int>(m_tasks.size()); row < sz;
+             ++row) {
+            const auto &task = m_tasks.at(row);
+            const auto &project = task.project.get();
+            if (!project.isEmpty()) {
+                m_projects[project] << row;
+            }
+            for (const auto &tag : task.tags.get()) {
+                addPosting(m_tags[tag], row);
+            }
+            const auto addToken = [this, row](QStringView t) {
+                addPosting(m_tokens[t.toString()], row);
+            };
+            forEachToken(task.description.get(), addToken);
+            for (const auto &annotation : task.annotations) {
+                forEachToken(annotation, addToken);
+            }
+        }
+    }
+
+    /// @returns ascending rows of the tasks matching @p query.
+    [[nodiscard]]
+    QList<int> select(const TasksFilterQuery &query) const
+    {
+        const auto size = static_cast<int>(m_tasks.size());
+        const auto cs = query.caseSensitivity();
+        QBitArray matched(size, true);
+        QStringList wordsToScan;
+        for (const auto &term : query.terms()) {
+            using Kind = TasksFilterQuery::Term::Kind;
+            switch (term.kind) {
+            case Kind::Project:
+                matched &= projectRows(term.value, cs);
+                break;
+            case Kind::HasTag:
+                matched &= toBits(m_tags.value(term.value));
+                break;
+            case Kind::NoTag:
+                matched &= ~toBits(m_tags.value(term.value));
+                break;
+            case Kind::Word:
+                if (isSingleToken(term.value)) {
+                    matched &= tokenRows(term.value, cs);
+                } else {
+                    wordsToScan << term.value;
+                }
+                break;
+            }
+        }
+
+        QList<int> rows;
+        for (int row = 0; row < size; ++row) {
+            if (!matched.testBit(row)) {
+                continue;
+            }
+            // Words with separators may span tokens, those are checked in
+            // already narrowed rows.
+            const auto &task = m_tasks.at(row);
+            const bool all = std::all_of(
+                wordsToScan.cbegin(), wordsToScan.cend(),
+                [&task, cs](const QString &w) {
+                    return task.description.get().contains(w, cs) ||
+                           std::any_of(task.annotations.cbegin(),
+                                       task.annotations.cend(),
+                                       [&w, cs](const QString &annotation) {
+                                           return annotation.contains(w, cs);
+                                       });
+                });
+            if (all) {
+                rows << row;
+            }
+        }
+        return rows;
+    }
+
+    /// @brief Calls @p callback for each word of @p text, word is continuous
+    /// letters and digits.
+    template <typename taCallback>
+    static void forEachToken(QStringView text, taCallback callback)
+    {
+        qsizetype start = -1;
+        for (qsizetype i = 0, sz = text.size(); i <= sz; ++i) {
+            const bool inWord = i < sz && text.at(i).isLetterOrNumber();
+            if (inWord && start < 0) {
+                start = i;
+            } else if (!inWord && start >= 0) {
+                callback(text.mid(start, i - start));
+                start = -1;
+            }
+        }
+    }
+
+  private:
+    [[nodiscard]]
+    static bool isSingleToken(const QString &word)
+    {
+        return std::all_of(word.cbegin(), word.cend(),
+                           [](QChar c) { return c.isLetterOrNumber(); });
+    }
+
+    static void addPosting(QList<int> &rows, const int row)
+    {
+        if (rows.isEmpty() || rows.last() != row) {
+            rows << row;
+        }
+    }
+
+    [[nodiscard]]
+    QBitArray toBits(const QList<int> &rows) const
+    {
+        QBitArray bits(static_cast<int>(m_tasks.size()));
+        for (const int row : rows) {
+            bits.setBit(row);
+        }
+        return bits;
+    }
+
+    /// @brief `task` matches the beginning of the project, so subprojects
+    /// are found too.
+    [[nodiscard]]
+    QBitArray projectRows(const QString &prefix,
+                          const Qt::CaseSensitivity cs) const
+    {
+        QBitArray bits(static_cast<int>(m_tasks.size()));
+        const auto addRows = [&bits](const QList<int> &rows) {
+            for (const int row : rows) {
+                bits.setBit(row);
+            }
+        };
+        if (cs == Qt::CaseInsensitive) {
+            // Projects are few, so all of them are checked.
+            for (auto it = m_projects.cbegin(); it != m_projects.cend(); ++it) {
+                if (it.key().startsWith(prefix, cs)) {
+                    addRows(it.value());
+                }
+            }
+            return bits;
+        }
+        for (auto it = m_projects.lowerBound(prefix);
+             it != m_projects.cend() && it.key().startsWith(prefix); ++it) {
+            addRows(it.value());
+        }
+        return bits;
+    }
+
+    /// @brief Word without separators can be found inside single token only,
+    /// so it is enough to check vocabulary instead of all descriptions.
+    [[nodiscard]]
+    QBitArray tokenRows(const QString &word, const Qt::CaseSensitivity cs) const
+    {
+        QBitArray bits(static_cast<int>(m_tasks.size()));
+        for (auto it = m_tokens.cbegin(); it != m_tokens.cend(); ++it) {
+            if (!it.key().contains(word, cs)) {
+                continue;
+            }
+            for (const int row : it.value()) {
+                bits.setBit(row);
+            }
+        }
+        return bits;
+    }
+
+    const QList<DetailedTaskInfo> m_tasks;
+    /// @brief Sorted, so subprojects follow the project.
+    QMap<QString, QList<int>> m_projects;
+    QHash<QString, QList<int>> m_tags;
+    QHash<QString, QList<int>> m_tokens;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "task.hpp"
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QtGlobal>
+
+#include <optional>
+
+/// @brief Rows of the tasks by UUID, so lookups do not scan the list
+/// comparing 36 characters strings. Index is rebuilt lazily by the first
+/// lookup after rows were changed, except removals which just shift the
+/// following rows.
+/// @note Keys are UUID strings as tasks keep them, so lookup does not parse
+/// anything. Tasks which are not saved yet may have any string there.
+class TasksRowIndex {
+  public:
+    /// @brief Must be called when rows were inserted, removed, moved or
+    /// replaced.
+    void invalidate() { m_valid = false; }
+
+    /// @brief Must be called before @p row is removed from @p tasks. Rows
+    /// which follow it are shifted, so index does not need to be rebuilt.
+    void removeRow(const QList<DetailedTaskInfo> &tasks, int row)
+    {
+        if (!m_valid || m_has_duplicates) {
+            invalidate();
+            return;
+        }
+        m_rows.remove(tasks.at(row).task_uuid);
+        for (auto &other : m_rows) {
+            if (other > row) {
+                --other;
+            }
+        }
+    }
+
+    /// @returns row of the task with @p uuid in @p tasks or std::nullopt.
+    /// @note The same @p tasks must be passed until invalidate().
+    [[nodiscard]]
+    std::optional<int> rowOf(const QList<DetailedTaskInfo> &tasks,
+                             const QString &uuid) const
+    {
+        if (!m_valid) {
+            rebuild(tasks);
+        }
+        const auto row = m_rows.value(uuid, -1);
+        if (row < 0) {
+            return std::nullopt;
+        }
+        Q_ASSERT(row < tasks.size());
+        return row;
+    }
+
+  private:
+    void rebuild(const QList<DetailedTaskInfo> &tasks) const
+    {
+        m_rows.clear();
+        m_has_duplicates = false;
+        m_rows.reserve(tasks.size());
+        for (int row = 0, sz = static_cast<int>(tasks.size()); row < sz;
+             ++row) {
+            const auto &uuid = tasks.at(row).task_uuid;
+            // The 1st row wins if UUID repeats.
+            if (m_rows.contains(uuid)) {
+                m_has_duplicates = true;
+                continue;
+            }
+            m_rows.insert(uuid, row);
+        }
+        m_valid = true;
+    }
+
+    mutable QHash<QString, int> m_rows;
+    /// @brief Removal of the 1st of duplicates would need to find the next
+    /// one, so index is rebuilt in that case.
+    mutable bool m_has_duplicates{ false };
+    mutable bool m_valid{ false };
+};
@@ -0,0 +1,173 @@
+#pragma once
+
+#include "description_trigram_index.hpp"
+#include "recurring_task_template.hpp"
+#include "task.hpp"
+#include "tasks_filter_index.hpp"
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+/// @brief Immutable state of the tasks database at some moment. It is shared
+/// by pointer to const, so any thread can keep and read it, lists inside are
+/// copied only if some consumer modifies its own copy.
+struct TasksSnapshot {
+    using Ptr = std::shared_ptr<const TasksSnapshot>;
+    using Version = std::uint64_t;
+
+    /// @brief Grows with each published snapshot, 0 means nothing was read
+    /// yet.
+    Version version{ 0u };
+    /// @brief All pending tasks sorted by urgency, not filtered by user.
+    QList<DetailedTaskInfo> pending;
+    /// @brief Templates of the recurring tasks, std::nullopt if nobody
+    /// requested them yet.
+    std::optional<QList<RecurringTaskTemplate>> recurring;
+
+    /// @returns index of the pending list, it is built on the 1st call.
+    /// @note It is safe to call from any thread.
+    [[nodiscard]]
+    const TasksFilterIndex &filterIndex() const
+    {
+        std::call_once(m_index_built, [this]() {
+            m_index = std::make_unique<const TasksFilterIndex>(pending);
+            m_index_ready.store(true, std::memory_order_release);
+        });
+        return *m_index;
+    }
+
+    /// @returns true if filterIndex() is built already, so GUI thread can
+    /// call it without waiting.
+    [[nodiscard]]
+    bool isFilterIndexReady() const
+    {
+        return m_index_ready.load(std::memory_order_acquire);
+    }
+
+    /// @returns trigram index of the pending descriptions, it is built on the
+    /// 1st call by updating the index given to setTrigramIndexBase().
+    /// @note It is safe to call from any thread.
+    [[nodiscard]]
+    const DescriptionTrigramIndex &trigramIndex() const
+    {
+        std::call_once(m_trigrams_built, [this]() {
+            m_trigrams = std::make_shared<const DescriptionTrigramIndex>(
+                m_trigrams_base ? m_trigrams_base->updated(pending)
+                                : DescriptionTrigramIndex(pending));
+            m_trigrams_ready.store(true, std::memory_order_release);
+        });
+        return *m_trigrams;
+    }
+
+    /// @returns the freshest trigram index known to this snapshot, it could
+    /// be index of some previous one, or nullptr if none was built yet.
+    [[nodiscard]]
+    std::shared_ptr<const DescriptionTrigramIndex> latestTrigramIndex() const
+    {
+        if (m_trigrams_ready.load(std::memory_order_acquire)) {
+            return m_trigrams;
+        }
+        return m_trigrams_base;
+    }
+
+    /// @brief Lets trigramIndex() patch @p base instead of building all.
+    /// @note It must be called before snapshot is published.
+    void
+    setTrigramIndexBase(std::shared_ptr<const DescriptionTrigramIndex> base)
+    {
+        m_trigrams_base = std::move(base);
+    }
+
+    /// @returns tasks of the pending list in given ascending @p rows.
+    [[nodiscard]]
+    QList<DetailedTaskInfo> selectRows(const QList<int> &rows) const
+    {
+        QList<DetailedTaskInfo> res;
+        res.reserve(rows.size());
+        for (const int row : rows) {
+            res << pending.at(row);
+        }
+        return res;
+    }
+
+    /// @returns subset of the @p tasks with given IDs keeping the order.
+    [[nodiscard]]
+    static QList<DetailedTaskInfo>
+    selectIds(const QList<DetailedTaskInfo> &tasks, const QSet<int> &ids)
+    {
+        QList<DetailedTaskInfo> res;
+        res.reserve(std::min<qsizetype>(tasks.size(), ids.size()));
+        for (const auto &task : tasks) {
+            if (ids.contains(task.task_id.toInt())) {
+                res << task;
+            }
+        }
+        return res;
+    }
+
+    /// @returns subset of the @p tasks found by fuzzy search, ordered by
+    /// score of @p hits, equal ones keep the order of @p tasks.
+    [[nodiscard]]
+    static QList<DetailedTaskInfo>
+    rankByHits(const QList<DetailedTaskInfo> &tasks,
+               const QList<DescriptionTrigramIndex::Hit> &hits)
+    {
+        QHash<QString, int> scores;
+        scores.reserve(hits.size());
+        for (const auto &hit : hits) {
+            scores.insert(hit.uuid, hit.score);
+        }
+        QList<std::pair<int, const DetailedTaskInfo *>> ranked;
+        for (const auto &task : tasks) {
+            const auto it = scores.constFind(task.task_uuid);
+            if (it != scores.cend()) {
+                ranked << std::make_pair(*it, &task);
+            }
+        }
+        std::stable_sort(
+            ranked.begin(), ranked.end(),
+            [](const auto &a, const auto &b) { return a.first > b.first; });
+        QList<DetailedTaskInfo> res;
+        res.reserve(ranked.size());
+        for (const auto &item : ranked) {
+            res << *item.second;
+        }
+        return res;
+    }
+
+    /// @returns subset of the @p tasks which can affect tray icon now or
+    /// later: active ones and ones with any date.
+    [[nodiscard]]
+    static QList<DetailedTaskInfo>
+    selectHot(const QList<DetailedTaskInfo> &tasks)
+    {
+        QList<DetailedTaskInfo> res;
+        for (const auto &task : tasks) {
+            if (task.active.get() || task.due.get().has_value() ||
+                task.sched.get().has_value() || task.wait.get().has_value()) {
+                res << task;
+            }
+        }
+        return res;
+    }
+
+  private:
+    // Snapshot is immutable, index is a cache which is built once.
+    mutable std::once_flag m_index_built;
+    mutable std::unique_ptr<const TasksFilterIndex> m_index;
+    mutable std::atomic<bool> m_index_ready{ false };
+    mutable std::once_flag m_trigrams_built;
+    mutable std::shared_ptr<const DescriptionTrigramIndex> m_trigrams;
+    mutable std::atomic<bool> m_trigrams_ready{ false };
+    std::shared_ptr<const DescriptionTrigramIndex> m_trigrams_base;
+};
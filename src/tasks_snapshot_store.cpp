@@ -0,0 +1,98 @@
+#include "tasks_snapshot_store.hpp"
+
+#include "recurring_task_template.hpp"
+#include "task.hpp"
+#include "tasks_snapshot.hpp"
+#include "taskwarrior.hpp"
+
+#include <QList>
+#include <QObject>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <utility>
+
+TasksSnapshotStore::TasksSnapshotStore(
+    std::shared_ptr<Taskwarrior> task_provider, QObject *parent)
+    : QObject(parent)
+    , m_task_provider(std::move(task_provider))
+    , m_current(std::make_shared<const TasksSnapshot>())
+    , m_loader(this)
+{
+}
+
+TasksSnapshot::Ptr TasksSnapshotStore::current() const
+{
+    const std::lock_guard lock(m_current_mutex);
+    return m_current;
+}
+
+void TasksSnapshotStore::publishPatched(QList<DetailedTaskInfo> pending)
+{
+    auto snapshot = std::make_shared<TasksSnapshot>();
+    snapshot->pending = std::move(pending);
+    snapshot->recurring = current()->recurring;
+    snapshot->setTrigramIndexBase(current()->latestTrigramIndex());
+    publish(std::move(snapshot));
+}
+
+void TasksSnapshotStore::requestRecurring()
+{
+    if (m_recurring_wanted && current()->recurring.has_value()) {
+        return;
+    }
+    m_recurring_wanted = true;
+    refresh();
+}
+
+void TasksSnapshotStore::refresh()
+{
+    m_loader.start(
+        [provider = m_task_provider, withRecurring = m_recurring_wanted,
+         trigrams = current()->latestTrigramIndex()]()
+            -> std::shared_ptr<TasksSnapshot> {
+            // This is non-GUI thread.
+            auto pending = provider->getUrgencySortedTasks();
+            if (!pending) {
+                return nullptr;
+            }
+            auto snapshot = std::make_shared<TasksSnapshot>();
+            snapshot->pending = std::move(*pending);
+            if (withRecurring) {
+                snapshot->recurring = provider->getRecurringTasks();
+            }
+            snapshot->setTrigramIndexBase(std::move(trigrams));
+            // Indexes are not built in GUI thread if those will be needed.
+            if (provider->isFilteredLocally()) {
+                std::ignore = snapshot->filterIndex();
+            }
+            if (provider->isSearchedFuzzy()) {
+                std::ignore = snapshot->trigramIndex();
+            }
+            return snapshot;
+        },
+        [this](std::shared_ptr<TasksSnapshot> snapshot) {
+            if (!snapshot) {
+                return;
+            }
+            // Templates which failed to read are kept from the previous one.
+            if (!snapshot->recurring) {
+                snapshot->recurring = current()->recurring;
+            }
+            publish(std::move(snapshot));
+        });
+}
+
+void TasksSnapshotStore::publish(std::shared_ptr<TasksSnapshot> snapshot)
+{
+    TasksSnapshot::Ptr published;
+    {
+        const std::lock_guard lock(m_current_mutex);
+        snapshot->version = m_current->version + 1;
+        m_current = std::move(snapshot);
+        published = m_current;
+    }
+    emit snapshotChanged(published);
+}
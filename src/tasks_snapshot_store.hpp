@@ -0,0 +1,61 @@
+#pragma once
+
+#include "latest_async_result.hpp"
+#include "task.hpp"
+#include "tasks_snapshot.hpp"
+#include "taskwarrior.hpp"
+
+#include <QList>
+#include <QObject>
+
+#include <memory>
+#include <mutex>
+
+/// @brief Keeps the current TasksSnapshot, which is the only source of the
+/// tasks lists for the table, tray icon and dialogs, so each refresh reads
+/// database once for all of them.
+class TasksSnapshotStore : public QObject {
+    Q_OBJECT
+  public:
+    explicit TasksSnapshotStore(std::shared_ptr<Taskwarrior> task_provider,
+                                QObject *parent = nullptr);
+
+    /// @returns the latest published snapshot, never nullptr.
+    /// @note It is safe to call from any thread.
+    [[nodiscard]]
+    TasksSnapshot::Ptr current() const;
+
+    /// @returns true if some refresh did not finish yet.
+    [[nodiscard]]
+    bool isLoading() const
+    {
+        return m_loader.isRunning();
+    }
+
+    /// @brief Publishes @p pending list which was patched without reading
+    /// database, other lists are kept.
+    void publishPatched(QList<DetailedTaskInfo> pending);
+
+    /// @brief Makes all following refreshes read recurring templates too and
+    /// starts one if current snapshot has none.
+    void requestRecurring();
+
+  public slots:
+    /// @brief Reads database in background and publishes the result.
+    void refresh();
+
+  signals:
+    /// @brief Sent in GUI thread when new snapshot becomes current.
+    void snapshotChanged(const TasksSnapshot::Ptr &snapshot);
+
+  private:
+    /// @brief Makes @p snapshot current, it must not be changed after.
+    void publish(std::shared_ptr<TasksSnapshot> snapshot);
+
+    std::shared_ptr<Taskwarrior> m_task_provider;
+    // Readers from other threads copy pointer under lock.
+    mutable std::mutex m_current_mutex;
+    TasksSnapshot::Ptr m_current;
+    LatestAsyncResult<std::shared_ptr<TasksSnapshot>> m_loader;
+    bool m_recurring_wanted{ false };
+};
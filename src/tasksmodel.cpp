@@ -1,9 +1,15 @@
 #include "tasksmodel.hpp"
 #include "block_guard.hpp"
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <optional>
+#include <tuple>
 #include <utility>
 
 #include <QAbstractTableModel>
@@ -11,33 +17,64 @@
 #include <QBrush>
 #include <QColor>
 #include <QDebug>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QHash>
 #include <QIcon>
 #include <QList>
 #include <QModelIndex>
 #include <QObject>
 #include <QPalette>
+#include <QScopedValueRollback>
+#include <QSet>
+#include <QString>
 #include <QStringList>
 #include <QTimer>
 #include <QVariant>
+#include <QtConcurrent> //NOLINT
 #include <QtCore/Qt>
 #include <qlogging.h>
 #include <qnamespace.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
+#include "configmanager.hpp"
+#include "filteredtaskslistreader.hpp"
+#include "list_diff.hpp"
+#include "patched_changes_gate.hpp"
+#include "string_intern_pool.hpp"
 #include "task.hpp"
+#include "task_changes_coalescer.hpp"
+#include "task_changes_listener.hpp"
+#include "task_details_cache.hpp"
 #include "task_emojies.hpp"
 #include "task_ids_providers.hpp"
+#include "tasks_snapshot.hpp"
+#include "tasks_snapshot_store.hpp"
 #include "tasksstatuseswatcher.hpp"
 #include "taskwarrior.hpp"
+#include "taskwarriorexecutor.hpp"
 #include "taskwatcher.hpp"
 #include "undo_tracker.hpp"
 #include "update_tray_icon_watcher.hpp"
 
 namespace
 {
-using namespace std::chrono_literals;
-constexpr auto kRefresheEmojiPeriod = 5s; // NOLINT
+/// @returns monotonic time for PatchedChangesGate.
+qint64 steadyNowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/// @brief If more rows must be moved or inserted on refresh, model is reset
+/// instead, it is cheaper for view.
+constexpr qsizetype kMaxIncrementalMoves = 1000;
+
+/// @brief Details are loaded for so many rows above and below visible ones, so
+/// scrolling a bit does not wait for loading.
+constexpr int kDetailsLookAheadRows = 30;
 
 const std::array<QString, 3> kColumnsHeaders = {
     QObject::tr("Status / Id"),
@@ -78,34 +115,40 @@ TasksModel::TasksModel(std::shared_ptr<Taskwarrior> task_provider,
     : QAbstractTableModel(parent)
     , m_tasks({})
     , m_task_provider(std::move(task_provider))
+    , m_snapshots(new TasksSnapshotStore(m_task_provider, this))
     , m_task_watcher(new TaskWatcher(this))
     , m_statuses_watcher(new TasksStatusesWatcher(
           [this]() -> const QList<DetailedTaskInfo> & {
               return std::as_const(m_tasks);
           },
-          this, kRefresheEmojiPeriod))
-    , m_icon_watcher(new UpdateTrayIconWatcher(this))
+          this))
+    , m_icon_watcher(new UpdateTrayIconWatcher(m_snapshots, this))
+    , m_changes_listener(new TaskChangesListener(this))
     , m_selected_provider(std::move(selected_provider))
 {
-    // This works with model's list (filtered) and handle re-order of columns
-    // when needed.
-    connect(m_statuses_watcher, &TasksStatusesWatcher::statusesWereChanged,
-            this, &TasksModel::delayedRefreshModel);
+    connect(m_snapshots, &TasksSnapshotStore::snapshotChanged, this,
+            &TasksModel::onSnapshotChanged);
+
+    // This works with model's list (filtered). Statuses are displayed right
+    // away, the list is re-read only if order could change.
+    connect(m_statuses_watcher,
+            &TasksStatusesWatcher::tasksStatusesWereChanged, this,
+            &TasksModel::onStatusesChanged);
 
     // This works with externald DB and detects if it had any write operation.
-    connect(m_task_watcher, &TaskWatcher::dataOnDiskWereChanged, this,
-            &TasksModel::refreshModel);
+    connect(m_task_watcher, &TaskWatcher::dataOnDiskWereChangedWithUndoCount,
+            this, &TasksModel::onDataOnDiskChanged);
+
+    // Rows are patched as soon as `task` reports changes through hooks.
+    connect(m_changes_listener, &TaskChangesListener::tasksWereChanged, this,
+            &TasksModel::applyChangedTasks);
 
-    // If user did something we need to refresh tray icon too.
-    connect(m_task_watcher, &TaskWatcher::dataOnDiskWereChanged, m_icon_watcher,
-            &UpdateTrayIconWatcher::checkNow);
     // Pass signal further that icon should be updated.
     connect(m_icon_watcher, &UpdateTrayIconWatcher::globalUrgencyChanged, this,
             &TasksModel::globalUrgencyChanged);
 
     // Need to trigger watcher at least once.
     m_task_watcher->checkNow();
-    m_icon_watcher->checkNow();
 }
 
 int TasksModel::rowCount(const QModelIndex & /*parent*/) const
@@ -144,8 +187,15 @@ QVariant TasksModel::data(const QModelIndex &index, const int role) const
     case Qt::TextAlignmentRole:
         return { Qt::AlignVCenter | Qt::AlignLeft };
     case Qt::BackgroundRole:
-        return QVariant(QBrush(rowColor(index.row())));
+        return QVariant(QBrush(presentation(index.row()).color));
     case TaskReadRole:
+        if (const auto *details = m_details.find(task.task_uuid)) {
+            // IDs and urgency are changed without modifying task.
+            auto full = *details;
+            full.task_id = task.task_id;
+            full.urgency = task.urgency;
+            return QVariant::fromValue(full);
+        }
         return QVariant::fromValue(task);
     default:
         break;
@@ -172,10 +222,14 @@ bool TasksModel::setData(const QModelIndex &idx, const QVariant &value,
         if (value.canConvert<DetailedTaskInfo>()) {
             const auto guard = BlockGuard(m_task_watcher, m_statuses_watcher);
             auto updatedTask = value.value<DetailedTaskInfo>();
-            const QDateTime now = QDateTime::currentDateTime();
+            const qint64 now = QDateTime::currentMSecsSinceEpoch();
 
             const auto oldUrgency =
                 StatusEmoji(m_tasks[row], now).getMostUrgentLevel();
+            forgetPresentations(row, row);
+            if (m_tasks.at(row).task_uuid != updatedTask.task_uuid) {
+                m_row_index.invalidate();
+            }
             m_tasks[row] = updatedTask;
             const auto newUrgency =
                 StatusEmoji(m_tasks[row], now).getMostUrgentLevel();
@@ -224,7 +278,33 @@ QColor TasksModel::rowColor(const int row) const
     if (row < 0 || row >= m_tasks.size()) {
         return getColorForPriority(DetailedTaskInfo::Priority::Unset);
     }
-    return getColorForPriority(m_tasks.at(row).priority.get());
+    return presentation(row).color;
+}
+
+TasksModel::RowPresentation TasksModel::presentation(const int row) const
+{
+    // Colors are blended with palette, all are stale if it was changed.
+    const auto base = qApp->palette().color(QPalette::Base);
+    if (base != m_presentations_base) {
+        m_presentations.clear();
+        m_presentations_base = base;
+    }
+    const auto &task = m_tasks.at(row);
+    auto it = m_presentations.find(task.task_uuid);
+    if (it == m_presentations.end()) {
+        it = m_presentations.insert(
+            task.task_uuid,
+            { StatusEmoji(task).getMostUrgentLevel(),
+              getColorForPriority(task.priority.get()), task.task_id });
+    }
+    return *it;
+}
+
+void TasksModel::forgetPresentations(const int first_row, const int last_row)
+{
+    for (int row = first_row; row <= last_row; ++row) {
+        m_presentations.remove(m_tasks.at(row).task_uuid);
+    }
 }
 
 void TasksModel::initUndoSupport()
@@ -233,39 +313,241 @@ void TasksModel::initUndoSupport()
             &m_task_provider->getActionsCounter(), &UndoTracker::newDbReading);
 }
 
-void TasksModel::refreshModel()
+void TasksModel::applyOptimistic(QFuture<bool> mutation,
+                                 const QStringList &uuids,
+                                 const OptimisticChange &change)
 {
-    const auto guard = BlockGuard(m_task_watcher, m_statuses_watcher);
-    const auto currentlySelectedTaskIds = m_selected_provider();
+    ++m_pending_mutations;
+    m_patched_gate.invalidate();
+    invalidateDetails();
+    if (!uuids.isEmpty()) {
+        const auto guard = BlockGuard(m_task_watcher, m_statuses_watcher);
+        QList<int> rows;
+        for (const auto &uuid : uuids) {
+            if (const auto row = m_row_index.rowOf(m_tasks, uuid)) {
+                rows << *row;
+            }
+        }
+        // Removal from the end keeps following rows valid.
+        std::sort(rows.begin(), rows.end(), std::greater<>());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+        for (const int row : rows) {
+            if (change) {
+                forgetPresentations(row, row);
+                change(m_tasks[row]);
+                emit dataChanged(index(row, 0), index(row, columnCount() - 1),
+                                 { Qt::DisplayRole, Qt::BackgroundRole });
+            } else {
+                forgetPresentations(row, row);
+                beginRemoveRows(QModelIndex(), row, row);
+                m_row_index.removeRow(m_tasks, row);
+                m_tasks.removeAt(row);
+                endRemoveRows();
+            }
+        }
+        dataUpdated();
+    }
 
-    // Load whole tasks list from disk
-    auto tasks = m_task_provider->getUrgencySortedTasks();
-    if (!tasks.has_value()) {
+    auto *watcher = new QFutureWatcher<bool>(this);
+    connect(watcher, &QFutureWatcher<bool>::finished, this, [this, watcher]() {
+        // This is GUI thread.
+        watcher->deleteLater();
+        if (!watcher->result()) {
+            ++m_failed_mutations;
+        }
+        if (--m_pending_mutations == 0) {
+            if (m_failed_mutations > 0) {
+                emit mutationsFailed(std::exchange(m_failed_mutations, 0));
+            }
+            // IDs, urgency and order are known after `task` only. Failed
+            // modifications are rolled back by this too.
+            invalidateDetails();
+            refreshModel();
+        }
+    });
+    watcher->setFuture(std::move(mutation));
+}
+
+void TasksModel::prefetchDetails(int first_row, int last_row)
+{
+    // Details would be older than rows changed by applyOptimistic().
+    if (m_pending_mutations > 0) {
+        return;
+    }
+    const int size = static_cast<int>(m_tasks.size());
+    first_row = std::max(0, first_row - kDetailsLookAheadRows);
+    last_row = std::min(size - 1, last_row + kDetailsLookAheadRows);
+    QStringList wanted;
+    for (int row = first_row; row <= last_row; ++row) {
+        wanted << m_tasks.at(row).task_uuid;
+    }
+    const auto uuids = m_details.takeMissing(wanted);
+    if (uuids.isEmpty()) {
+        return;
+    }
+
+    auto *watcher =
+        new QFutureWatcher<std::optional<QList<DetailedTaskInfo>>>(this);
+    connect(watcher,
+            &QFutureWatcher<std::optional<QList<DetailedTaskInfo>>>::finished,
+            this,
+            [this, watcher, uuids, generation = m_details.generation()]() {
+                // This is GUI thread.
+                watcher->deleteLater();
+                m_details.store(generation, uuids, watcher->result());
+            });
+    watcher->setFuture(QtConcurrent::run(
+        [uuids](const QString &pathToBinary)
+            -> std::optional<QList<DetailedTaskInfo>> {
+            // This is non-GUI thread.
+            try {
+                return TaskDetailsCache::exportDetails(
+                    TaskWarriorExecutor(
+                        pathToBinary,
+                        TaskWarriorExecutor::TSkipBinaryValidation{}),
+                    uuids);
+            } catch (...) { // NOLINT
+            }
+            return std::nullopt;
+        },
+        ConfigManager::config().get(ConfigManager::TaskBin)));
+}
+
+void TasksModel::invalidateDetails()
+{
+    m_details.invalidate();
+    emit detailsInvalidated();
+}
+
+void TasksModel::refreshModel() { m_snapshots->refresh(); }
+
+void TasksModel::applyFilter()
+{
+    auto snapshot = m_snapshots->current();
+    if (!m_task_provider->isFilteredLocally() ||
+        snapshot->isFilterIndexReady()) {
+        onSnapshotChanged(snapshot);
         return;
     }
+    // The 1st filter of this snapshot builds the index, it is not done in
+    // GUI thread.
+    auto *watcher = new QFutureWatcher<void>(this);
+    connect(watcher, &QFutureWatcher<void>::finished, this,
+            [this, watcher]() {
+                watcher->deleteLater();
+                onSnapshotChanged(m_snapshots->current());
+            });
+    watcher->setFuture(QtConcurrent::run(
+        [snapshot = std::move(snapshot)]() {
+            std::ignore = snapshot->filterIndex();
+        }));
+}
+
+void TasksModel::onSnapshotChanged(const TasksSnapshot::Ptr &snapshot)
+{
+    // Refresh is repeated when queued modifications are finished.
+    if (m_publishing_patch || m_pending_mutations > 0) {
+        return;
+    }
+    applyRefreshedTasks(m_task_provider->filterTasks(*snapshot));
+}
+
+void TasksModel::applyRefreshedTasks(QList<DetailedTaskInfo> tasks)
+{
+    const auto guard = BlockGuard(m_task_watcher, m_statuses_watcher);
+    const auto operations =
+        ListDiff::compute(tasksListToIds(m_tasks, kTaskUuidGetter),
+                          tasksListToIds(tasks, kTaskUuidGetter),
+                          kMaxIncrementalMoves);
+    if (operations) {
+        applyRowOperations(*operations, std::move(tasks));
+    } else {
+        resetTasks(std::move(tasks));
+    }
+    dataUpdated();
+}
+
+void TasksModel::resetTasks(QList<DetailedTaskInfo> tasks)
+{
+    const auto selected = m_selected_provider();
+    const QSet<QString> currentlySelectedTaskIds(selected.cbegin(),
+                                                 selected.cend());
     beginResetModel();
-    m_tasks = std::move(*tasks);
+    m_tasks = std::move(tasks);
+    m_row_index.invalidate();
+    m_presentations.clear();
     endResetModel();
+    // Projects and tags of the tasks which are gone are not needed anymore.
+    StringInternPool::evictUnused();
     QModelIndexList indicesToSelect;
 
-    for (qsizetype i = 0, sz = m_tasks.count(); i < sz; ++i) {
-        // Do not read m_tasks directly, use data(), because it ensures proper
-        // mapping of the index.
-        const auto newIndex = createIndex(static_cast<int>(i), 0);
-        const auto task = data(newIndex, TaskReadRole);
-
-        if (!task.isValid() || !task.canConvert<DetailedTaskInfo>()) {
-            continue;
-        }
-        const auto &taskUuid = kTaskUuidGetter(task.value<DetailedTaskInfo>());
-        if (currentlySelectedTaskIds.contains(taskUuid)) {
-            indicesToSelect.append(newIndex);
+    for (const auto &uuid : currentlySelectedTaskIds) {
+        if (const auto row = m_row_index.rowOf(m_tasks, uuid)) {
+            indicesToSelect.append(createIndex(*row, 0));
         }
     }
+    std::sort(indicesToSelect.begin(), indicesToSelect.end());
     if (!indicesToSelect.isEmpty()) {
         emit restoreSelected(indicesToSelect);
     }
-    dataUpdated();
+}
+
+void TasksModel::applyRowOperations(const ListDiff::Operations &operations,
+                                    QList<DetailedTaskInfo> tasks)
+{
+    using Kind = ListDiff::Operation::Kind;
+    m_row_index.invalidate();
+    for (const auto &op : operations) {
+        switch (op.kind) {
+        case Kind::Remove:
+            forgetPresentations(op.row, op.row + op.count - 1);
+            beginRemoveRows(QModelIndex(), op.row, op.row + op.count - 1);
+            m_tasks.remove(op.row, op.count);
+            endRemoveRows();
+            break;
+        case Kind::Move:
+            beginMoveRows(QModelIndex(), op.row, op.row, QModelIndex(),
+                          op.destination);
+            m_tasks.move(op.row, op.row < op.destination ? op.destination - 1
+                                                         : op.destination);
+            endMoveRows();
+            break;
+        case Kind::Insert:
+            beginInsertRows(QModelIndex(), op.row, op.row + op.count - 1);
+            m_tasks.insert(op.row, op.count, DetailedTaskInfo{});
+            std::copy_n(tasks.cbegin() + op.source, op.count,
+                        m_tasks.begin() + op.row);
+            endInsertRows();
+            break;
+        }
+    }
+
+    // Now rows are ordered as in new list, only changed ones are updated.
+    int changedFirst = -1;
+    const auto reportChanged = [this, &changedFirst](int end) {
+        if (changedFirst >= 0) {
+            emit dataChanged(index(changedFirst, 0),
+                             index(end - 1, columnCount() - 1),
+                             { Qt::DisplayRole, Qt::BackgroundRole });
+            changedFirst = -1;
+        }
+    };
+    for (int row = 0, sz = static_cast<int>(tasks.size()); row < sz; ++row) {
+        const bool same = m_tasks.at(row).hasSameData(tasks.at(row));
+        if (!same) {
+            forgetPresentations(row, row);
+        }
+        // Urgency is not displayed, but it is kept fresh.
+        m_tasks[row] = std::move(tasks[row]);
+        if (same) {
+            reportChanged(row);
+        } else if (changedFirst < 0) {
+            changedFirst = row;
+        }
+    }
+    reportChanged(static_cast<int>(m_tasks.size()));
+    // Projects and tags of the removed and replaced rows may be unused now.
+    StringInternPool::evictUnused();
 }
 
 void TasksModel::refreshIfChangedOnDisk()
@@ -281,6 +563,102 @@ void TasksModel::delayedRefreshModel()
     QTimer::singleShot(2500, this, [this]() { refreshModel(); });
 }
 
+void TasksModel::onDataOnDiskChanged(const std::uint64_t undo_count)
+{
+    invalidateDetails();
+    if (m_patched_gate.needsRefresh(undo_count, steadyNowMs())) {
+        refreshModel();
+    }
+}
+
+void TasksModel::applyChangedTasks(const TaskChangesCoalescer::Batch &batch)
+{
+    // Task could leave or enter filtered list, only `task` knows. Refresh
+    // which is running now could read data before the change.
+    bool allPatched = batch.complete && !m_task_provider->isFiltered() &&
+                      !m_snapshots->isLoading();
+    if (!allPatched) {
+        m_patched_gate.invalidate();
+        return;
+    }
+    const auto guard = BlockGuard(m_task_watcher, m_statuses_watcher);
+    invalidateDetails();
+    bool anyPatched = false;
+    for (const auto &change : batch.changes) {
+        const auto found = m_row_index.rowOf(m_tasks, change.uuid);
+        if (!found) {
+            // New task, it has no ID yet.
+            allPatched = false;
+            continue;
+        }
+        const int row = *found;
+        if (change.status != "pending" && change.status != "waiting") {
+            // `task` renumbers tasks when some leaves pending list, so IDs
+            // must be re-read anyway.
+            forgetPresentations(row, row);
+            beginRemoveRows(QModelIndex(), row, row);
+            m_row_index.removeRow(m_tasks, row);
+            m_tasks.removeAt(row);
+            endRemoveRows();
+            anyPatched = true;
+            allPatched = false;
+            continue;
+        }
+        auto task = FilteredTasksListReader::parseTask(change.json);
+        if (!task) {
+            allPatched = false;
+            continue;
+        }
+        // Hooks do not receive ID and urgency, old values are kept until
+        // the next full refresh.
+        task->task_id = m_tasks.at(row).task_id;
+        task->urgency = m_tasks.at(row).urgency;
+        forgetPresentations(row, row);
+        m_tasks[row] = std::move(*task);
+        emit dataChanged(index(row, 0), index(row, columnCount() - 1),
+                         { Qt::DisplayRole, Qt::BackgroundRole });
+        anyPatched = true;
+    }
+    if (allPatched) {
+        m_patched_gate.patched(batch.calls, steadyNowMs());
+        // Unfiltered rows are the whole list, others see the change too.
+        // Rows changed by queued modifications are not confirmed yet.
+        if (m_pending_mutations == 0) {
+            const QScopedValueRollback publishing(m_publishing_patch, true);
+            m_snapshots->publishPatched(m_tasks);
+        }
+    } else {
+        m_patched_gate.invalidate();
+    }
+    if (anyPatched) {
+        dataUpdated();
+    }
+}
+
+void TasksModel::onStatusesChanged(const QList<int> &rows, bool reorders)
+{
+    repaintRows(rows);
+    if (reorders) {
+        // Refresh restarts watching with the new list.
+        delayedRefreshModel();
+    } else {
+        m_statuses_watcher->resumeWatching();
+    }
+}
+
+void TasksModel::repaintRows(const QList<int> &rows)
+{
+    const int size = static_cast<int>(m_tasks.size());
+    for (const int row : rows) {
+        if (row < size) {
+            // Urgency level depends on current time.
+            forgetPresentations(row, row);
+            emit dataChanged(index(row, 0), index(row, columnCount() - 1),
+                             { Qt::DisplayRole, Qt::BackgroundRole });
+        }
+    }
+}
+
 void TasksModel::dataUpdated()
 {
     m_statuses_watcher->startWatchingStatusesChange();
@@ -3,22 +3,35 @@
 
 #include <QAbstractTableModel>
 #include <QColor>
+#include <QHash>
+#include <QFuture>
 #include <QList>
 #include <QModelIndex>
+#include <QString>
 #include <QStringList>
 #include <QTimer>
 #include <QVariant>
 #include <QtCore/Qt>
 
+#include "list_diff.hpp"
+#include "patched_changes_gate.hpp"
 #include "task.hpp"
+#include "task_changes_coalescer.hpp"
+#include "task_changes_listener.hpp"
+#include "task_details_cache.hpp"
 #include "task_emojies.hpp"
+#include "tasks_row_index.hpp"
+#include "tasks_snapshot.hpp"
+#include "tasks_snapshot_store.hpp"
 #include "tasksstatuseswatcher.hpp"
 #include "taskwarrior.hpp"
 #include "taskwatcher.hpp"
 #include "update_tray_icon_watcher.hpp"
 
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 
 class TasksModel : public QAbstractTableModel {
     Q_OBJECT
@@ -26,6 +39,16 @@ class TasksModel : public QAbstractTableModel {
     /// @brief Provider should return IDs of the selected tasks at the moment
     /// when it was called.
     using SelectionProvider = std::function<QStringList()>;
+    /// @brief Changes task the way it is expected to be after modification.
+    /// Empty one means task leaves the list.
+    using OptimisticChange = std::function<void(DetailedTaskInfo &)>;
+
+    /// @brief Data derived from the task which delegates need on each paint.
+    struct RowPresentation {
+        StatusEmoji::EmojiUrgency urgency;
+        QColor color;
+        QString id_text;
+    };
 
     static constexpr auto TaskUpdateRole = Qt::UserRole + 1;
     static constexpr auto TaskReadRole = Qt::UserRole + 2;
@@ -52,7 +75,31 @@ class TasksModel : public QAbstractTableModel {
 
     [[nodiscard]] QColor rowColor(int row) const;
 
+    /// @returns presentation of the @p row, it is computed once after the
+    /// row was changed.
+    /// @note It is a copy: cache is a hash, which rehashes on insertion.
+    [[nodiscard]]
+    RowPresentation presentation(int row) const;
+
     void initUndoSupport();
+
+    /// @brief Shows queued @p mutation of the tasks with @p uuids right away,
+    /// by applying @p change to their rows. When all queued modifications are
+    /// finished, list is re-read, so failed ones are rolled back.
+    void applyOptimistic(QFuture<bool> mutation, const QStringList &uuids,
+                         const OptimisticChange &change = {});
+
+    /// @returns store of the snapshots, which rows are derived from.
+    [[nodiscard]]
+    TasksSnapshotStore *snapshots() const
+    {
+        return m_snapshots;
+    }
+
+    /// @brief Loads full details of the tasks in rows from @p first_row to
+    /// @p last_row and a few around in background, so TaskReadRole gives
+    /// fully read tasks for them.
+    void prefetchDetails(int first_row, int last_row);
   signals:
     /// @brief View can listen this signal if it wants to restore selection
     /// after model reset.
@@ -60,22 +107,52 @@ class TasksModel : public QAbstractTableModel {
     /// reordered/resized.
     void restoreSelected(const QModelIndexList &);
     void globalUrgencyChanged(StatusEmoji::EmojiUrgency);
+    /// @brief Emitted once all queued modifications finished, if
+    /// @p failed_count of them were failed by `task`.
+    void mutationsFailed(int failed_count);
+    /// @brief Emitted when loaded details were dropped, view should prefetch
+    /// visible rows again.
+    void detailsInvalidated();
 
   public slots:
     /// @brief Queries taskwatcher for the fresh/current sorted list of the
-    /// tasks.
+    /// tasks. List is read in background, rows are updated when it is ready.
     void refreshModel();
 
+    /// @brief Updates rows to the current filter of the task provider from
+    /// the current snapshot, without reading database.
+    void applyFilter();
+
     /// @brief This is lazy refresh, if it was no changes on disk, it will do
     /// nothing. Which means it will NOT react for time-going changes.
     void refreshIfChangedOnDisk();
   private slots:
     void delayedRefreshModel();
 
+    /// @brief Repaints @p rows, which changed statuses because of time
+    /// passing. List is re-read only if @p reorders, otherwise watching
+    /// continues with the same deadlines.
+    void onStatusesChanged(const QList<int> &rows, bool reorders);
+
+    /// @brief Full refresh, unless it was already shown by patching rows.
+    /// @param undo_count - undo transactions count after the change.
+    void onDataOnDiskChanged(std::uint64_t undo_count);
+
+    /// @brief Shows filtered @p snapshot.
+    void onSnapshotChanged(const TasksSnapshot::Ptr &snapshot);
+
+    /// @brief Patches rows of the tasks changed by `task` without re-reading
+    /// list. New tasks are shown by the following full refresh.
+    void applyChangedTasks(const TaskChangesCoalescer::Batch &batch);
+
   private:
     QList<DetailedTaskInfo> m_tasks;
+    /// @brief Rows of m_tasks by UUID.
+    TasksRowIndex m_row_index;
 
     std::shared_ptr<Taskwarrior> m_task_provider;
+    /// @brief Keeps unfiltered tasks list shared with tray and dialogs.
+    TasksSnapshotStore *m_snapshots;
 
     /// @brief It watches writes to db from anywhere (including us).
     TaskWatcher *m_task_watcher;
@@ -85,9 +162,49 @@ class TasksModel : public QAbstractTableModel {
     /// @brief Watches full "hot" data in nearest future to update status bar
     /// icon. It does not use filtered list from this model.
     UpdateTrayIconWatcher *m_icon_watcher;
+    /// @brief Receives tasks changed by `task` hooks, if those are enabled.
+    TaskChangesListener *m_changes_listener;
     SelectionProvider m_selected_provider;
+    /// @brief Tells if following change on disk is already displayed by
+    /// patched rows.
+    PatchedChangesGate m_patched_gate;
+    /// @brief Set while rows patched by hooks are published, so model does
+    /// not apply own snapshot.
+    bool m_publishing_patch{ false };
+    /// @brief Modifications shown by applyOptimistic() which are not finished
+    /// yet. Lists read meanwhile could miss some of them, so those are not
+    /// applied.
+    int m_pending_mutations{ 0 };
+    /// @brief Failed ones of m_pending_mutations, reported all at once.
+    int m_failed_mutations{ 0 };
+    /// @brief Full details of the tasks around visible rows.
+    TaskDetailsCache m_details;
+    /// @brief Presentations by UUID, so moved rows keep theirs.
+    mutable QHash<QString, RowPresentation> m_presentations;
+    /// @brief Palette color which row colors were blended with.
+    mutable QColor m_presentations_base;
+
+    /// @brief Drops presentations of the @p rows, those are changed.
+    void forgetPresentations(int first_row, int last_row);
+
+    void invalidateDetails();
 
     void dataUpdated();
+
+    /// @brief Makes view to repaint @p rows, which changed statuses because of
+    /// time passing.
+    void repaintRows(const QList<int> &rows);
+
+    /// @brief Updates rows to show @p tasks read by refreshModel().
+    void applyRefreshedTasks(QList<DetailedTaskInfo> tasks);
+
+    /// @brief Replaces all rows, used when too much was changed.
+    void resetTasks(QList<DetailedTaskInfo> tasks);
+
+    /// @brief Turns current rows into @p tasks by @p operations computed by
+    /// ListDiff, so view keeps selection and scroll position.
+    void applyRowOperations(const ListDiff::Operations &operations,
+                            QList<DetailedTaskInfo> tasks);
 };
 
 #endif // TASKSMODEL_HPP
@@ -2,11 +2,14 @@
 #include "task_date_time.hpp"
 
 #include <QDateTime>
+#include <QList>
 #include <QObject>
 #include <QTimer>
 #include <qtmetamacros.h>
 
+#include <algorithm>
 #include <chrono>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 namespace
@@ -42,10 +45,8 @@ relationForRole(const TasksStatusesWatcher::StatusPerTask &status,
 }
 
 TasksStatusesWatcher::Statuses
-computeStatusesNow(const QList<DetailedTaskInfo> &tasks)
+computeStatusesNow(const QList<DetailedTaskInfo> &tasks, const qint64 now)
 {
-    const QDateTime now = QDateTime::currentDateTime();
-
     TasksStatusesWatcher::Statuses currentStatuses;
     currentStatuses.reserve(tasks.size());
     for (const auto &task : tasks) {
@@ -66,28 +67,70 @@ computeStatusesNow(const QList<DetailedTaskInfo> &tasks)
 
 TasksStatusesWatcher::TasksStatusesWatcher(
     TasksProvider tasksProvider, QObject *parent,
-    std::chrono::milliseconds checkInterval)
+    std::chrono::milliseconds checkInterval, std::chrono::milliseconds maxSleep,
+    Clock clock)
     : QObject{ parent }
     , tasks_provider(std::move(tasksProvider))
+    , periodic_check_interval(checkInterval)
+    , max_sleep(maxSleep)
+    , clock(std::move(clock))
 {
-    periodic_statuses_check.setSingleShot(true);
-    periodic_statuses_check.setInterval(
-        static_cast<int>(checkInterval.count()));
+    statuses_check.setSingleShot(true);
+    statuses_check.setTimerType(Qt::PreciseTimer);
 
-    QTimer::connect(&periodic_statuses_check, &QTimer::timeout, this, [this]() {
-        auto currentStatuses = computeStatusesNow(tasks_provider());
-        if (currentStatuses != last_known_statuses) {
-            last_known_statuses = std::move(currentStatuses);
-            emit statusesWereChanged();
-            return;
-        }
-        periodic_statuses_check.start();
-    });
+    QTimer::connect(&statuses_check, &QTimer::timeout, this,
+                    &TasksStatusesWatcher::checkStatuses);
 }
 
 void TasksStatusesWatcher::startWatchingStatusesChange()
 {
-    periodic_statuses_check.stop();
-    last_known_statuses = computeStatusesNow(tasks_provider());
-    periodic_statuses_check.start();
+    statuses_check.stop();
+    const auto &tasks = tasks_provider();
+    // Taken once per scan, it is cheaper than local date-time.
+    const qint64 now = clock();
+    deadlines.rebuild(tasks, now);
+    if (periodic_check_interval != kNoPeriodicCheck) {
+        last_known_statuses = computeStatusesNow(tasks, now);
+    }
+    scheduleNextCheck();
+}
+
+void TasksStatusesWatcher::resumeWatching()
+{
+    scheduleNextCheck();
+}
+
+void TasksStatusesWatcher::scheduleNextCheck()
+{
+    std::optional<qint64> interval;
+    if (const auto next = deadlines.next()) {
+        // Sleeping longer could miss deadline after suspend or clock change.
+        interval = std::clamp<qint64>(*next - clock(), 0, max_sleep.count());
+    }
+    if (periodic_check_interval != kNoPeriodicCheck) {
+        interval = std::min<qint64>(interval.value_or(max_sleep.count()),
+                                    periodic_check_interval.count());
+    }
+    if (interval) {
+        statuses_check.start(static_cast<int>(*interval));
+    }
+}
+
+void TasksStatusesWatcher::checkStatuses()
+{
+    const qint64 now = clock();
+    const auto passed = deadlines.takePassed(now);
+    bool changed = !passed.rows.isEmpty();
+    if (periodic_check_interval != kNoPeriodicCheck) {
+        auto currentStatuses = computeStatusesNow(tasks_provider(), now);
+        changed = changed || currentStatuses != last_known_statuses;
+        last_known_statuses = std::move(currentStatuses);
+    }
+    if (changed) {
+        emit tasksStatusesWereChanged(passed.rows, passed.reorders);
+        emit statusesWereChanged();
+        return;
+    }
+    // Timer could fire a bit earlier or it was limited by max_sleep.
+    scheduleNextCheck();
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "status_deadlines.hpp"
 #include "task.hpp"
 #include "task_date_time.hpp"
 
@@ -8,13 +9,19 @@
 #include <tuple>
 #include <vector>
 
+#include <QDateTime>
 #include <QList>
 #include <QObject>
 #include <QTimer>
+#include <qtypes.h>
 
 //! @brief This class tracks possible status changes and generate signal, which
 //! can be used to re-read taskwatcher. Status changes because of natural time
 //! pass.
+//! @note Timer is set to the nearest moment when some date changes its
+//! relation, but not longer than kMaxSleep. Monotonic timer does not count
+//! time of suspend and does not follow wall clock changes, so deadline is
+//! re-checked by wall clock at least that often.
 class TasksStatusesWatcher : public QObject {
     Q_OBJECT
   public:
@@ -23,24 +30,57 @@ class TasksStatusesWatcher : public QObject {
     using Statuses = std::vector<StatusPerTask>;
 
     using TasksProvider = std::function<const QList<DetailedTaskInfo> &()>;
+
+    /// @brief Returns wall clock time as milliseconds since epoch.
+    using Clock = std::function<qint64()>;
+
+    /// @brief Disables periodic comparison of all statuses.
+    static constexpr std::chrono::milliseconds kNoPeriodicCheck{ 0 };
+    /// @brief Longest time timer is armed for.
+    static constexpr std::chrono::milliseconds kMaxSleep{ 60000 };
+
+    /// @param checkInterval - if it is not kNoPeriodicCheck, all statuses are
+    /// compared also with this period, so changes of the list, which were not
+    /// followed by startWatchingStatusesChange(), are detected too.
+    /// @param maxSleep, clock - are replaced by tests.
     explicit TasksStatusesWatcher(
         TasksProvider tasksProvider, QObject *parent = nullptr,
-        std::chrono::milliseconds checkInterval = std::chrono::minutes(5));
+        std::chrono::milliseconds checkInterval = kNoPeriodicCheck,
+        std::chrono::milliseconds maxSleep = kMaxSleep,
+        Clock clock = &QDateTime::currentMSecsSinceEpoch);
 
   public slots:
     /// @brief Records statuses now, as base for watching in future. Does not
     /// produce signal statusesWereChanged().
     /// @note It must be called at least once to start watching.
     void startWatchingStatusesChange();
+
+    /// @brief Continues watching after statusesWereChanged(), when the list
+    /// is the same. Passed deadlines were replaced by the following ones
+    /// already, so nothing is re-computed.
+    void resumeWatching();
   signals:
     /// @brief Signal is sent when we detect recorded statuses were changed
     /// comparing to what tasks_provider provides right now.
     /// @note Once signal is sent, statuses are no longer watched, it must be
     /// restart by call to startWatchingStatusesChange().
     void statusesWereChanged();
+    /// @brief Sent right before statusesWereChanged() with indexes of the
+    /// tasks which changed statuses. @p rows is empty if change was found by
+    /// periodic check.
+    /// @param reorders - urgency changed by step, so order of the tasks could
+    /// change (see StatusDeadlines::Passed).
+    void tasksStatusesWereChanged(const QList<int> &rows, bool reorders);
 
   private:
+    void scheduleNextCheck();
+    void checkStatuses();
+
     TasksProvider tasks_provider;
     Statuses last_known_statuses;
-    QTimer periodic_statuses_check;
+    StatusDeadlines deadlines;
+    std::chrono::milliseconds periodic_check_interval;
+    std::chrono::milliseconds max_sleep;
+    Clock clock;
+    QTimer statuses_check;
 };
@@ -1,34 +1,20 @@
 #include "taskstatusesdelegate.hpp"
-#include "task.hpp"
 #include "task_emojies.hpp"
 #include "taskhintproviderdelegate.hpp"
 #include "tasksmodel.hpp"
 
+#include <QFontMetrics>
 #include <QLinearGradient>
 #include <QModelIndex>
 #include <QObject>
+#include <QPaintDevice>
 #include <QPainter>
+#include <QPoint>
 #include <QStyle>
 #include <QStyleOptionViewItem>
 #include <QStyledItemDelegate>
 #include <qnamespace.h>
 
-namespace
-{
-[[nodiscard]]
-QString makeAlignedCombinedEmoji(const StatusEmoji &status)
-{
-    static const auto wrap = [](QString src) {
-        if (!src.isEmpty()) {
-            return src;
-        }
-        return QString::fromUtf8("\u2003");
-    };
-
-    return wrap(StatusEmoji::urgencyToEmoji(status.getMostUrgentLevel()));
-}
-} // namespace
-
 TaskStatusesDelegate::TaskStatusesDelegate(QObject *parent)
     : TaskHintProviderDelegate(parent)
 {
@@ -38,25 +24,24 @@ void TaskStatusesDelegate::paint(QPainter *painter,
                                  const QStyleOptionViewItem &option,
                                  const QModelIndex &index) const
 {
-    const auto task_var = index.data(TasksModel::TaskReadRole);
-    if (!task_var.canConvert<DetailedTaskInfo>()) {
+    const auto *model = qobject_cast<const TasksModel *>(index.model());
+    if (model == nullptr) {
         return;
     }
-    const auto task = task_var.value<DetailedTaskInfo>();
-
     QStyleOptionViewItem opt = option;
     initStyleOption(&opt, index);
 
-    const auto idText = index.data(Qt::DisplayRole).toString();
-    const auto prefix = makeAlignedCombinedEmoji(StatusEmoji{ task });
-    const QFontMetrics fm(opt.font);
-    const int emojiWidth = fm.horizontalAdvance(prefix);
+    // Presentation is read directly, task is not copied through QVariant.
+    const auto row = model->presentation(index.row());
+    const auto &idText = row.id_text;
+    const auto &glyph = glyphs.glyph(row.urgency, opt.font,
+                                     opt.palette.color(QPalette::Text),
+                                     painter->device()->devicePixelRatioF());
+    const int emojiWidth = glyph.width;
 
     painter->save();
 
-    const auto bg = index.data(Qt::BackgroundRole);
-    const auto taskColor =
-        bg.isValid() ? bg.value<QColor>() : opt.palette.base().color();
+    const auto taskColor = row.color;
     painter->fillRect(option.rect, taskColor);
 
     painter->setPen(option.palette.color(QPalette::Text));
@@ -82,9 +67,15 @@ void TaskStatusesDelegate::paint(QPainter *painter,
         painter->setPen(opt.palette.color(QPalette::HighlightedText));
     }
 
-    // Drawing text
+    // Emoji is pre-rendered, only ID is drawn as text.
+    const QFontMetrics fm(opt.font);
+    painter->drawPixmap(
+        QPoint(option.rect.left(),
+               option.rect.top() + (option.rect.height() - fm.height()) / 2),
+        glyph.pixmap);
     painter->setFont(opt.font);
-    painter->drawText(option.rect, opt.displayAlignment, prefix + " " + idText);
+    painter->drawText(option.rect.adjusted(emojiWidth, 0, 0, 0),
+                      opt.displayAlignment, " " + idText);
 
     painter->restore();
 }
@@ -7,6 +7,7 @@
 #include <QWidget>
 
 #include "taskhintproviderdelegate.hpp"
+#include "urgency_glyph_cache.hpp"
 
 /// @brief This delegate excludes emoji from selection in cell. Selection is
 /// painted AFTER emoji.
@@ -18,4 +19,7 @@ class TaskStatusesDelegate : public TaskHintProviderDelegate {
   protected:
     void paint(QPainter *painter, const QStyleOptionViewItem &option,
                const QModelIndex &index) const override;
+
+  private:
+    mutable UrgencyGlyphCache glyphs;
 };
@@ -1,5 +1,6 @@
 #include "tasksview.hpp"
 
+#include <QAbstractItemModel>
 #include <QApplication>
 #include <QCursor>
 #include <QDebug>
@@ -7,7 +8,11 @@
 #include <QMouseEvent>
 #include <QObject>
 #include <QPoint>
+#include <QResizeEvent>
+#include <QScrollBar>
+#include <QStyleOptionViewItem>
 #include <QTableView>
+#include <QTimer>
 #include <QWidget>
 #include <qnamespace.h>
 #include <qtmetamacros.h>
@@ -16,13 +21,68 @@
 #include "taskdescriptiondelegate.hpp"
 #include "tasksmodel.hpp"
 
+#include <algorithm>
+
+namespace
+{
+constexpr int kPrefetchDelayMs = 100;
+} // namespace
+
 TasksView::TasksView(QWidget *parent)
     : QTableView(parent)
+    , m_prefetch_timer(new QTimer(this))
 {
     // needed for the hover functionality
     setMouseTracking(true);
     setWordWrap(false);
     setTextElideMode(Qt::TextElideMode::ElideRight);
+
+    m_prefetch_timer->setSingleShot(true);
+    m_prefetch_timer->setInterval(kPrefetchDelayMs);
+    connect(m_prefetch_timer, &QTimer::timeout, this,
+            &TasksView::prefetchVisibleRows);
+    connect(verticalScrollBar(), &QScrollBar::valueChanged, m_prefetch_timer,
+            qOverload<>(&QTimer::start));
+}
+
+void TasksView::setModel(QAbstractItemModel *model)
+{
+    QTableView::setModel(model);
+    auto *tasks_model = qobject_cast<TasksModel *>(model);
+    if (!tasks_model) {
+        return;
+    }
+    const auto schedule = qOverload<>(&QTimer::start);
+    connect(tasks_model, &TasksModel::detailsInvalidated, m_prefetch_timer,
+            schedule);
+    connect(tasks_model, &QAbstractItemModel::rowsInserted, m_prefetch_timer,
+            schedule);
+    connect(tasks_model, &QAbstractItemModel::rowsRemoved, m_prefetch_timer,
+            schedule);
+    connect(tasks_model, &QAbstractItemModel::rowsMoved, m_prefetch_timer,
+            schedule);
+    connect(tasks_model, &QAbstractItemModel::modelReset, m_prefetch_timer,
+            schedule);
+}
+
+void TasksView::resizeEvent(QResizeEvent *event)
+{
+    QTableView::resizeEvent(event);
+    m_prefetch_timer->start();
+}
+
+void TasksView::prefetchVisibleRows()
+{
+    auto *tasks_model = qobject_cast<TasksModel *>(model());
+    if (!tasks_model || tasks_model->rowCount() == 0) {
+        return;
+    }
+    const int first = std::max(0, rowAt(0));
+    int last = rowAt(viewport()->height() - 1);
+    if (last < 0) {
+        last = tasks_model->rowCount() - 1;
+    }
+    tasks_model->prefetchDetails(first, last);
 }
 
 void TasksView::mousePressEvent(QMouseEvent *event)
@@ -90,10 +150,13 @@ QString TasksView::anchorAt(const QPoint &pos) const
             qobject_cast<TaskDescriptionDelegate *>(delegate);
 
         if (task_delegate) {
-            auto item_rect = visualRect(index);
-            auto relative_click_position = pos - item_rect.topLeft();
+            QStyleOptionViewItem option;
+            option.rect = visualRect(index);
+            option.font = font();
+            auto relative_click_position = pos - option.rect.topLeft();
             auto markdown = model()->data(index, Qt::DisplayRole).toString();
-            return task_delegate->anchorAt(markdown, relative_click_position);
+            return task_delegate->anchorAt(markdown, option,
+                                           relative_click_position);
         }
     }
 
@@ -1,9 +1,12 @@
 #ifndef TASKSVIEW_HPP
 #define TASKSVIEW_HPP
 
+#include <QAbstractItemModel>
 #include <QMouseEvent>
+#include <QResizeEvent>
 #include <QString>
 #include <QTableView>
+#include <QTimer>
 
 class TasksView : public QTableView {
     Q_OBJECT
@@ -12,10 +15,13 @@ class TasksView : public QTableView {
     explicit TasksView(QWidget *parent = nullptr);
     ~TasksView() = default;
 
+    void setModel(QAbstractItemModel *model) override;
+
   protected:
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
 
   signals:
     void pushProjectFilter(const QString &);
@@ -25,10 +31,14 @@ class TasksView : public QTableView {
 
   private:
     QString anchorAt(const QPoint &pos) const;
+    /// @brief Asks model to load details of the visible rows.
+    void prefetchVisibleRows();
 
   private:
     QString m_mouse_press_anchor;
     QString m_last_hovered_anchor;
+    /// @brief Coalesces scrolling and model changes into single prefetch.
+    QTimer *m_prefetch_timer;
 };
 
 #endif // TASKSVIEW_HPP
@@ -1,6 +1,7 @@
 #include "taskwarrior.hpp"
 
 #include <QDebug>
+#include <QFuture>
 #include <QList>
 #include <QProcess>
 #include <QString>
@@ -8,18 +9,25 @@
 #include <QVariant>
 #include <QVector>
 
+#include "allatoncekeywordsfinder.hpp"
+#include "batch_tasks_writer.hpp"
 #include "configmanager.hpp"
 #include "date_time_parser.hpp"
-#include "filteredtaskslistreader.hpp"
+#include "delta_tasks_list_reader.hpp"
+#include "direct_storage_reader.hpp"
 #include "recurring_task_template.hpp"
 #include "task.hpp"
+#include "tasks_filter_index.hpp"
+#include "tasks_snapshot.hpp"
 #include "taskwarriorexecutor.hpp"
 #include "undo_tracker.hpp"
 
 #include <exception>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <tuple>
 #include <utility>
 
 Taskwarrior::Taskwarrior()
@@ -27,6 +35,7 @@ Taskwarrior::Taskwarrior()
     , m_actions_counter(nullptr)
     , m_filter({})
 {
+    m_writer_pool.setMaxThreadCount(1);
 }
 
 Taskwarrior::~Taskwarrior() = default;
@@ -38,6 +47,18 @@ bool Taskwarrior::init()
         m_executor = std::make_shared<TaskWarriorExecutor>(binary);
         m_actions_counter = std::make_unique<UndoTracker>(m_executor);
         m_actions_counter->startTracking();
+        // Readers run in background, so they see setting copied here by GUI
+        // thread instead of reading ConfigManager.
+        m_read_storage_directly =
+            ConfigManager::config().get(ConfigManager::ReadStorageDirectly);
+        QObject::connect(
+            &ConfigManager::config().notifier(), &ConfigEvents::settingsChanged,
+            m_actions_counter.get(), [this]() {
+                m_read_storage_directly = ConfigManager::config().get(
+                    ConfigManager::ReadStorageDirectly);
+                // User may have edited taskrc meanwhile too.
+                m_search_case_sensitivity.reset();
+            });
         return true;
     } catch (std::exception &e) {
         std::cerr << e.what() << std::endl;
@@ -45,37 +66,58 @@ bool Taskwarrior::init()
     return false;
 }
 
-bool Taskwarrior::addTask(DetailedTaskInfo &task)
+QFuture<bool> Taskwarrior::addTask(DetailedTaskInfo task)
 {
     return execCommandAndAccountUndo(
-        [this, &task]() { return task.execAddNewTask(*m_executor); });
+        [task = std::move(task)](const TaskWarriorExecutor &executor) mutable {
+            return task.execAddNewTask(executor);
+        });
 }
 
-bool Taskwarrior::startTasks(const QList<DetailedTaskInfo> &tasks)
+QFuture<bool> Taskwarrior::startTasks(const QList<DetailedTaskInfo> &tasks)
 {
-    return execCommandAndAccountUndo([this, &tasks]() {
-        return BatchTasksManager(tasks).execStartTask(*m_executor);
-    });
+    return execCommandAndAccountUndo(
+        [manager = BatchTasksManager(tasks)](
+            const TaskWarriorExecutor &executor) {
+            return manager.execStartTask(executor);
+        });
 }
 
-bool Taskwarrior::stopTasks(const QList<DetailedTaskInfo> &tasks)
+QFuture<bool> Taskwarrior::stopTasks(const QList<DetailedTaskInfo> &tasks)
 {
-    return execCommandAndAccountUndo([this, &tasks]() {
-        return BatchTasksManager(tasks).execStopTask(*m_executor);
-    });
+    return execCommandAndAccountUndo(
+        [manager = BatchTasksManager(tasks)](
+            const TaskWarriorExecutor &executor) {
+            return manager.execStopTask(executor);
+        });
 }
 
-bool Taskwarrior::editTask(DetailedTaskInfo &task)
+QFuture<bool> Taskwarrior::editTask(DetailedTaskInfo task)
 {
     return execCommandAndAccountUndo(
-        [this, &task]() { return task.execModifyExisting(*m_executor); });
+        [task = std::move(task)](const TaskWarriorExecutor &executor) mutable {
+            return task.execModifyExisting(executor);
+        });
 }
 
-bool Taskwarrior::setPriority(const QString &id, DetailedTaskInfo::Priority p)
+QFuture<bool> Taskwarrior::setPriority(const QString &id,
+                                       DetailedTaskInfo::Priority p)
 {
     DetailedTaskInfo task(id);
-    task.priority = p;
-    return editTask(task);
+    task.set(task.priority, p);
+    return editTask(std::move(task));
+}
+
+QFuture<bool> Taskwarrior::writeTasks(QList<DetailedTaskInfo> tasks)
+{
+    BatchTasksWriter writer(std::move(tasks));
+    const auto undoSteps = writer.undoSteps(
+        m_executor ? m_executor->getTaskVersion() : QString());
+    return execCommandAndAccountUndo(
+        [writer = std::move(writer)](const TaskWarriorExecutor &executor) {
+            return writer.exec(executor);
+        },
+        undoSteps);
 }
 
 std::optional<DetailedTaskInfo> Taskwarrior::getTask(const QString &id)
@@ -87,55 +129,65 @@ std::optional<DetailedTaskInfo> Taskwarrior::getTask(const QString &id)
     return std::nullopt;
 }
 
-bool Taskwarrior::deleteTask(const QString &id)
+QFuture<bool> Taskwarrior::deleteTask(const QString &id)
 {
-    return execCommandAndAccountUndo([this, &id]() {
-        return BatchTasksManager({ id }).execDeleteTask(*m_executor);
-    });
+    return deleteTask(QStringList{ id });
 }
 
-bool Taskwarrior::deleteTask(const QStringList &ids)
+QFuture<bool> Taskwarrior::deleteTask(const QStringList &ids)
 {
-    return execCommandAndAccountUndo([this, &ids]() {
-        return BatchTasksManager(ids).execDeleteTask(*m_executor);
-    });
+    return execCommandAndAccountUndo(
+        [manager = BatchTasksManager(ids)](
+            const TaskWarriorExecutor &executor) {
+            return manager.execDeleteTask(executor);
+        });
 }
 
-bool Taskwarrior::setTaskDone(const QString &id)
+QFuture<bool> Taskwarrior::setTaskDone(const QString &id)
 {
-    return execCommandAndAccountUndo([this, &id]() {
-        return BatchTasksManager({ id }).execDoneTask(*m_executor);
-    });
+    return setTaskDone(QStringList{ id });
 }
 
-bool Taskwarrior::setTaskDone(const QStringList &ids)
+QFuture<bool> Taskwarrior::setTaskDone(const QStringList &ids)
 {
-    return execCommandAndAccountUndo([this, &ids]() {
-        return BatchTasksManager(ids).execDoneTask(*m_executor);
-    });
+    return execCommandAndAccountUndo(
+        [manager = BatchTasksManager(ids)](
+            const TaskWarriorExecutor &executor) {
+            return manager.execDoneTask(executor);
+        });
 }
 
-bool Taskwarrior::waitTask(const QString &id, const QDateTime &datetime)
+QFuture<bool> Taskwarrior::waitTask(const QString &id,
+                                    const QDateTime &datetime)
 {
-    return execCommandAndAccountUndo([&]() {
-        return BatchTasksManager({ id }).execWaitTask(datetime, *m_executor);
-    });
+    return waitTask(QStringList{ id }, datetime);
 }
 
-bool Taskwarrior::waitTask(const QStringList &ids, const QDateTime &datetime)
+QFuture<bool> Taskwarrior::waitTask(const QStringList &ids,
+                                    const QDateTime &datetime)
 {
-    return execCommandAndAccountUndo([&]() {
-        return BatchTasksManager(ids).execWaitTask(datetime, *m_executor);
-    });
+    return execCommandAndAccountUndo(
+        [manager = BatchTasksManager(ids),
+         datetime](const TaskWarriorExecutor &executor) {
+            return manager.execWaitTask(datetime, executor);
+        });
 }
 
 std::optional<QList<DetailedTaskInfo>> Taskwarrior::getUrgencySortedTasks()
 {
-    FilteredTasksListReader retriever(m_filter);
-    if (m_executor && retriever.readUrgencySortedTaskList(*m_executor)) {
-        return std::move(retriever.tasks);
+    // User's filter is applied in memory by filterTasks(), so the kept list
+    // of the delta reader stays valid when filter changes.
+    static const AllAtOnceKeywordsFinder filter(QStringList{});
+    const std::lock_guard lock(m_reading_mutex);
+    if (const auto *reader = getDirectReader()) {
+        if (auto tasks = reader->readUrgencySortedTasks(filter)) {
+            return tasks;
+        }
     }
-    return std::nullopt;
+    if (!m_executor) {
+        return std::nullopt;
+    }
+    return m_delta_reader.read(*m_executor, filter);
 }
 
 std::optional<QList<RecurringTaskTemplate>>
@@ -144,22 +196,141 @@ Taskwarrior::getRecurringTasks() const
     if (!m_executor) {
         return std::nullopt;
     }
+    const std::lock_guard lock(m_reading_mutex);
+    if (const auto *reader = getDirectReader()) {
+        if (auto templates = reader->readRecurringTemplates()) {
+            return templates;
+        }
+    }
     return RecurringTaskTemplate::readAll(*m_executor);
 }
 
-bool Taskwarrior::undoTask() { return m_actions_counter->undo(); }
+const DirectStorageReader *Taskwarrior::getDirectReader() const
+{
+    if (!m_read_storage_directly) {
+        m_direct_reader.reset();
+        m_direct_reader_detected = false;
+        return nullptr;
+    }
+    if (!m_direct_reader_detected && m_executor) {
+        m_direct_reader = DirectStorageReader::create(*m_executor);
+        m_direct_reader_detected = true;
+    }
+    return m_direct_reader.get();
+}
+
+bool Taskwarrior::undoTask()
+{
+    const bool res = m_actions_counter->undo();
+    // Undo restores old modification time, so delta would not see it.
+    const std::lock_guard lock(m_reading_mutex);
+    m_delta_reader.reset();
+    return res;
+}
 
 bool Taskwarrior::applyFilter(QStringList user_keywords)
 {
+    // Fuzzy search is not known to `task`, it ranks rows of any filter.
+    auto fuzzy_text = TasksFilterQuery::takeFuzzyText(user_keywords);
+    // Common keywords are evaluated in memory by each list, without `task`.
+    if (auto query = TasksFilterQuery::parse(user_keywords,
+                                             searchCaseSensitivity())) {
+        const std::lock_guard lock(m_filter_mutex);
+        m_local_filter = std::move(query);
+        m_filter = AllAtOnceKeywordsFinder({});
+        m_fuzzy_text = std::move(fuzzy_text);
+        return true;
+    }
     if (!m_executor) {
         return false;
     }
-    const bool is_empty = user_keywords.empty();
-    m_filter = AllAtOnceKeywordsFinder(std::move(user_keywords));
-    if (is_empty) {
+    AllAtOnceKeywordsFinder filter(std::move(user_keywords));
+    // Keywords are resolved to IDs before filter is published to readers.
+    const bool applied = filter.readIds(*m_executor);
+    const std::lock_guard lock(m_filter_mutex);
+    m_local_filter.reset();
+    m_filter = std::move(filter);
+    m_fuzzy_text = std::move(fuzzy_text);
+    return applied;
+}
+
+Qt::CaseSensitivity Taskwarrior::searchCaseSensitivity()
+{
+    if (m_search_case_sensitivity) {
+        return *m_search_case_sensitivity;
+    }
+    if (!m_executor) {
+        return Qt::CaseSensitive;
+    }
+    const auto res = m_executor->execTaskProgramWithDefaults(
+        { "_get", "rc.search.case.sensitive" });
+    if (!res || res.getStdout().isEmpty()) {
+        return Qt::CaseSensitive;
+    }
+    static const QStringList kFalse = { "no", "off", "0", "false", "n" };
+    m_search_case_sensitivity =
+        kFalse.contains(res.getStdout().first().trimmed(), Qt::CaseInsensitive)
+            ? Qt::CaseInsensitive
+            : Qt::CaseSensitive;
+    return *m_search_case_sensitivity;
+}
+
+bool Taskwarrior::isFiltered() const
+{
+    const std::lock_guard lock(m_filter_mutex);
+    if (!m_fuzzy_text.isEmpty()) {
         return true;
     }
-    return m_filter.readIds(*m_executor);
+    if (m_local_filter) {
+        return !m_local_filter->isEmpty();
+    }
+    return m_filter.getIds().has_value();
+}
+
+bool Taskwarrior::isFilteredLocally() const
+{
+    const std::lock_guard lock(m_filter_mutex);
+    return m_local_filter && !m_local_filter->isEmpty();
+}
+
+bool Taskwarrior::isSearchedFuzzy() const
+{
+    const std::lock_guard lock(m_filter_mutex);
+    return !m_fuzzy_text.isEmpty();
+}
+
+QString Taskwarrior::fuzzySearchText() const
+{
+    const std::lock_guard lock(m_filter_mutex);
+    return m_fuzzy_text;
+}
+
+QList<DetailedTaskInfo>
+Taskwarrior::filterTasks(const TasksSnapshot &snapshot) const
+{
+    const auto [local, ids, fuzzy_text] = [this]() {
+        const std::lock_guard lock(m_filter_mutex);
+        return std::make_tuple(m_local_filter, m_filter.getIds(),
+                               m_fuzzy_text);
+    }();
+    const auto filtered = [&snapshot, &local = local, &ids = ids]() {
+        if (local) {
+            if (local->isEmpty()) {
+                return snapshot.pending;
+            }
+            return snapshot.selectRows(snapshot.filterIndex().select(*local));
+        }
+        if (!ids.has_value()) {
+            return snapshot.pending;
+        }
+        return TasksSnapshot::selectIds(
+            snapshot.pending, AllAtOnceKeywordsFinder::parseIdRanges(*ids));
+    }();
+    if (fuzzy_text.isEmpty()) {
+        return filtered;
+    }
+    return TasksSnapshot::rankByHits(
+        filtered, snapshot.trigramIndex().search(fuzzy_text));
 }
 
 int Taskwarrior::directCmd(const QString &cmd)
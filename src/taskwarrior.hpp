@@ -3,19 +3,30 @@
 
 #include <QByteArray>
 #include <QDateTime>
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QList>
 #include <QString>
 #include <QStringList>
+#include <QThreadPool>
 #include <QVariant>
+#include <QtConcurrent> //NOLINT
 
 #include "allatoncekeywordsfinder.hpp"
+#include "delta_tasks_list_reader.hpp"
+#include "direct_storage_reader.hpp"
 #include "recurring_task_template.hpp"
 #include "task.hpp"
+#include "tasks_filter_index.hpp"
+#include "tasks_snapshot.hpp"
 #include "taskwarriorexecutor.hpp"
 #include "undo_tracker.hpp"
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <stdexcept>
 
@@ -52,45 +63,135 @@ class Taskwarrior {
         return {};
     }
 
-    bool addTask(DetailedTaskInfo &task);
-    bool startTasks(const QList<DetailedTaskInfo> &tasks);
-    bool stopTasks(const QList<DetailedTaskInfo> &tasks);
-    bool editTask(DetailedTaskInfo &task);
-    bool setPriority(const QString &id, DetailedTaskInfo::Priority);
+    /// @note Modifications are queued and executed one by one in background,
+    /// in the order of calls. Result of the future is true if `task`
+    /// succeeded. Tasks should be passed by UUIDs, IDs could be renumbered
+    /// by previous command before queued one runs.
+    QFuture<bool> addTask(DetailedTaskInfo task);
+    QFuture<bool> startTasks(const QList<DetailedTaskInfo> &tasks);
+    QFuture<bool> stopTasks(const QList<DetailedTaskInfo> &tasks);
+    QFuture<bool> editTask(DetailedTaskInfo task);
+    QFuture<bool> setPriority(const QString &id, DetailedTaskInfo::Priority);
+    QFuture<bool> deleteTask(const QString &id);
+    QFuture<bool> deleteTask(const QStringList &ids);
+    QFuture<bool> setTaskDone(const QString &id);
+    QFuture<bool> setTaskDone(const QStringList &ids);
+    QFuture<bool> waitTask(const QString &id, const QDateTime &datetime);
+    QFuture<bool> waitTask(const QStringList &ids, const QDateTime &datetime);
+    /// @brief Writes modified properties of all @p tasks by single
+    /// `task import` (see BatchTasksWriter), tasks without UUID are created.
+    QFuture<bool> writeTasks(QList<DetailedTaskInfo> tasks);
+
     [[nodiscard]] std::optional<DetailedTaskInfo> getTask(const QString &id);
+    /// @returns all pending tasks, user's filter is not applied.
+    /// @note Lists can be read from any thread, reads are serialized.
     [[nodiscard]] std::optional<QList<DetailedTaskInfo>>
     getUrgencySortedTasks();
     [[nodiscard]] std::optional<QList<RecurringTaskTemplate>>
     getRecurringTasks() const;
-    bool deleteTask(const QString &id);
-    bool deleteTask(const QStringList &ids);
-    bool setTaskDone(const QString &id);
-    bool setTaskDone(const QStringList &ids);
-    bool waitTask(const QString &id, const QDateTime &datetime);
-    bool waitTask(const QStringList &ids, const QDateTime &datetime);
+    /// @note Undo is not available while modifications are queued.
     bool undoTask();
 
     bool applyFilter(QStringList user_keywords);
 
+    /// @returns tasks of the @p snapshot found by the last applyFilter().
+    /// Keywords supported by TasksFilterQuery are evaluated in memory, others
+    /// are resolved to IDs by `task ids` when filter is applied.
+    [[nodiscard]]
+    QList<DetailedTaskInfo> filterTasks(const TasksSnapshot &snapshot) const;
+
+    /// @returns true if tasks list is limited by user's keywords.
+    [[nodiscard]]
+    bool isFiltered() const;
+
+    /// @returns true if filter is evaluated by TasksFilterIndex, so lists
+    /// should have index prepared.
+    [[nodiscard]]
+    bool isFilteredLocally() const;
+
+    /// @returns true if filter has fuzzy search keywords, so lists should
+    /// have DescriptionTrigramIndex prepared.
+    [[nodiscard]]
+    bool isSearchedFuzzy() const;
+
+    /// @returns text of the fuzzy search keywords of the filter, empty if
+    /// there are none.
+    [[nodiscard]]
+    QString fuzzySearchText() const;
+
     int directCmd(const QString &cmd);
 
   private:
     bool getActiveIds(QStringList &result);
 
+    /// @returns reader of the storage if it is enabled in config and storage
+    /// format is supported, otherwise nullptr.
+    /// @note Must be called with m_reading_mutex locked.
+    [[nodiscard]]
+    const DirectStorageReader *getDirectReader() const;
+
+    /// @brief Queues @p callable to the writer thread. Undo is accounted in
+    /// GUI thread when it finishes.
+    /// @tparam taCallable - Callable which accepts `const TaskWarriorExecutor
+    /// &` and returns true on success.
+    /// @param undo_steps - undo transactions which @p callable records.
     template <typename taCallable>
-    bool execCommandAndAccountUndo(const taCallable &callable)
+    QFuture<bool> execCommandAndAccountUndo(taCallable callable,
+                                            std::uint64_t undo_steps = 1u)
     {
-        if (m_executor && callable()) {
-            m_actions_counter->addUndo();
-            return true;
+        if (!m_executor || !m_actions_counter) {
+            return QtConcurrent::run(&m_writer_pool, []() { return false; });
         }
-        return false;
+        auto *tracker = m_actions_counter.get();
+        tracker->actionStarted(undo_steps);
+        auto future = QtConcurrent::run(
+            &m_writer_pool,
+            [executor = m_executor, callable = std::move(callable)]() mutable {
+                // This is non-GUI thread.
+                return callable(*executor);
+            });
+        auto *watcher = new QFutureWatcher<bool>(tracker);
+        QObject::connect(watcher, &QFutureWatcher<bool>::finished, tracker,
+                         [tracker, watcher, undo_steps]() {
+                             // This is GUI thread.
+                             watcher->deleteLater();
+                             tracker->actionFinished(watcher->result(),
+                                                     undo_steps);
+                         });
+        watcher->setFuture(future);
+        return future;
     }
 
   private:
+    /// @returns how `task` compares words of the filter.
+    [[nodiscard]]
+    Qt::CaseSensitivity searchCaseSensitivity();
+
     std::shared_ptr<TaskWarriorExecutor> m_executor;
     std::unique_ptr<UndoTracker> m_actions_counter;
+    // Filter is set by GUI thread, while lists are read in background.
+    mutable std::mutex m_filter_mutex;
     AllAtOnceKeywordsFinder m_filter;
+    // Used instead of m_filter if keywords are supported.
+    std::optional<TasksFilterQuery> m_local_filter;
+    // Words of `~word` keywords, which rank rows by DescriptionTrigramIndex.
+    QString m_fuzzy_text;
+    // `rc.search.case.sensitive`, it is read by GUI thread on the 1st local
+    // filter.
+    std::optional<Qt::CaseSensitivity> m_search_case_sensitivity;
+    // Guards readers below, which keep state between reads.
+    mutable std::mutex m_reading_mutex;
+    // Keeps the last list, so only modified tasks are exported on refresh.
+    DeltaTasksListReader m_delta_reader;
+    // Detection requires a `task` call, so it is done once on the 1st read
+    // after direct reading was enabled.
+    mutable std::unique_ptr<DirectStorageReader> m_direct_reader;
+    // Copy of ConfigManager::ReadStorageDirectly, updated by GUI thread.
+    std::atomic<bool> m_read_storage_directly{ false };
+    mutable bool m_direct_reader_detected{ false };
+    // Single thread, so modifications are done one by one. It is destroyed
+    // 1st and waits for queued modifications.
+    QThreadPool m_writer_pool;
 };
 
 #endif // TASKWARRIOR_HPP
@@ -2,28 +2,82 @@
 
 #include "date_time_parser.hpp"
 
+#include <QByteArray>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QProcess>
 #include <QRegularExpression>
 #include <QString>
 #include <QStringList>
 #include <QStringLiteral>
 
+#include <algorithm>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 
 namespace
 {
+constexpr int kStartDelayMs = 1000;
+constexpr int kFinishDelayMs = 30000;
+/// @brief How often cancellable execution checks its flag.
+constexpr int kCancelCheckPeriodMs = 20;
+
+[[nodiscard]]
+bool isCancelled(const TaskWarriorExecutor::CancelFlag &cancel)
+{
+    return cancel && cancel->load();
+}
+
+[[nodiscard]]
+TaskWarriorExecutor::TExecResult cancelledResult()
+{
+    return { TaskWarriorExecutor::TExecError{ -1, "Cancelled." } };
+}
+
+/// @brief Waits until @p proc finishes, kills it if @p cancel was set.
+/// @returns std::nullopt if process finished or error to return.
+[[nodiscard]]
+std::optional<TaskWarriorExecutor::TExecResult>
+waitForFinished(QProcess &proc, const TaskWarriorExecutor::CancelFlag &cancel)
+{
+    if (!cancel) {
+        if (proc.waitForFinished(kFinishDelayMs)) {
+            return std::nullopt;
+        }
+    } else {
+        QElapsedTimer elapsed;
+        elapsed.start();
+        while (!proc.waitForFinished(kCancelCheckPeriodMs)) {
+            if (proc.state() == QProcess::NotRunning) {
+                return std::nullopt;
+            }
+            if (isCancelled(cancel)) {
+                proc.kill();
+                proc.waitForFinished(kStartDelayMs);
+                return cancelledResult();
+            }
+            if (elapsed.hasExpired(kFinishDelayMs)) {
+                break;
+            }
+        }
+        if (proc.state() == QProcess::NotRunning) {
+            return std::nullopt;
+        }
+    }
+    return TaskWarriorExecutor::TExecResult{ TaskWarriorExecutor::TExecError{
+        -1, QString("Execution timeout after %1ms.").arg(kFinishDelayMs) } };
+}
+
 /// @brief Executes @p binary and @returns TExecResult.
 /// @note Empty lines are removed from result.
 [[nodiscard]]
-TaskWarriorExecutor::TExecResult execProgram(const QString &binary,
-                                             const QStringList &all_params)
+TaskWarriorExecutor::TExecResult
+execProgram(const QString &binary, const QStringList &all_params,
+            const TaskWarriorExecutor::CancelFlag &cancel)
 {
     constexpr auto kSplitBehaviour = DateTimeParser::kSplitSkipEmptyParts;
-    constexpr int kStartDelayMs = 1000;
-    constexpr int kFinishDelayMs = 30000;
 
     // std::cout << "PARAMS:[" << all_params.join(" ").toStdString() << "]"
     //           << std::endl;
@@ -35,10 +89,8 @@ TaskWarriorExecutor::TExecResult execProgram(const QString &binary,
             -1, QString("Failed to start: [ %1 ].").arg(proc.errorString()) } };
     }
 
-    if (!proc.waitForFinished(kFinishDelayMs)) {
-        return { TaskWarriorExecutor::TExecError{
-            -1,
-            QString("Execution timeout after %1ms.").arg(kFinishDelayMs) } };
+    if (auto error = waitForFinished(proc, cancel)) {
+        return std::move(*error);
     }
 
     const int exitCode = proc.exitCode();
@@ -54,6 +106,76 @@ TaskWarriorExecutor::TExecResult execProgram(const QString &binary,
             .split(kSplitter, kSplitBehaviour)
     };
 }
+
+/// @brief Executes @p binary and passes stdout to @p receiver as soon as it
+/// arrives.
+/// @returns TExecResult with empty stdout.
+[[nodiscard]]
+TaskWarriorExecutor::TExecResult
+execProgramStreaming(const QString &binary, const QStringList &all_params,
+                     const TaskWarriorExecutor::StdoutChunkReceiver &receiver,
+                     const TaskWarriorExecutor::CancelFlag &cancel)
+{
+    QProcess proc;
+    proc.setProcessChannelMode(QProcess::SeparateChannels);
+    proc.start(binary, all_params);
+    if (!proc.waitForStarted(kStartDelayMs)) {
+        return { TaskWarriorExecutor::TExecError{
+            -1, QString("Failed to start: [ %1 ].").arg(proc.errorString()) } };
+    }
+
+    // Warnings are drained as they come too, so `task` never blocks on full
+    // stderr pipe while we wait for stdout.
+    QByteArray errors;
+    const auto passAvailable = [&proc, &receiver, &errors]() {
+        errors += proc.readAllStandardError();
+        const QByteArray chunk = proc.readAllStandardOutput();
+        if (!chunk.isEmpty()) {
+            receiver(chunk);
+        }
+    };
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    while (proc.state() != QProcess::NotRunning) {
+        if (isCancelled(cancel)) {
+            proc.kill();
+            proc.waitForFinished(kStartDelayMs);
+            return cancelledResult();
+        }
+        const auto left = kFinishDelayMs - elapsed.elapsed();
+        if (left <= 0) {
+            proc.kill();
+            proc.waitForFinished(kStartDelayMs);
+            return { TaskWarriorExecutor::TExecError{
+                -1, QString("Execution timeout after %1ms.")
+                        .arg(kFinishDelayMs) } };
+        }
+        // It returns false when process finished too, loop condition
+        // handles it.
+        proc.waitForReadyRead(
+            cancel ? std::min<int>(kCancelCheckPeriodMs, static_cast<int>(left))
+                   : static_cast<int>(left));
+        passAvailable();
+    }
+    passAvailable();
+
+    const int exitCode = proc.exitCode();
+    if (proc.exitStatus() != QProcess::NormalExit || exitCode != 0) {
+        return { TaskWarriorExecutor::TExecError{
+            exitCode != 0 ? exitCode : -1, QString::fromLocal8Bit(errors) } };
+    }
+    return TaskWarriorExecutor::TExecResult{ QStringList{} };
+}
+
+/// @returns @p all_params prepended by parameters we need for each call.
+QStringList withDefaultParams(const QStringList &all_params)
+{
+    QStringList args{ "rc.gc=off", "rc.confirmation=off", "rc.bulk=0",
+                      "rc.defaultwidth=0" };
+    args << all_params;
+    return args;
+}
 } // namespace
 
 TaskWarriorExecutor::TaskWarriorExecutor(QString full_path_to_binary)
@@ -89,11 +211,16 @@ const QString &TaskWarriorExecutor::getTaskVersion() const
     return m_task_version;
 }
 
+void TaskWarriorExecutor::setCancelFlag(CancelFlag flag)
+{
+    m_cancel_flag = std::move(flag);
+}
+
 TaskWarriorExecutor::TExecResult
 TaskWarriorExecutor::execTaskProgram(const QStringList &all_params) const
 {
     qDebug() << m_full_path_to_binary << " " << all_params;
-    auto res = execProgram(m_full_path_to_binary, all_params);
+    auto res = execProgram(m_full_path_to_binary, all_params, m_cancel_flag);
     qDebug() << res;
     if (!res) {
         std::cerr << "Error executing " << m_full_path_to_binary.toStdString()
@@ -108,8 +235,21 @@ TaskWarriorExecutor::TExecResult
 TaskWarriorExecutor::execTaskProgramWithDefaults(
     const QStringList &all_params) const
 {
-    QStringList args{ "rc.gc=off", "rc.confirmation=off", "rc.bulk=0",
-                      "rc.defaultwidth=0" };
-    args << all_params;
-    return execTaskProgram(args);
+    return execTaskProgram(withDefaultParams(all_params));
+}
+
+TaskWarriorExecutor::TExecResult TaskWarriorExecutor::execTaskProgramStreaming(
+    const QStringList &all_params, const StdoutChunkReceiver &receiver) const
+{
+    const auto args = withDefaultParams(all_params);
+    qDebug() << m_full_path_to_binary << " " << args;
+    auto res = execProgramStreaming(m_full_path_to_binary, args, receiver,
+                                    m_cancel_flag);
+    if (!res) {
+        std::cerr << "Error executing " << m_full_path_to_binary.toStdString()
+                  << "\n";
+        std::cerr << "Code: " << res.getError().code << ". "
+                  << res.getError().message.toStdString() << std::endl;
+    }
+    return res;
 }
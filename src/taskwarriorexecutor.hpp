@@ -1,8 +1,12 @@
 #pragma once
 
+#include <QByteArray>
 #include <QString>
 #include <QStringList>
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <variant>
 
 /// @brief This class provides generic interface to launch `task`command.
@@ -55,6 +59,14 @@ class TaskWarriorExecutor {
         }
     };
 
+    /// @brief Receives parts of the stdout as soon as those were read from
+    /// the running process.
+    using StdoutChunkReceiver = std::function<void(const QByteArray &)>;
+
+    /// @brief Once it is set to true, running `task` is killed and execution
+    /// fails. It can be set from any thread.
+    using CancelFlag = std::shared_ptr<const std::atomic<bool>>;
+
     TaskWarriorExecutor() = delete;
 
     /// @brief Constructs object with given path.
@@ -75,10 +87,22 @@ class TaskWarriorExecutor {
     TExecResult
     execTaskProgramWithDefaults(const QStringList &all_params) const;
 
+    /// @brief Executes configured task with defaults required parameters and
+    /// passes stdout to @p receiver chunk by chunk while `task` is still
+    /// running, so caller can parse it in parallel with the output generation.
+    /// @returns TExecResult, its stdout is always empty.
+    [[nodiscard]]
+    TExecResult
+    execTaskProgramStreaming(const QStringList &all_params,
+                             const StdoutChunkReceiver &receiver) const;
+
     /// @returns `task` version detected.
     [[nodiscard]]
     const QString &getTaskVersion() const;
 
+    /// @brief Makes all following executions cancellable by @p flag.
+    void setCancelFlag(CancelFlag flag);
+
   protected:
     /// @brief Executes configured "task" program and @returns TExecResult.
     [[nodiscard]]
@@ -87,4 +111,5 @@ class TaskWarriorExecutor {
   private:
     QString m_full_path_to_binary;
     QString m_task_version;
+    CancelFlag m_cancel_flag;
 };
@@ -1,12 +1,18 @@
 #include "taskwatcher.hpp"
 
 #include "configmanager.hpp"
+#include "data_files_watcher.hpp"
+#include "direct_storage_reader.hpp"
 #include "pereodic_async_executor.hpp"
+#include "poll_scheduler.hpp"
 #include "task.hpp"
 #include "taskwarriorexecutor.hpp"
 
+#include <QFuture>
+#include <QFutureWatcher>
 #include <QObject>
 #include <QString>
+#include <QtConcurrent> //NOLINT
 #include <qtmetamacros.h>
 
 #include <cassert>
@@ -23,6 +29,10 @@ using namespace std::chrono_literals;
 // TODO: add config settings in UI instead.
 constexpr std::chrono::milliseconds kCheckPeriod = 10s; // NOLINT
 
+/// @brief How often we check for new data if files are watched, just in case
+/// some notification was lost.
+constexpr std::chrono::milliseconds kFallbackCheckPeriod = 5min; // NOLINT
+
 } // namespace
 
 TaskWatcher::TaskWatcher(QObject *parent)
@@ -62,6 +72,48 @@ TaskWatcher::TaskWatcher(QObject *parent)
     m_pereodic_worker = createPereodicAsynExec(
         kCheckPeriod, std::move(threadBody), std::move(paramsForThread),
         std::move(receiverFromThread));
+    PollScheduler::instance().add(this, m_pereodic_worker.get(), kCheckPeriod);
+
+    setupFilesWatcher();
+}
+
+void TaskWatcher::setupFilesWatcher()
+{
+    using TLocation = std::optional<QString>;
+    auto *locationReader = new QFutureWatcher<TLocation>(this);
+    connect(locationReader, &QFutureWatcher<TLocation>::finished, this,
+            [this, locationReader]() {
+                // This is GUI thread.
+                locationReader->deleteLater();
+                const auto location = locationReader->result();
+                if (!location) {
+                    return;
+                }
+                m_files_watcher = new DataFilesWatcher(*location, this);
+                if (!m_files_watcher->isWatching()) {
+                    return;
+                }
+                // `task stat` is still used to confirm change and get undo
+                // count, but only when files were really changed.
+                connect(m_files_watcher,
+                        &DataFilesWatcher::dataFilesWereChanged, this,
+                        &TaskWatcher::checkNow);
+                PollScheduler::instance().setPeriod(m_pereodic_worker.get(),
+                                                    kFallbackCheckPeriod);
+            });
+    locationReader->setFuture(QtConcurrent::run(
+        [](QString pathToBinary) -> TLocation {
+            try {
+                // This is non-GUI thread.
+                return DirectStorageReader::readDataLocation(
+                    TaskWarriorExecutor(
+                        std::move(pathToBinary),
+                        TaskWarriorExecutor::TSkipBinaryValidation{}));
+            } catch (...) { // NOLINT
+            }
+            return std::nullopt;
+        },
+        ConfigManager::config().get(ConfigManager::TaskBin)));
 }
 
 void TaskWatcher::checkNow()
@@ -8,11 +8,12 @@
 #include <cstdint>
 #include <memory>
 
+#include "data_files_watcher.hpp"
 #include "pereodic_async_executor.hpp"
 #include "task.hpp"
 
-/// @brief This object polls TaskWarrior and fires signal when re-read data is
-/// needed.
+/// @brief This object watches TaskWarrior's data files and fires signal when
+/// re-read data is needed. If files cannot be watched, it polls `task stat`.
 /// @note It is initialized in untracking state. You must call checkNow() at
 /// least once.
 class TaskWatcher : public QObject {
@@ -28,8 +29,13 @@ class TaskWatcher : public QObject {
     void checkNow();
 
   private:
+    /// @brief Asks `task` for data location in background and starts
+    /// watching files there.
+    void setupFilesWatcher();
+
     TaskWarriorDbState m_latestDbState;
     std::unique_ptr<IPereodicExec> m_pereodic_worker;
+    DataFilesWatcher *m_files_watcher{ nullptr };
     QTimer delayedSignalSender;
 };
 
@@ -7,6 +7,8 @@
 #include <QAction>
 #include <QApplication>
 #include <QFont>
+#include <QGuiApplication>
+#include <QIcon>
 #include <QMenu>
 #include <QObject>
 #include <QPainter>
@@ -25,6 +27,44 @@ namespace
 constexpr int kRenderSize = 256;
 /// @brief Font size to use to draw emoji over icon.
 constexpr int kEmojiFontSize = static_cast<int>(kRenderSize * 0.55);
+/// @brief Key of the muted icon in cache, other ones are urgency levels.
+constexpr int kMutedIconKey = -1;
+
+/// @returns application icon with badge of @p urgency, or of the mute if
+/// notifications are @p muted.
+QIcon renderStatusIcon(StatusEmoji::EmojiUrgency urgency, bool muted)
+{
+    QPixmap pixmap(kRenderSize, kRenderSize);
+    pixmap.fill(Qt::transparent);
+    {
+        QPainter painter(&pixmap);
+        QSvgRenderer renderer(QStringLiteral(":/icons/qtask.svg"));
+        renderer.render(&painter);
+
+        // We need to update icon by emoji.
+        if (urgency > StatusEmoji::EmojiUrgency::Future || muted) {
+            painter.setRenderHint(QPainter::Antialiasing);
+            painter.setRenderHint(QPainter::TextAntialiasing);
+
+            QFont font = painter.font();
+            font.setPixelSize(kEmojiFontSize);
+            painter.setFont(font);
+
+            const QString emoji =
+                muted ? (StatusEmoji::hasEmoji() ? "🔇" : QString())
+                      : StatusEmoji::urgencyToEmoji(urgency);
+            if (!emoji.isEmpty()) { // Check if we got support for emoji
+                constexpr int badgeSize =
+                    static_cast<int>(kEmojiFontSize * 1.2);
+                constexpr int offset = kRenderSize - badgeSize;
+
+                const QRect badgeRect(offset, offset, badgeSize, badgeSize);
+                painter.drawText(badgeRect, Qt::AlignCenter, emoji);
+            }
+        }
+    } // painter.end() is called as out of scope
+    return QIcon(pixmap);
+}
 } // namespace
 
 using namespace ui;
@@ -73,39 +113,26 @@ void SystemTrayIcon::updateStatusIcon(StatusEmoji::EmojiUrgency urgency)
 {
     const bool muted =
         ConfigManager::config().get(ConfigManager::MuteNotifications);
-    QPixmap pixmap(kRenderSize, kRenderSize);
-    pixmap.fill(Qt::transparent);
-    setToolTip(tr("There are no urgent tasks."));
-    {
-        QPainter painter(&pixmap);
-        QSvgRenderer renderer(QStringLiteral(":/icons/qtask.svg"));
-        renderer.render(&painter);
-
-        // We need to update icon by emoji.
-        if (urgency > StatusEmoji::EmojiUrgency::Future || muted) {
-            painter.setRenderHint(QPainter::Antialiasing);
-            painter.setRenderHint(QPainter::TextAntialiasing);
-
-            QFont font = painter.font();
-            font.setPixelSize(kEmojiFontSize);
-            painter.setFont(font);
-
-            const QString emoji =
-                muted ? (StatusEmoji::hasEmoji() ? "🔇" : QString())
-                      : StatusEmoji::urgencyToEmoji(urgency);
-            if (!emoji.isEmpty()) { // Check if we got support for emoji
-                constexpr int badgeSize =
-                    static_cast<int>(kEmojiFontSize * 1.2);
-                constexpr int offset = kRenderSize - badgeSize;
-
-                const QRect badgeRect(offset, offset, badgeSize, badgeSize);
-                painter.drawText(badgeRect, Qt::AlignCenter, emoji);
-            }
-
-            setToolTip(muted ? tr("QTask - Notifications are muted.")
-                             : tr("There are task(s) to deal with."));
-        }
-    } // painter.end() is called as out of scope
-
-    setIcon(QIcon(pixmap));
+    const bool badged = urgency > StatusEmoji::EmojiUrgency::Future || muted;
+    if (!badged) {
+        setToolTip(tr("There are no urgent tasks."));
+    } else {
+        setToolTip(muted ? tr("QTask - Notifications are muted.")
+                         : tr("There are task(s) to deal with."));
+    }
+
+    // Badge is drawn by application font, icons are rendered again if it
+    // was changed.
+    if (icons_font_ != QGuiApplication::font()) {
+        icons_font_ = QGuiApplication::font();
+        icons_.clear();
+    }
+    // Levels without badge share the plain icon.
+    const auto level = badged ? urgency : StatusEmoji::EmojiUrgency::None;
+    const int key = muted ? kMutedIconKey : static_cast<int>(level);
+    auto it = icons_.find(key);
+    if (it == icons_.end()) {
+        it = icons_.insert(key, renderStatusIcon(urgency, muted));
+    }
+    setIcon(*it);
 }
@@ -4,6 +4,9 @@
 #include "task_emojies.hpp"
 
 #include <QAction>
+#include <QFont>
+#include <QHash>
+#include <QIcon>
 #include <QMenu>
 #include <QObject>
 #include <QSystemTrayIcon>
@@ -29,6 +32,10 @@ class SystemTrayIcon : public QSystemTrayIcon {
     // menu would expect one.
     std::unique_ptr<QMenu> tray_icon_menu_;
     QAction *mute_notifications_action_;
+    /// @brief Rendered icons by urgency level, so changes of the urgency do
+    /// not rasterize SVG again.
+    QHash<int, QIcon> icons_;
+    QFont icons_font_;
 };
 
 } // namespace ui
@@ -3,6 +3,7 @@
 #include "task.hpp"
 #include "taskwarriorexecutor.hpp"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <utility>
@@ -51,9 +52,30 @@ void UndoTracker::addUndo()
     sendSignalForUi();
 }
 
+void UndoTracker::actionStarted(const std::uint64_t steps)
+{
+    m_pending += steps;
+    sendSignalForUi();
+}
+
+void UndoTracker::actionFinished(const bool undoable,
+                                 const std::uint64_t steps)
+{
+    m_pending -= std::min(m_pending, steps);
+    if (undoable) {
+        m_counter += steps;
+        // Reading may already include this action, or may not.
+        if (m_base_value != kInvalidBaseState &&
+            m_latest_db_reading < m_base_value + m_counter) {
+            m_latest_db_reading = m_base_value + m_counter;
+        }
+    }
+    sendSignalForUi();
+}
+
 bool UndoTracker::undo()
 {
-    if (!m_executor || m_counter == 0) {
+    if (!m_executor || m_counter == 0 || m_pending > 0) {
         return false;
     }
 
@@ -70,7 +92,8 @@ bool UndoTracker::undo()
 
 void UndoTracker::sendSignalForUi()
 {
-    const bool isEnabled = isSyncedCounter() && m_counter > 0;
+    const bool isEnabled =
+        isSyncedCounter() && m_counter > 0 && m_pending == 0;
     emit undoAvail(isEnabled);
 }
 
@@ -85,7 +108,10 @@ bool UndoTracker::isSyncedCounter() const
     // The logic is simple: what we see in the DB (latest_db_reading) must
     // exactly match what we expect (base_value + our_local_changes).
     // If they differ, an external process has modified the Taskwarrior
-    // database.
+    // database. Queued actions may be already done in DB, so DB can be ahead
+    // by up to m_pending.
+    const auto expected = m_base_value + m_counter;
     return m_base_value != kInvalidBaseState &&
-           m_latest_db_reading == m_base_value + m_counter;
+           m_latest_db_reading >= expected &&
+           m_latest_db_reading <= expected + m_pending;
 }
@@ -41,6 +41,16 @@ class UndoTracker : public QObject {
     /// count.
     void addUndo();
 
+    /// @brief It should be called when undoable action was queued. Undo is not
+    /// available until all queued actions are finished.
+    /// @param steps - undo transactions which action records.
+    void actionStarted(std::uint64_t steps = 1u);
+
+    /// @brief It should be called when queued action finished.
+    /// @param undoable - true if action was successful, so undo count grew.
+    /// @param steps - the same value as was passed to actionStarted().
+    void actionFinished(bool undoable, std::uint64_t steps = 1u);
+
     /// @brief Executes UNDO operation DB IF we can.
     /// @returns true if undo was executed.
     bool undo();
@@ -63,6 +73,9 @@ class UndoTracker : public QObject {
     /// It is updated either by real DB readings or "optimistically" by our
     /// own addUndo/undo calls to prevent UI flicker during sync.
     std::uint64_t m_latest_db_reading;
+    /// @brief The number of undo steps of queued actions which are not
+    /// finished yet. DB may already contain any part of them.
+    std::uint64_t m_pending{ 0u };
 
     std::shared_ptr<TaskWarriorExecutor> m_executor;
 
@@ -0,0 +1,65 @@
+#include "urgency_glyph_cache.hpp"
+
+#include "task_emojies.hpp"
+
+#include <QColor>
+#include <QFont>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QPixmap>
+#include <QString>
+#include <QtMath>
+#include <QtMinMax>
+#include <qnamespace.h>
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace
+{
+/// @returns emoji of @p urgency, levels without one are replaced by em space,
+/// so ids stay aligned.
+[[nodiscard]]
+QString alignedEmoji(StatusEmoji::EmojiUrgency urgency)
+{
+    const auto emoji = StatusEmoji::urgencyToEmoji(urgency);
+    return emoji.isEmpty() ? QString::fromUtf8("\u2003") : emoji;
+}
+} // namespace
+
+const UrgencyGlyphCache::Glyph &
+UrgencyGlyphCache::glyph(StatusEmoji::EmojiUrgency urgency, const QFont &font,
+                         const QColor &color, qreal device_pixel_ratio)
+{
+    if (font != m_font || color != m_color ||
+        !qFuzzyCompare(device_pixel_ratio, m_device_pixel_ratio)) {
+        m_glyphs.fill(std::nullopt);
+        m_font = font;
+        m_color = color;
+        m_device_pixel_ratio = device_pixel_ratio;
+    }
+
+    auto &cached = m_glyphs.at(static_cast<std::size_t>(urgency));
+    if (cached) {
+        return *cached;
+    }
+
+    const auto text = alignedEmoji(urgency);
+    const QFontMetrics fm(font);
+    Glyph glyph;
+    glyph.width = fm.horizontalAdvance(text);
+    glyph.pixmap = QPixmap(qMax(1, qCeil(glyph.width * device_pixel_ratio)),
+                           qMax(1, qCeil(fm.height() * device_pixel_ratio)));
+    glyph.pixmap.setDevicePixelRatio(device_pixel_ratio);
+    glyph.pixmap.fill(Qt::transparent);
+    {
+        QPainter painter(&glyph.pixmap);
+        painter.setRenderHint(QPainter::TextAntialiasing);
+        painter.setFont(font);
+        painter.setPen(color);
+        painter.drawText(0, fm.ascent(), text);
+    }
+    cached = std::move(glyph);
+    return *cached;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "task_emojies.hpp"
+
+#include <QColor>
+#include <QFont>
+#include <QPixmap>
+
+#include <array>
+#include <cstddef>
+#include <optional>
+
+/// @brief Status emoji of each urgency level rendered for the current font,
+/// pen color and device pixel ratio, so rows blit pixmaps instead of shaping
+/// color emoji through font fallback on each paint. All are rendered again
+/// when any of those changes.
+class UrgencyGlyphCache {
+  public:
+    struct Glyph {
+        QPixmap pixmap;
+        /// @brief Width in device independent pixels.
+        int width{ 0 };
+    };
+
+    [[nodiscard]]
+    const Glyph &glyph(StatusEmoji::EmojiUrgency urgency, const QFont &font,
+                       const QColor &color, qreal device_pixel_ratio);
+
+  private:
+    static constexpr std::size_t kLevelsCount =
+        static_cast<std::size_t>(StatusEmoji::EmojiUrgency::Overdue) + 1u;
+
+    std::array<std::optional<Glyph>, kLevelsCount> m_glyphs;
+    QFont m_font;
+    QColor m_color;
+    qreal m_device_pixel_ratio{ 0.0 };
+};
@@ -0,0 +1,132 @@
+#include "async_task_loader.hpp"
+#include "qt_base_test.hpp"
+#include "task.hpp"
+#include "task_builder.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QSignalSpy>
+#include <QString>
+#include <QThread>
+#include <QThreadPool>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace Test
+{
+namespace
+{
+bool waitFor(const std::function<bool()> &condition)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!condition()) {
+        if (timer.elapsed() > 5000) {
+            return false;
+        }
+        QCoreApplication::processEvents();
+        QThread::msleep(5);
+    }
+    return true;
+}
+
+/// @brief Fetcher which blocks until @p release is set or load is cancelled.
+AsyncTaskLoader::FetcherFactory
+makeBlockingFetcher(std::atomic<int> &fetched, std::atomic<bool> &release,
+                    std::atomic<int> &cancelled)
+{
+    return [&fetched, &release, &cancelled]() -> AsyncTaskLoader::Fetcher {
+        return [&fetched, &release, &cancelled](
+                   const DetailedTaskInfo &task,
+                   const AsyncTaskLoader::CancelFlag &cancel) {
+            ++fetched;
+            while (!release.load()) {
+                if (cancel->load()) {
+                    ++cancelled;
+                    break;
+                }
+                QThread::msleep(1);
+            }
+            return task;
+        };
+    };
+}
+} // namespace
+
+class AsyncTaskLoaderTest : public QtBaseTest {
+  protected:
+    void TearDown() override { QThreadPool::globalInstance()->waitForDone(); }
+
+    std::atomic<int> m_fetched{ 0 };
+    std::atomic<bool> m_release{ false };
+    std::atomic<int> m_cancelled{ 0 };
+};
+
+TEST_F(AsyncTaskLoaderTest, DebounceLoadsLatestRequestOnly)
+{
+    m_release = true;
+    const std::unique_ptr<AsyncTaskLoader> loader(AsyncTaskLoader::create(
+        makeBlockingFetcher(m_fetched, m_release, m_cancelled)));
+    QSignalSpy spy(loader.get(), &AsyncTaskLoader::latestLoadingFinished);
+
+    loader->startTaskLoad(1, makeTask("a"));
+    loader->startTaskLoad(2, makeTask("b"));
+    const auto last = loader->startTaskLoad(3, makeTask("c"));
+    ASSERT_TRUE(spy.wait(5000));
+
+    EXPECT_EQ(spy.first().at(1).value<AsyncTaskLoader::RequestId>(), last);
+    EXPECT_EQ(spy.first().at(2).value<DetailedTaskInfo>().task_uuid, "c");
+    EXPECT_EQ(m_fetched.load(), 1);
+    EXPECT_EQ(loader->counters().started, 1u);
+    EXPECT_EQ(loader->counters().coalesced, 2u);
+    EXPECT_EQ(loader->counters().cancelled, 0u);
+}
+
+TEST_F(AsyncTaskLoaderTest, SameTaskReusesRunningLoad)
+{
+    const std::unique_ptr<AsyncTaskLoader> loader(AsyncTaskLoader::create(
+        makeBlockingFetcher(m_fetched, m_release, m_cancelled)));
+    QSignalSpy spy(loader.get(), &AsyncTaskLoader::latestLoadingFinished);
+
+    loader->startTaskLoad(1, makeTask("a"));
+    ASSERT_TRUE(waitFor([this]() { return m_fetched.load() == 1; }));
+    const auto last = loader->startTaskLoad(2, makeTask("a"));
+    ASSERT_TRUE(waitFor(
+        [&loader]() { return loader->counters().coalesced == 1u; }));
+    m_release = true;
+    ASSERT_TRUE(spy.wait(5000));
+
+    // Running load answers the latest request.
+    EXPECT_EQ(spy.first().at(1).value<AsyncTaskLoader::RequestId>(), last);
+    EXPECT_EQ(m_fetched.load(), 1);
+    EXPECT_EQ(loader->counters().started, 1u);
+    EXPECT_EQ(loader->counters().cancelled, 0u);
+}
+
+TEST_F(AsyncTaskLoaderTest, OtherTaskCancelsRunningLoad)
+{
+    const std::unique_ptr<AsyncTaskLoader> loader(AsyncTaskLoader::create(
+        makeBlockingFetcher(m_fetched, m_release, m_cancelled)));
+    QSignalSpy latest(loader.get(), &AsyncTaskLoader::latestLoadingFinished);
+    QSignalSpy any(loader.get(), &AsyncTaskLoader::anyLoadingFinished);
+
+    loader->startTaskLoad(1, makeTask("a"));
+    ASSERT_TRUE(waitFor([this]() { return m_fetched.load() == 1; }));
+    loader->startTaskLoad(2, makeTask("b"));
+    ASSERT_TRUE(waitFor([this]() { return m_cancelled.load() == 1; }));
+    m_release = true;
+    ASSERT_TRUE(latest.wait(5000));
+
+    EXPECT_EQ(latest.first().at(2).value<DetailedTaskInfo>().task_uuid, "b");
+    EXPECT_EQ(loader->counters().started, 2u);
+    EXPECT_EQ(loader->counters().cancelled, 1u);
+    // Cancelled load does not report anything.
+    QThreadPool::globalInstance()->waitForDone();
+    QCoreApplication::processEvents();
+    EXPECT_EQ(any.size(), 1);
+}
+} // namespace Test
@@ -0,0 +1,161 @@
+#include "batch_tasks_writer.hpp"
+#include "task.hpp"
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QTimeZone>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+namespace
+{
+const QDateTime kNow(QDate(2025, 11, 4), QTime(10, 0, 0), QTimeZone::utc());
+
+QJsonObject makeExported(const QString &uuid)
+{
+    return QJsonObject{
+        { "id", 1 },
+        { "uuid", uuid },
+        { "status", "pending" },
+        { "description", "exported" },
+        { "project", "home" },
+        { "tags", QJsonArray{ "one", "two" } },
+        { "due", "20251110T120000Z" },
+        { "start", "20251101T080000Z" },
+        { "urgency", 5.0 },
+    };
+}
+} // namespace
+
+TEST(BatchTasksWriterTest, OnlyModifiedPropertiesAreWritten)
+{
+    DetailedTaskInfo prioritized;
+    prioritized.task_uuid = "a";
+    prioritized.set(prioritized.priority, DetailedTaskInfo::Priority::H);
+
+    DetailedTaskInfo moved;
+    moved.task_uuid = "b";
+    moved.set(moved.project, QString());
+    moved.set(moved.active, false);
+    moved.set(moved.due,
+              QDateTime(QDate(2025, 12, 1), QTime(9, 0, 0), QTimeZone::utc()));
+
+    const QHash<QString, QJsonObject> exported = {
+        { "a", makeExported("a") },
+        { "b", makeExported("b") },
+    };
+    const auto objects =
+        BatchTasksWriter::buildImport({ prioritized, moved }, exported, kNow);
+    ASSERT_TRUE(objects.has_value());
+    ASSERT_EQ(objects->size(), 2);
+
+    const auto first = objects->at(0).toObject();
+    EXPECT_EQ(first.value("priority").toString(), "H");
+    EXPECT_EQ(first.value("description").toString(), "exported");
+    EXPECT_EQ(first.value("project").toString(), "home");
+    EXPECT_EQ(first.value("due").toString(), "20251110T120000Z");
+    EXPECT_EQ(first.value("start").toString(), "20251101T080000Z");
+    EXPECT_FALSE(first.contains("id"));
+    EXPECT_FALSE(first.contains("urgency"));
+
+    const auto second = objects->at(1).toObject();
+    EXPECT_FALSE(second.contains("priority"));
+    EXPECT_FALSE(second.contains("project"));
+    EXPECT_FALSE(second.contains("start"));
+    EXPECT_EQ(second.value("due").toString(), "20251201T090000Z");
+    EXPECT_EQ(second.value("tags").toArray().size(), 2);
+}
+
+TEST(BatchTasksWriterTest, StartedTaskGetsStartTime)
+{
+    DetailedTaskInfo started;
+    started.task_uuid = "a";
+    started.set(started.active, true);
+
+    auto exported = makeExported("a");
+    exported.remove("start");
+    const auto objects =
+        BatchTasksWriter::buildImport({ started }, { { "a", exported } }, kNow);
+    ASSERT_TRUE(objects.has_value());
+    EXPECT_EQ(objects->at(0).toObject().value("start").toString(),
+              "20251104T100000Z");
+
+    // Already started one keeps its time.
+    const auto restarted = BatchTasksWriter::buildImport(
+        { started }, { { "a", makeExported("a") } }, kNow);
+    ASSERT_TRUE(restarted.has_value());
+    EXPECT_EQ(restarted->at(0).toObject().value("start").toString(),
+              "20251101T080000Z");
+}
+
+TEST(BatchTasksWriterTest, FailsOnUnknownTask)
+{
+    DetailedTaskInfo unknown;
+    unknown.task_uuid = "unknown";
+    unknown.set(unknown.priority, DetailedTaskInfo::Priority::L);
+    EXPECT_FALSE(BatchTasksWriter::buildImport({ unknown }, {}, kNow));
+}
+
+TEST(BatchTasksWriterTest, TasksWithoutUuidAreCreated)
+{
+    DetailedTaskInfo first;
+    first.set(first.description, QString(" Buy milk "));
+    DetailedTaskInfo second;
+    second.set(second.description, QString("Call plumber"));
+    second.set(second.project, QString("home"));
+    DetailedTaskInfo existing;
+    existing.task_uuid = "a";
+    existing.set(existing.priority, DetailedTaskInfo::Priority::L);
+
+    const QList<DetailedTaskInfo> tasks = { first, second, existing };
+    EXPECT_EQ(BatchTasksWriter::existingUuids(tasks), QStringList({ "a" }));
+    const auto objects = BatchTasksWriter::buildImport(
+        tasks, { { "a", makeExported("a") } }, kNow);
+    ASSERT_TRUE(objects.has_value());
+    ASSERT_EQ(objects->size(), 3);
+
+    const auto created = objects->at(0).toObject();
+    EXPECT_FALSE(created.value("uuid").toString().isEmpty());
+    EXPECT_EQ(created.value("status").toString(), "pending");
+    EXPECT_EQ(created.value("entry").toString(), "20251104T100000Z");
+    EXPECT_EQ(created.value("description").toString(), "Buy milk");
+    EXPECT_FALSE(created.contains("project"));
+    const auto other = objects->at(1).toObject();
+    EXPECT_NE(other.value("uuid"), created.value("uuid"));
+    EXPECT_EQ(other.value("project").toString(), "home");
+    EXPECT_EQ(objects->at(2).toObject().value("uuid").toString(), "a");
+
+    // New task must have description.
+    DetailedTaskInfo empty;
+    empty.set(empty.description, QString(" "));
+    EXPECT_FALSE(BatchTasksWriter::buildImport({ empty }, {}, kNow));
+}
+
+TEST(BatchTasksWriterTest, UndoStepsDependOnTaskVersion)
+{
+    DetailedTaskInfo first;
+    first.task_uuid = "a";
+    first.set(first.priority, DetailedTaskInfo::Priority::H);
+    DetailedTaskInfo second = first;
+    second.task_uuid = "b";
+
+    const BatchTasksWriter batch({ first, second });
+    EXPECT_EQ(batch.undoSteps("2.6.2"), 2u);
+    EXPECT_EQ(batch.undoSteps("3.1.0"), 1u);
+
+    // Single task is written by `task modify`.
+    EXPECT_EQ(BatchTasksWriter({ first }).undoSteps("2.6.2"), 1u);
+    DetailedTaskInfo created;
+    created.set(created.description, QString("new"));
+    EXPECT_EQ(BatchTasksWriter({ created, created }).undoSteps("2.6.2"), 2u);
+    EXPECT_EQ(BatchTasksWriter(QList<DetailedTaskInfo>{}).undoSteps("2.6.2"),
+              0u);
+}
+} // namespace Test
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+/// @brief Benchmarks are written as disabled gtest cases, so they do not slow
+/// down regular runs. Launch those explicit:
+/// qtask_tests --gtest_also_run_disabled_tests --gtest_filter='*Benchmark*'
+namespace Bench
+{
+/// @returns best time in milliseconds of @p repeats calls to @p callable.
+template <typename taCallable>
+double measureMs(const taCallable &callable, int repeats = 3)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeats; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        callable();
+        const std::chrono::duration<double, std::milli> spent =
+            std::chrono::steady_clock::now() - start;
+        best = std::min(best, spent.count());
+    }
+    return best;
+}
+
+inline void report(const std::string &name, double ms)
+{
+    std::cout << "[ BENCH    ] " << std::left << std::setw(48) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << ms << " ms" << std::endl;
+}
+} // namespace Bench
@@ -0,0 +1,60 @@
+#include "data_files_fingerprint.hpp"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+class DataFilesFingerprintTest : public ::testing::Test {
+  protected:
+    QTemporaryDir tmp;
+
+    void write(const QString &name, const QByteArray &data,
+               QIODevice::OpenMode mode = QIODevice::WriteOnly)
+    {
+        QFile file(QDir(tmp.path()).absoluteFilePath(name));
+        ASSERT_TRUE(file.open(mode));
+        file.write(data);
+    }
+};
+
+TEST_F(DataFilesFingerprintTest, SameFilesGiveSameFingerprint)
+{
+    ASSERT_TRUE(tmp.isValid());
+    write("pending.data", "[status:\"pending\"]\n");
+
+    EXPECT_EQ(DataFilesFingerprint::read(QDir(tmp.path())),
+              DataFilesFingerprint::read(QDir(tmp.path())));
+}
+
+TEST_F(DataFilesFingerprintTest, DetectsAppendAndCreation)
+{
+    ASSERT_TRUE(tmp.isValid());
+    const QDir dir(tmp.path());
+    write("pending.data", "[status:\"pending\"]\n");
+    const auto initial = DataFilesFingerprint::read(dir);
+
+    write("pending.data", "[status:\"pending\"]\n",
+          QIODevice::WriteOnly | QIODevice::Append);
+    const auto appended = DataFilesFingerprint::read(dir);
+    EXPECT_NE(initial, appended);
+
+    write("undo.data", "time 1\n");
+    EXPECT_NE(appended, DataFilesFingerprint::read(dir));
+}
+
+TEST_F(DataFilesFingerprintTest, IgnoresUnrelatedFiles)
+{
+    ASSERT_TRUE(tmp.isValid());
+    const QDir dir(tmp.path());
+    write("taskchampion.sqlite3", "db");
+    const auto initial = DataFilesFingerprint::read(dir);
+
+    write("hooks.log", "something");
+    EXPECT_EQ(initial, DataFilesFingerprint::read(dir));
+}
+} // namespace Test
@@ -0,0 +1,87 @@
+#include "delta_tasks_list_reader.hpp"
+#include "task.hpp"
+#include "task_builder.hpp"
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+namespace
+{
+const QDateTime kModified(QDate(2025, 11, 4), QTime(10, 0, 0));
+} // namespace
+
+TEST(DeltaTasksListReaderTest, MergeTakesChangedAndAddedTasks)
+{
+    const QList<DetailedTaskInfo> kept = {
+        makeTask("a").description("first").urgency(3.0).modified(kModified),
+        makeTask("b").description("second").urgency(2.0).modified(kModified),
+        makeTask("c").description("third").urgency(1.0).modified(kModified),
+    };
+    const auto changedTime = kModified.addSecs(60);
+    const QList<DetailedTaskInfo> changed = {
+        makeTask("b")
+            .description("second changed")
+            .urgency(5.0)
+            .modified(changedTime),
+        makeTask("d").description("new").urgency(7.0).modified(changedTime),
+    };
+
+    const auto merged = DeltaTasksListReader::merge(kept, changed,
+                                                    { "a", "b", "c", "d" });
+    ASSERT_TRUE(merged.has_value());
+    ASSERT_EQ(merged->size(), 4);
+    EXPECT_EQ(merged->at(0).task_uuid, "d");
+    EXPECT_EQ(merged->at(1).task_uuid, "b");
+    EXPECT_EQ(merged->at(1).description.get(), "second changed");
+    EXPECT_EQ(merged->at(2).task_uuid, "a");
+    EXPECT_EQ(merged->at(3).task_uuid, "c");
+
+    EXPECT_EQ(DeltaTasksListReader::newestModified(changed), changedTime);
+}
+
+TEST(DeltaTasksListReaderTest, MergeFailsOnRemovedOrUnknownTask)
+{
+    const QList<DetailedTaskInfo> kept = {
+        makeTask("a").description("first").urgency(1.0).modified(kModified),
+        makeTask("b").description("second").urgency(1.0).modified(kModified),
+    };
+
+    // "a" was completed, so IDs of others are renumbered.
+    EXPECT_FALSE(DeltaTasksListReader::merge(kept, {}, { "b" }));
+
+    // Undo of deletion restores old modification time, so "c" is not
+    // exported as modified.
+    EXPECT_FALSE(DeltaTasksListReader::merge(kept, {}, { "a", "b", "c" }));
+
+    EXPECT_TRUE(DeltaTasksListReader::merge(kept, {}, { "a", "b" }));
+}
+
+TEST(DeltaTasksListReaderTest, MergeFailsOnChangedDependencies)
+{
+    const QList<DetailedTaskInfo> kept = {
+        makeTask("a").description("first").urgency(1.0).modified(kModified),
+        makeTask("b").description("second").urgency(1.0).modified(kModified),
+    };
+    const auto changedTime = kModified.addSecs(60);
+    DetailedTaskInfo dependent =
+        makeTask("b").description("second").depends({ "a" }).modified(
+            changedTime);
+
+    // "a" became blocking, but it is not modified itself.
+    EXPECT_FALSE(
+        DeltaTasksListReader::merge(kept, { dependent }, { "a", "b" }));
+
+    dependent.task_uuid = "c";
+    EXPECT_FALSE(
+        DeltaTasksListReader::merge(kept, { dependent }, { "a", "b", "c" }));
+
+    dependent.depends.clear();
+    EXPECT_TRUE(
+        DeltaTasksListReader::merge(kept, { dependent }, { "a", "b", "c" }));
+}
+} // namespace Test
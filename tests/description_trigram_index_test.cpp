@@ -0,0 +1,105 @@
+#include "description_trigram_index.hpp"
+#include "task.hpp"
+#include "task_builder.hpp"
+#include "tasks_filter_index.hpp"
+#include "tasks_snapshot.hpp"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+namespace
+{
+QStringList foundUuids(const DescriptionTrigramIndex &index,
+                       const QString &query)
+{
+    QStringList res;
+    for (const auto &hit : index.search(query)) {
+        res << hit.uuid;
+    }
+    return res;
+}
+
+const QList<DetailedTaskInfo> kTasks = {
+    makeTask("uuid-1").id(1).description("Buy milk"),
+    makeTask("uuid-2").id(2).description("Fix the garden fence"),
+    makeTask("uuid-3").id(3).description("Write quarterly report"),
+    makeTask("uuid-4").id(4).description("Repair fence gate"),
+};
+} // namespace
+
+TEST(DescriptionTrigramIndexTest, FuzzyKeywordsAreTakenFromFilter)
+{
+    QStringList keywords = { "pro:Home", "~garden", "+shop", "~fnce", "~" };
+    EXPECT_EQ(TasksFilterQuery::takeFuzzyText(keywords), "garden fnce");
+    EXPECT_EQ(keywords, QStringList({ "pro:Home", "+shop", "~" }));
+}
+
+TEST(DescriptionTrigramIndexTest, ExactWordsRankFirst)
+{
+    const DescriptionTrigramIndex index(kTasks);
+    EXPECT_EQ(foundUuids(index, "fence"),
+              QStringList({ "uuid-2", "uuid-4" }));
+    // All words should be similar.
+    EXPECT_EQ(foundUuids(index, "GARDEN fence"), QStringList({ "uuid-2" }));
+    // Typos are tolerated.
+    EXPECT_EQ(foundUuids(index, "quartely"), QStringList({ "uuid-3" }));
+    EXPECT_EQ(foundUuids(index, "repot"), QStringList({ "uuid-3" }));
+    EXPECT_TRUE(foundUuids(index, "xyz").isEmpty());
+    EXPECT_TRUE(foundUuids(index, "").isEmpty());
+}
+
+TEST(DescriptionTrigramIndexTest, UpdateMatchesFullBuild)
+{
+    auto tasks = kTasks;
+    for (int id = 6; id < 12; ++id) {
+        tasks << makeTask(id, QString("Unrelated %1").arg(id));
+    }
+    const DescriptionTrigramIndex index(tasks);
+    tasks[0].set(tasks[0].description, "Buy fence paint");
+    tasks.removeAt(3);
+    tasks << makeTask("uuid-5").id(5).description("Paint the fence");
+
+    const auto updated = index.updated(tasks);
+    const DescriptionTrigramIndex built(tasks);
+    for (const auto *query : { "fence", "paint", "milk", "gate", "garden" }) {
+        auto found = foundUuids(updated, query);
+        auto expected = foundUuids(built, query);
+        found.sort();
+        expected.sort();
+        EXPECT_EQ(found, expected) << query;
+    }
+    EXPECT_TRUE(foundUuids(updated, "milk").isEmpty());
+    // Original is not changed.
+    EXPECT_EQ(foundUuids(index, "milk"), QStringList({ "uuid-1" }));
+}
+
+TEST(DescriptionTrigramIndexTest, RankingKeepsOrderOfEqualScores)
+{
+    const auto ranked = TasksSnapshot::rankByHits(
+        kTasks, { { "uuid-4", 100 }, { "uuid-3", 50 }, { "uuid-2", 100 } });
+    ASSERT_EQ(ranked.size(), 3);
+    EXPECT_EQ(ranked.at(0).task_uuid, "uuid-2");
+    EXPECT_EQ(ranked.at(1).task_uuid, "uuid-4");
+    EXPECT_EQ(ranked.at(2).task_uuid, "uuid-3");
+}
+
+TEST(DescriptionTrigramIndexTest, MatchRangesAreMerged)
+{
+    using Range = DescriptionTrigramIndex::Range;
+    EXPECT_EQ(DescriptionTrigramIndex::matchRanges(u"Fix the garden fence",
+                                                   "GARDEN fence"),
+              QList<Range>({ { 8, 6 }, { 15, 5 } }));
+    EXPECT_EQ(
+        DescriptionTrigramIndex::matchRanges(u"Fence, fence", "fence"),
+        QList<Range>({ { 0, 5 }, { 7, 5 } }));
+    // Similar parts are highlighted when word is not found as is.
+    EXPECT_EQ(DescriptionTrigramIndex::matchRanges(u"quarterly", "quartely"),
+              QList<Range>({ { 0, 6 }, { 7, 2 } }));
+    EXPECT_TRUE(DescriptionTrigramIndex::matchRanges(u"milk", "xyz").isEmpty());
+}
+} // namespace Test
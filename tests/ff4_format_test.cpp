@@ -0,0 +1,78 @@
+#include "ff4_format.hpp"
+
+#include <QByteArrayView>
+#include <QString>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+class Ff4FormatTest : public ::testing::Test {
+  protected:
+    using TAttributes = std::vector<std::pair<std::string, std::string>>;
+
+    static std::optional<TAttributes> parse(QByteArrayView line)
+    {
+        TAttributes res;
+        const bool ok = Ff4::forEachAttribute(
+            line, [&res](QByteArrayView key, QByteArrayView value) {
+                res.emplace_back(key.toByteArray().toStdString(),
+                                 value.toByteArray().toStdString());
+            });
+        if (!ok) {
+            return std::nullopt;
+        }
+        return res;
+    }
+};
+
+TEST_F(Ff4FormatTest, ParsesAttributes)
+{
+    const auto res = parse(R"([description:"Buy milk" entry:"1767225600" )"
+                           R"(status:"pending" tags:"home,shop"])");
+
+    ASSERT_TRUE(res.has_value());
+    const TAttributes expected = {
+        { "description", "Buy milk" },
+        { "entry", "1767225600" },
+        { "status", "pending" },
+        { "tags", "home,shop" },
+    };
+    EXPECT_EQ(*res, expected);
+}
+
+TEST_F(Ff4FormatTest, EscapedQuoteDoesNotEndValue)
+{
+    const auto res = parse(R"([description:"Say \"hi\": now" status:"x"])");
+
+    ASSERT_TRUE(res.has_value());
+    ASSERT_EQ(res->size(), 2u);
+    EXPECT_EQ(res->at(0).second, R"(Say \"hi\": now)");
+    EXPECT_EQ(res->at(1).first, "status");
+}
+
+TEST_F(Ff4FormatTest, RejectsBrokenLines)
+{
+    EXPECT_FALSE(parse(R"(description:"a"])").has_value());
+    EXPECT_FALSE(parse(R"([description:"a])").has_value());
+    EXPECT_FALSE(parse(R"([description "a"])").has_value());
+    EXPECT_TRUE(parse("[]").has_value());
+}
+
+TEST_F(Ff4FormatTest, DecodesValues)
+{
+    EXPECT_EQ(Ff4::decodeValue("plain"), "plain");
+    EXPECT_EQ(Ff4::decodeValue(R"(Say \"hi\")"), R"(Say "hi")");
+    EXPECT_EQ(Ff4::decodeValue(R"(a\\b\/c\td)"), "a\\b/c\td");
+    EXPECT_EQ(Ff4::decodeValue(R"(&open;x&close;)"), "[x]");
+    EXPECT_EQ(Ff4::decodeValue("Купить"), "Купить");
+    EXPECT_EQ(Ff4::decodeValue(R"(\u041a\u0443)"), "Ку");
+    EXPECT_EQ(Ff4::decodeValue(R"(x\ud83d\ude00y)"),
+              QString::fromUtf8("x\xF0\x9F\x98\x80y"));
+}
+} // namespace Test
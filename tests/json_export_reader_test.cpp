@@ -0,0 +1,295 @@
+#include "bench_timer.hpp"
+#include "json_export_reader.hpp"
+#include "split_string.hpp"
+#include "tabular_stencil_base.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDate>
+#include <QDateTime>
+#include <QJsonValue>
+#include <QString>
+#include <QStringList>
+#include <QTime>
+#include <QTimeZone>
+#include <qtypes.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+namespace
+{
+struct ExportedTask {
+    int id = -1;
+    QString project;
+    QString description;
+    QDateTime due;
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+class JsonReaderSpy : public JsonExportReaderBase<ExportedTask> {
+  public:
+    using JsonExportReaderBase<ExportedTask>::parseExportOutput;
+    using FieldsSchema = JsonExportReaderBase<ExportedTask>::FieldsSchema;
+
+    [[nodiscard]]
+    const FieldsSchema &getSchema() const override
+    {
+        static const FieldsSchema schema = {
+            { "id",
+              [](const QJsonValue &v, ExportedTask &t) { t.id = v.toInt(); } },
+            { "project",
+              [](const QJsonValue &v, ExportedTask &t) {
+                  t.set(t.project, v.toString());
+              } },
+            { "description",
+              [](const QJsonValue &v, ExportedTask &t) {
+                  t.set(t.description, v.toString());
+              } },
+            { "due",
+              [](const QJsonValue &v, ExportedTask &t) {
+                  t.set(t.due, parseExportDateTime(v.toString()));
+              } },
+        };
+        return schema;
+    }
+
+    [[nodiscard]]
+    QStringList createCmdParameters() const override
+    {
+        return {};
+    }
+};
+
+// NOLINTNEXTLINE(cppcoreguidelines-virtual-class-destructor)
+class StencilReaderSpy : public TabularStencilBase<ExportedTask> {
+  public:
+    using TabularStencilBase<ExportedTask>::parseRawConsoleOutput;
+    using ColumnsSchema = TabularStencilBase<ExportedTask>::ColumnsSchema;
+    using Mode = TabularStencilBase<ExportedTask>::ColumnDescriptor::LineMode;
+
+    [[nodiscard]]
+    const ColumnsSchema &getSchema() const override
+    {
+        static const ColumnsSchema schema = {
+            { "id",
+              [](const QString &v, ExportedTask &t, Mode m) {
+                  if (m == Mode::FirstLineOfNewRecord) {
+                      t.id = v.toInt();
+                  }
+              } },
+            { "project",
+              [](const QString &v, ExportedTask &t, Mode m) {
+                  if (m == Mode::FirstLineOfNewRecord) {
+                      t.set(t.project, v);
+                  }
+              } },
+            { "due",
+              [](const QString &v, ExportedTask &t, Mode m) {
+                  if (m == Mode::FirstLineOfNewRecord) {
+                      t.set(t.due,
+                            QDateTime::fromString(v, Qt::ISODate));
+                  }
+              } },
+            { "description",
+              [](const QString &v, ExportedTask &t, Mode) {
+                  if (!t.description.isEmpty()) {
+                      t.description += '\n';
+                  }
+                  t.description += v;
+              } },
+        };
+        return schema;
+    }
+
+    [[nodiscard]]
+    QStringList
+    createCmdParameters(const TableStencil &) const override // NOLINT
+    {
+        return {};
+    }
+};
+
+QByteArray makeJsonExport(int count)
+{
+    QByteArray out("[\n");
+    for (int i = 1; i <= count; ++i) {
+        out += QStringLiteral(
+                   R"({"id":%1,"description":"Task number %1 with \"quotes\" )"
+                   R"(and {braces}","due":"20260115T093000Z",)"
+                   R"("entry":"20250101T000000Z","project":"work.sub%2",)"
+                   R"("status":"pending","tags":["a","b"],)"
+                   R"("uuid":"2b5d0f3c-6a1e-4c2f-9d7e-%3","urgency":%4})")
+                   .arg(i)
+                   .arg(i % 17)
+                   .arg(i, 12, 10, QChar('0'))
+                   .arg(10.0 - i * 0.001)
+                   .toUtf8();
+        out += i == count ? "\n" : ",\n";
+    }
+    out += "]\n";
+    return out;
+}
+
+QByteArray makeTableExport(int count)
+{
+    QByteArray out = "     |            |                   |\n" // labels
+                     "ID   Project      Due                 Description\n";
+    for (int i = 1; i <= count; ++i) {
+        out += QStringLiteral("%1 %2 2026-01-15T11:30:00 Task number %3 with "
+                              "\"quotes\" and {braces}\n")
+                   .arg(i, -4)
+                   .arg(QStringLiteral("work.sub%1").arg(i % 17), -12)
+                   .arg(i)
+                   .toUtf8();
+    }
+    return out;
+}
+} // namespace
+
+class JsonExportReaderTest : public ::testing::Test {
+  protected:
+    JsonReaderSpy spy;
+
+    static std::vector<std::string> splitAll(QByteArrayView output,
+                                             qsizetype chunkSize)
+    {
+        std::vector<std::string> objects;
+        JsonObjectsSplitter splitter;
+        for (qsizetype pos = 0; pos < output.size(); pos += chunkSize) {
+            splitter.feed(output.sliced(pos, std::min(chunkSize,
+                                                      output.size() - pos)),
+                          [&objects](QByteArrayView object) {
+                              objects.emplace_back(object.data(),
+                                                   object.size());
+                          });
+        }
+        EXPECT_TRUE(splitter.isIdle());
+        return objects;
+    }
+};
+
+TEST_F(JsonExportReaderTest, SplitsArrayIntoObjects)
+{
+    const QByteArray output =
+        R"([{"id":1,"description":"a"},)"
+        "\n"
+        R"({"id":2,"tags":["x","y"],"description":"b"}])";
+
+    const auto objects = splitAll(output, output.size());
+
+    ASSERT_EQ(objects.size(), 2u);
+    EXPECT_EQ(objects[0], R"({"id":1,"description":"a"})");
+    EXPECT_EQ(objects[1], R"({"id":2,"tags":["x","y"],"description":"b"})");
+}
+
+TEST_F(JsonExportReaderTest, ChunkBordersDoNotMatter)
+{
+    const QByteArray output = makeJsonExport(5);
+    const auto expected = splitAll(output, output.size());
+    ASSERT_EQ(expected.size(), 5u);
+
+    for (qsizetype chunk = 1; chunk < 64; ++chunk) {
+        EXPECT_EQ(splitAll(output, chunk), expected)
+            << "Chunk size " << chunk;
+    }
+}
+
+TEST_F(JsonExportReaderTest, BracesAndQuotesInsideStrings)
+{
+    const QByteArray output =
+        R"([{"description":"x } \" { ] [ \\"},{"description":"y"}])";
+    const auto resp =
+        JsonReaderSpy::parseExportOutput(spy.getSchema(), output);
+
+    ASSERT_TRUE(resp.has_value());
+    ASSERT_EQ(resp->size(), 2);
+    EXPECT_EQ(resp->at(0).description, R"(x } " { ] [ \)");
+    EXPECT_EQ(resp->at(1).description, "y");
+}
+
+TEST_F(JsonExportReaderTest, FillsFieldsAndSkipsMissing)
+{
+    const QByteArray output =
+        R"([{"id":3,"project":"home","due":"20251104T120000Z"},)"
+        R"({"id":4,"description":"no project"}])";
+
+    const auto resp =
+        JsonReaderSpy::parseExportOutput(spy.getSchema(), output);
+
+    ASSERT_TRUE(resp.has_value());
+    ASSERT_EQ(resp->size(), 2);
+    EXPECT_EQ(resp->at(0).id, 3);
+    EXPECT_EQ(resp->at(0).project, "home");
+    EXPECT_EQ(resp->at(0).due,
+              QDateTime(QDate(2025, 11, 4), QTime(12, 0), QTimeZone::utc()));
+    EXPECT_EQ(resp->at(1).id, 4);
+    EXPECT_TRUE(resp->at(1).project.isEmpty());
+    EXPECT_FALSE(resp->at(1).due.isValid());
+}
+
+TEST_F(JsonExportReaderTest, EmptyExport)
+{
+    const auto resp = JsonReaderSpy::parseExportOutput(spy.getSchema(), "[\n]");
+    ASSERT_TRUE(resp.has_value());
+    EXPECT_TRUE(resp->isEmpty());
+}
+
+TEST_F(JsonExportReaderTest, BrokenObjectIsError)
+{
+    EXPECT_FALSE(JsonReaderSpy::parseExportOutput(spy.getSchema(),
+                                                  R"([{"id":1,}])")
+                     .has_value());
+    EXPECT_FALSE(
+        JsonReaderSpy::parseExportOutput(spy.getSchema(), R"([{"id":1)")
+            .has_value());
+}
+
+TEST_F(JsonExportReaderTest, ExportDateTimeFormat)
+{
+    EXPECT_EQ(parseExportDateTime(u"20240229T235959Z"),
+              QDateTime(QDate(2024, 2, 29), QTime(23, 59, 59),
+                        QTimeZone::utc()));
+    EXPECT_FALSE(parseExportDateTime(u"20230229T000000Z").isValid());
+    EXPECT_FALSE(parseExportDateTime(u"2024-02-29T00:00").isValid());
+    EXPECT_FALSE(parseExportDateTime(u"2024022aT000000Z").isValid());
+    EXPECT_FALSE(parseExportDateTime(u"").isValid());
+}
+
+TEST_F(JsonExportReaderTest, DISABLED_BenchmarkAgainstStencil)
+{
+    const StencilReaderSpy stencilSpy;
+    for (const int count : { 10000, 100000 }) {
+        const auto json = makeJsonExport(count);
+        const auto table = makeTableExport(count);
+        const auto lines = splitRawLines(table);
+
+        TableStencil stencil({ "id", "project", "due", "description" });
+        ASSERT_TRUE(
+            stencil.processLabelString(QString::fromUtf8(lines.front())));
+
+        qsizetype jsonParsed = 0;
+        const double jsonMs = Bench::measureMs([&]() {
+            jsonParsed =
+                JsonReaderSpy::parseExportOutput(spy.getSchema(), json)->size();
+        });
+        qsizetype tableParsed = 0;
+        const double tableMs = Bench::measureMs([&]() {
+            tableParsed = StencilReaderSpy::parseRawConsoleOutput(
+                              stencilSpy.getSchema(), stencil, lines)
+                              .size();
+        });
+        EXPECT_EQ(jsonParsed, count);
+        EXPECT_EQ(tableParsed, count);
+
+        const auto suffix = " x" + std::to_string(count);
+        Bench::report("json export" + suffix, jsonMs);
+        Bench::report("column stencil" + suffix, tableMs);
+    }
+}
+} // namespace Test
@@ -0,0 +1,152 @@
+#include "bench_timer.hpp"
+#include "list_diff.hpp"
+
+#include <QList>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+namespace Test
+{
+namespace
+{
+/// @brief Does the same with keys, as TasksModel does with rows.
+QList<QString> applyOperations(QList<QString> current,
+                               const ListDiff::Operations &operations,
+                               const QList<QString> &new_keys)
+{
+    using Kind = ListDiff::Operation::Kind;
+    for (const auto &op : operations) {
+        switch (op.kind) {
+        case Kind::Remove:
+            EXPECT_LE(op.row + op.count, current.size());
+            current.remove(op.row, op.count);
+            break;
+        case Kind::Move:
+            // Qt rejects moves which do not change anything.
+            EXPECT_NE(op.destination, op.row);
+            EXPECT_NE(op.destination, op.row + 1);
+            current.move(op.row, op.row < op.destination ? op.destination - 1
+                                                         : op.destination);
+            break;
+        case Kind::Insert:
+            for (int i = 0; i < op.count; ++i) {
+                current.insert(op.row + i, new_keys.at(op.source + i));
+            }
+            break;
+        }
+    }
+    return current;
+}
+
+QList<QString> makeKeys(int count, int first = 0)
+{
+    QList<QString> keys;
+    keys.reserve(count);
+    for (int i = first; i < first + count; ++i) {
+        keys << QString("uuid-%1").arg(i);
+    }
+    return keys;
+}
+} // namespace
+
+TEST(ListDiffTest, SameListGivesNoOperations)
+{
+    const auto keys = makeKeys(10);
+    const auto ops = ListDiff::compute(keys, keys, 100);
+    ASSERT_TRUE(ops.has_value());
+    EXPECT_TRUE(ops->empty());
+}
+
+TEST(ListDiffTest, SingleTaskMovedIsSingleMove)
+{
+    const auto oldKeys = makeKeys(10);
+    auto newKeys = oldKeys;
+    newKeys.move(8, 1);
+
+    const auto ops = ListDiff::compute(oldKeys, newKeys, 100);
+    ASSERT_TRUE(ops.has_value());
+    ASSERT_EQ(ops->size(), 1U);
+    EXPECT_EQ(ops->front().kind, ListDiff::Operation::Kind::Move);
+    EXPECT_EQ(applyOperations(oldKeys, *ops, newKeys), newKeys);
+}
+
+TEST(ListDiffTest, ConsecutiveInsertsAndRemovalsAreMerged)
+{
+    const auto oldKeys = makeKeys(10);
+    auto newKeys = oldKeys;
+    newKeys.remove(2, 3);
+    newKeys.insert(5, "new-1");
+    newKeys.insert(6, "new-2");
+
+    const auto ops = ListDiff::compute(oldKeys, newKeys, 100);
+    ASSERT_TRUE(ops.has_value());
+    ASSERT_EQ(ops->size(), 2U);
+    EXPECT_EQ(ops->at(0).kind, ListDiff::Operation::Kind::Remove);
+    EXPECT_EQ(ops->at(0).count, 3);
+    EXPECT_EQ(ops->at(1).kind, ListDiff::Operation::Kind::Insert);
+    EXPECT_EQ(ops->at(1).count, 2);
+    EXPECT_EQ(applyOperations(oldKeys, *ops, newKeys), newKeys);
+}
+
+TEST(ListDiffTest, RandomChangesGiveNewList)
+{
+    std::mt19937 rng(42); // NOLINT
+    const auto pool = makeKeys(30);
+    for (int i = 0; i < 2000; ++i) {
+        auto oldKeys = pool;
+        auto newKeys = pool;
+        std::shuffle(oldKeys.begin(), oldKeys.end(), rng);
+        std::shuffle(newKeys.begin(), newKeys.end(), rng);
+        oldKeys.resize(static_cast<qsizetype>(rng() % pool.size()));
+        newKeys.resize(static_cast<qsizetype>(rng() % pool.size()));
+
+        const auto ops = ListDiff::compute(oldKeys, newKeys, pool.size());
+        ASSERT_TRUE(ops.has_value());
+        ASSERT_EQ(applyOperations(oldKeys, *ops, newKeys), newKeys);
+    }
+}
+
+TEST(ListDiffTest, RejectsDuplicatesAndTooManyMoves)
+{
+    const auto keys = makeKeys(10);
+    EXPECT_FALSE(ListDiff::compute(keys, keys + keys.first(1), 100));
+
+    auto reversed = keys;
+    std::reverse(reversed.begin(), reversed.end());
+    EXPECT_FALSE(ListDiff::compute(keys, reversed, 5));
+    EXPECT_TRUE(ListDiff::compute(keys, reversed, 9));
+}
+
+TEST(ListDiffTest, DISABLED_BenchmarkDiffOf50kRows)
+{
+    static constexpr int kRows = 50000;
+    const auto oldKeys = makeKeys(kRows);
+
+    auto oneChanged = oldKeys;
+    oneChanged.move(kRows - 10, 10);
+    auto someChanged = oldKeys;
+    someChanged.remove(100, 50);
+    for (int i = 0; i < 500; ++i) {
+        someChanged.move(i * 90, i * 97 % someChanged.size());
+    }
+    someChanged += makeKeys(50, kRows);
+
+    const auto measure = [&oldKeys](const std::string &name,
+                                    const QList<QString> &newKeys) {
+        std::size_t opsCount = 0;
+        const double ms = Bench::measureMs([&]() {
+            const auto ops = ListDiff::compute(oldKeys, newKeys, 1000);
+            opsCount = ops ? ops->size() : 0;
+        });
+        EXPECT_GT(opsCount, 0U);
+        Bench::report(name, ms);
+    };
+    measure("diff 50k rows, 1 moved", oneChanged);
+    measure("diff 50k rows, 500 moved, 50 replaced", someChanged);
+}
+} // namespace Test
@@ -0,0 +1,70 @@
+#include "patched_changes_gate.hpp"
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+class PatchedChangesGateTest : public ::testing::Test {
+  protected:
+    void SetUp() override
+    {
+        // The 1st change on disk is always read, it gives undo count.
+        ASSERT_TRUE(gate.needsRefresh(10u, 0));
+    }
+
+    PatchedChangesGate gate;
+};
+
+TEST_F(PatchedChangesGateTest, SkipsChangeWhichWasPatched)
+{
+    gate.patched(2, 100);
+    EXPECT_FALSE(gate.needsRefresh(12u, 200));
+    // Nothing is expected anymore.
+    EXPECT_TRUE(gate.needsRefresh(13u, 300));
+}
+
+TEST_F(PatchedChangesGateTest, SkipsChangeWrittenByParts)
+{
+    gate.patched(3, 100);
+    EXPECT_FALSE(gate.needsRefresh(11u, 200));
+    EXPECT_FALSE(gate.needsRefresh(13u, 300));
+    EXPECT_TRUE(gate.needsRefresh(14u, 400));
+}
+
+TEST_F(PatchedChangesGateTest, RefreshesAfterUndo)
+{
+    gate.patched(1, 100);
+    EXPECT_TRUE(gate.needsRefresh(9u, 200));
+
+    gate.patched(1, 300);
+    // Undo and modification together keep the count.
+    EXPECT_TRUE(gate.needsRefresh(9u, 400));
+}
+
+TEST_F(PatchedChangesGateTest, RefreshesAfterCommandWithoutHooks)
+{
+    gate.patched(1, 100);
+    EXPECT_TRUE(gate.needsRefresh(12u, 200));
+}
+
+TEST_F(PatchedChangesGateTest, RefreshesWhenPatchExpired)
+{
+    gate.patched(1, 100);
+    EXPECT_TRUE(
+        gate.needsRefresh(11u, 100 + PatchedChangesGate::kValidityMs + 1));
+}
+
+TEST_F(PatchedChangesGateTest, RefreshesAfterInvalidate)
+{
+    gate.patched(1, 100);
+    gate.invalidate();
+    EXPECT_TRUE(gate.needsRefresh(11u, 200));
+}
+
+TEST_F(PatchedChangesGateTest, AccumulatesPatchesInTime)
+{
+    gate.patched(1, 100);
+    gate.patched(2, 200);
+    EXPECT_FALSE(gate.needsRefresh(13u, 300));
+}
+} // namespace Test
@@ -7,6 +7,7 @@
 
 #include <QEventLoop>
 #include <QThread>
+#include <QTimer>
 
 #include <gtest/gtest.h>
 
@@ -60,10 +61,11 @@ TEST_F(PereodicAsynExecTest, PeriodicRestart)
 
 TEST_F(PereodicAsynExecTest, AvoidsOverlapping)
 {
-    SCOPED_TRACE(
-        "Check that fast calls to execNow() are ignored if thread is running.");
+    SCOPED_TRACE("Check that fast calls to execNow() while thread is running "
+                 "are collapsed into single follow-up run.");
     QEventLoop loop;
     std::atomic<int> startCount{ 0 };
+    int receivedCount = 0;
 
     // Long callable
     auto callable = [&](int) {
@@ -72,16 +74,38 @@ TEST_F(PereodicAsynExecTest, AvoidsOverlapping)
         return 0;
     };
     auto provider = []() { return std::make_tuple(1); };
-    auto receiver = [&](int) { loop.quit(); };
+    auto receiver = [&](int) {
+        receivedCount++;
+        if (receivedCount == 2) {
+            loop.quit();
+        }
+    };
 
-    PereodicAsynExec exec(10ms, callable, provider, receiver);
+    PereodicAsynExec exec(10s, callable, provider, receiver);
 
     exec.execNow();
     QThread::msleep(100);
     exec.execNow();
+    exec.execNow();
     loop.exec();
     QThread::msleep(100);
-    EXPECT_EQ(startCount.load(), 1);
+    EXPECT_EQ(startCount.load(), 2);
+}
+
+TEST_F(PereodicAsynExecTest, OnDemandOnlyDoesNotRestart)
+{
+    QEventLoop loop;
+    int callCount = 0;
+    auto callable = []() { return 0; };
+    auto provider = []() { return std::make_tuple(); };
+    auto receiver = [&](int) { callCount++; };
+
+    PereodicAsynExec exec(10ms, callable, provider, receiver);
+    exec.setPeriod(IPereodicExec::kOnDemandOnly);
+    exec.execNow();
+    QTimer::singleShot(200ms, &loop, &QEventLoop::quit);
+    loop.exec();
+    EXPECT_EQ(callCount, 1);
 }
 
 TEST_F(PereodicAsynExecTest, DestructorSafety)
@@ -0,0 +1,104 @@
+#include "pereodic_async_executor.hpp"
+#include "poll_scheduler.hpp"
+#include "qt_base_test.hpp"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QThread>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+
+namespace Test
+{
+using namespace std::chrono_literals;
+
+namespace
+{
+class CountingJob : public IPereodicExec {
+  public:
+    void execNow() override { ++runs; }
+    void setPeriod(std::chrono::milliseconds new_period) override
+    {
+        period = new_period;
+    }
+
+    int runs{ 0 };
+    std::chrono::milliseconds period{ -1 };
+};
+
+void processEventsFor(const std::chrono::milliseconds duration)
+{
+    QElapsedTimer timer;
+    timer.start();
+    while (!timer.hasExpired(duration.count())) {
+        QCoreApplication::processEvents();
+        QThread::msleep(5);
+    }
+}
+} // namespace
+
+class PollSchedulerTest : public QtBaseTest {
+  protected:
+    PollScheduler m_scheduler;
+    QObject m_owner;
+    CountingJob m_job;
+};
+
+TEST_F(PollSchedulerTest, EffectivePeriodBacksOffWhileHidden)
+{
+    // Window was not shown yet.
+    EXPECT_EQ(m_scheduler.effectivePeriod(10s),
+              10s * PollScheduler::kHiddenBackoff);
+    EXPECT_EQ(m_scheduler.effectivePeriod(10min),
+              PollScheduler::kMaxBackedOffPeriod);
+    // Backing off never makes period shorter.
+    EXPECT_EQ(m_scheduler.effectivePeriod(40min), 40min);
+
+    m_scheduler.setWindowVisible(true);
+    EXPECT_EQ(m_scheduler.effectivePeriod(10s), 10s);
+    EXPECT_EQ(m_scheduler.effectivePeriod(10min), 10min);
+}
+
+TEST_F(PollSchedulerTest, RunsJobByItsPeriod)
+{
+    m_scheduler.setWindowVisible(true);
+    m_scheduler.add(&m_owner, &m_job, 50ms);
+    EXPECT_EQ(m_job.period, IPereodicExec::kOnDemandOnly)
+        << "Own timer of the job must be disabled.";
+    EXPECT_EQ(m_job.runs, 0) << "First run is requested by the owner.";
+
+    processEventsFor(240ms);
+    EXPECT_GE(m_job.runs, 2);
+    EXPECT_LE(m_job.runs, 5);
+}
+
+TEST_F(PollSchedulerTest, HiddenWindowPollsRarerAndCatchesUpOnShow)
+{
+    m_scheduler.add(&m_owner, &m_job, 50ms);
+    // Backed off period is 300ms.
+    processEventsFor(150ms);
+    EXPECT_EQ(m_job.runs, 0);
+
+    // The normal period passed already, so job runs at once.
+    m_scheduler.setWindowVisible(true);
+    EXPECT_EQ(m_job.runs, 1);
+    m_scheduler.setWindowVisible(false);
+    m_scheduler.setWindowVisible(true);
+    EXPECT_EQ(m_job.runs, 1) << "Job which ran recently is not caught up.";
+}
+
+TEST_F(PollSchedulerTest, JobIsRemovedWithOwner)
+{
+    m_scheduler.setWindowVisible(true);
+    {
+        QObject owner;
+        m_scheduler.add(&owner, &m_job, 20ms);
+    }
+    processEventsFor(100ms);
+    EXPECT_EQ(m_job.runs, 0);
+}
+} // namespace Test
@@ -1,5 +1,7 @@
 #include "split_string.hpp"
 
+#include <QByteArray>
+
 #include <gtest/gtest.h>
 
 namespace Test
@@ -22,4 +24,17 @@ TEST_F(SplitStringTest, KeyStartsAtStringStart)
     EXPECT_FALSE(split.isValid());
 }
 
+TEST_F(SplitStringTest, SplitsRawLines)
+{
+    const QByteArray output = "a\r\n\nbb\n\r\n  \nccc";
+    const auto lines = splitRawLines(output);
+
+    ASSERT_EQ(lines.size(), 4u);
+    EXPECT_EQ(lines[0], "a");
+    EXPECT_EQ(lines[1], "bb");
+    EXPECT_EQ(lines[2], "  ");
+    EXPECT_EQ(lines[3], "ccc");
+    EXPECT_TRUE(splitRawLines("\n\r\n").empty());
+}
+
 } // namespace Test
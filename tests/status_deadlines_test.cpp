@@ -0,0 +1,102 @@
+#include "status_deadlines.hpp"
+#include "task.hpp"
+#include "task_builder.hpp"
+#include "task_date_time.hpp"
+
+#include <QDateTime>
+#include <QList>
+
+#include <gtest/gtest.h>
+
+#include <chrono> //NOLINT
+
+namespace Test
+{
+namespace
+{
+using namespace std::chrono_literals;
+
+const QDateTime kNow(QDate(2025, 11, 4), QTime(10, 0, 0));
+const auto kNowMs = kNow.toMSecsSinceEpoch();
+
+constexpr qint64 kDueWarningMs =
+    TaskDateTime<ETaskDateTimeRole::Due>::warning_interval().count();
+constexpr qint64 kSchedWarningMs =
+    TaskDateTime<ETaskDateTimeRole::Sched>::warning_interval().count();
+} // namespace
+
+TEST(StatusDeadlinesTest, TransitionsMatchRelationToNow)
+{
+    const qint64 date = kNowMs + 10000;
+    EXPECT_EQ(StatusDeadlines::nextTransition(date, 1000, kNowMs),
+              date - 1000);
+    EXPECT_EQ(StatusDeadlines::nextTransition(date, 1000, date - 1000),
+              date + 1);
+    EXPECT_EQ(StatusDeadlines::nextTransition(date, 1000, date), date + 1);
+    EXPECT_FALSE(StatusDeadlines::nextTransition(date, 1000, date + 1));
+
+    // Relation really changes at each transition.
+    TaskDateTime<ETaskDateTimeRole::Due> due(kNow.addSecs(3600 * 48));
+    const auto dueMs = due->toMSecsSinceEpoch();
+    const auto first = StatusDeadlines::nextTransition(dueMs, kDueWarningMs,
+                                                       kNowMs);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(due.relationToNow(QDateTime::fromMSecsSinceEpoch(*first - 1)),
+              DatesRelation::Future);
+    EXPECT_EQ(due.relationToNow(QDateTime::fromMSecsSinceEpoch(*first)),
+              DatesRelation::Approaching);
+    const auto second =
+        StatusDeadlines::nextTransition(dueMs, kDueWarningMs, *first);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(due.relationToNow(QDateTime::fromMSecsSinceEpoch(*second - 1)),
+              DatesRelation::Approaching);
+    EXPECT_EQ(due.relationToNow(QDateTime::fromMSecsSinceEpoch(*second)),
+              DatesRelation::Past);
+}
+
+TEST(StatusDeadlinesTest, PassedDeadlinesGiveAffectedRows)
+{
+    const QList<DetailedTaskInfo> tasks = {
+        makeTask(),
+        makeTask().due(kNow.addSecs(-60)),
+        makeTask().due(kNow.addSecs(60)).sched(kNow.addSecs(30)),
+        makeTask().due(kNow.addDays(3)),
+    };
+    StatusDeadlines deadlines;
+    deadlines.rebuild(tasks, kNowMs);
+
+    // Sched of the 3rd task is approaching already, it is past after 30s.
+    ASSERT_EQ(deadlines.next(), kNowMs + 30000 + 1);
+    EXPECT_TRUE(deadlines.takePassed(kNowMs + 30000).rows.isEmpty());
+    EXPECT_EQ(deadlines.takePassed(kNowMs + 60000 + 1).rows,
+              QList<int>({ 2 }));
+
+    EXPECT_EQ(deadlines.next(),
+              kNow.addDays(3).toMSecsSinceEpoch() - kDueWarningMs);
+    EXPECT_EQ(deadlines.takePassed(kNow.addDays(4).toMSecsSinceEpoch()).rows,
+              QList<int>({ 3 }));
+    EXPECT_FALSE(deadlines.next().has_value());
+    static_assert(kSchedWarningMs < kDueWarningMs);
+}
+
+TEST(StatusDeadlinesTest, OnlyPassedSchedAndWaitReorder)
+{
+    const QList<DetailedTaskInfo> tasks = {
+        makeTask().due(kNow.addSecs(60)),
+        makeTask().sched(kNow.addDays(3)),
+    };
+    StatusDeadlines deadlines;
+    deadlines.rebuild(tasks, kNowMs);
+
+    // Due only changes color, its urgency grows smoothly.
+    const auto due = deadlines.takePassed(kNowMs + 60000 + 1);
+    EXPECT_EQ(due.rows, QList<int>({ 0 }));
+    EXPECT_FALSE(due.reorders);
+
+    const auto schedMs = kNow.addDays(3).toMSecsSinceEpoch();
+    const auto approaching = deadlines.takePassed(schedMs - kSchedWarningMs);
+    EXPECT_EQ(approaching.rows, QList<int>({ 1 }));
+    EXPECT_FALSE(approaching.reorders);
+    EXPECT_TRUE(deadlines.takePassed(schedMs + 1).reorders);
+}
+} // namespace Test
@@ -0,0 +1,55 @@
+#include "string_intern_pool.hpp"
+
+#include <QString>
+#include <QStringList>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace Test
+{
+TEST(StringInternPoolTest, EqualStringsShareData)
+{
+    const auto first = StringInternPool::intern(QString("pro") + "ject");
+    const auto second = StringInternPool::intern(QString("proj") + "ect");
+    EXPECT_EQ(first, "project");
+    EXPECT_EQ(first.constData(), second.constData());
+
+    const auto tags = StringInternPool::intern(QStringList{ "a", "project" });
+    EXPECT_EQ(tags.at(1).constData(), first.constData());
+    EXPECT_TRUE(StringInternPool::intern(QString()).isEmpty());
+}
+
+TEST(StringInternPoolTest, LocalScopeIsMergedOnce)
+{
+    QString local;
+    QString other;
+    {
+        const StringInternPool::LocalScope scope;
+        local = StringInternPool::intern(QString("lo") + "cal");
+        EXPECT_EQ(StringInternPool::intern(QString("loc") + "al").constData(),
+                  local.constData());
+        // Other threads do not see the local pool.
+        std::thread([&other]() {
+            other = StringInternPool::intern(QString("l") + "ocal");
+        }).join();
+        EXPECT_NE(other.constData(), local.constData());
+    }
+    // The string which was in the pool before the merge is kept.
+    EXPECT_EQ(StringInternPool::intern(QString("loca") + "l").constData(),
+              other.constData());
+}
+
+TEST(StringInternPoolTest, EvictsNotReferencedStrings)
+{
+    auto kept = StringInternPool::intern(QString("ke") + "pt");
+    static_cast<void>(StringInternPool::intern(QString("drop") + "ped"));
+    const auto size = StringInternPool::size();
+
+    StringInternPool::evictUnused();
+    EXPECT_LT(StringInternPool::size(), size);
+    EXPECT_EQ(StringInternPool::intern(QString("kep") + "t").constData(),
+              kept.constData());
+}
+} // namespace Test
@@ -1,5 +1,6 @@
 #include "task_table_stencil.hpp"
 
+#include <QByteArrayView>
 #include <QString>
 #include <QStringList>
 #include <qtypes.h>
@@ -110,4 +111,38 @@ TEST_F(TableStencilTest, ThrowsOnUninitialized)
                                    const QString &) {};
     EXPECT_THROW(query.forEachColumn("some data", handler), std::runtime_error);
 }
+
+TEST_F(TableStencilTest, RawColumnsAreViews)
+{
+    TableStencil query({ "ID", "Proj", "Desc" });
+    ASSERT_TRUE(query.processLabelString("   |      |"));
+
+    const QByteArrayView line = "5  Living Купить хлеб";
+    std::vector<QByteArrayView> res;
+    ASSERT_TRUE(query.forEachRawColumn(
+        line, [&res](qsizetype, const QString &, QByteArrayView val) {
+            res.emplace_back(val);
+        }));
+
+    ASSERT_EQ(res.size(), 3);
+    EXPECT_EQ(res[0], "5");
+    EXPECT_EQ(res[1], "Living");
+    EXPECT_EQ(res[2], "Купить хлеб");
+    EXPECT_GE(res[2].data(), line.data());
+    EXPECT_LT(res[2].data(), line.data() + line.size());
+}
+
+TEST_F(TableStencilTest, RawColumnsRejectUnicodeBeforeLastColumn)
+{
+    TableStencil query({ "ID", "Proj", "Desc" });
+    ASSERT_TRUE(query.processLabelString("   |      |"));
+
+    bool called = false;
+    EXPECT_FALSE(query.forEachRawColumn(
+        QByteArrayView("5  Дом    Salary"),
+        [&called](qsizetype, const QString &, QByteArrayView) {
+            called = true;
+        }));
+    EXPECT_FALSE(called);
+}
 } // namespace Test
@@ -1,9 +1,21 @@
 #include "tabular_stencil_base.hpp" // Твой хедер
+#include "split_string.hpp"
 
 #include <gtest/gtest.h>
 
+#include "bench_timer.hpp"
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDate>
+#include <QDateTime>
 #include <QString>
 #include <QStringList>
+#include <QThread>
+#include <QThreadPool>
+#include <QTime>
+
+#include <string>
 
 namespace Test
 {
@@ -17,7 +29,8 @@ struct TestTask {
 class TabularStencilSpy : public TabularStencilBase<TestTask> {
   public:
     // Making method to test as public
-    using TabularStencilBase<TestTask>::parseConsoleOutput;
+    using TabularStencilBase<TestTask>::parseRawConsoleOutput;
+    using TabularStencilBase<TestTask>::parseTableDateTime;
     using ColumnsSchema = TabularStencilBase<TestTask>::ColumnsSchema;
     using Mode = TabularStencilBase<TestTask>::ColumnDescriptor::LineMode;
 
@@ -42,6 +55,14 @@ class TabularParserTest : public ::testing::Test {
     TabularStencilSpy::ColumnsSchema schema;
     using Mode = TabularStencilSpy::Mode;
 
+    /// @returns records of @p output lines, parsed as `task` printed those.
+    TabularStencilSpy::Response parse(const TableStencil &stencil,
+                                      const QStringList &output) const
+    {
+        const QByteArray raw = output.join('\n').toUtf8();
+        return spy.parseRawConsoleOutput(schema, stencil, splitRawLines(raw));
+    }
+
     void SetUp() override
     {
         schema = { { "ID",
@@ -54,7 +75,7 @@ class TabularParserTest : public ::testing::Test {
                    { "Proj",
                      [](const QString &v, TestTask &t, Mode m) {
                          if (m == Mode::FirstLineOfNewRecord) {
-                             t.project = v;
+                             t.set(t.project, v);
                          }
                      } },
                    { "Desc", [](const QString &v, TestTask &t, Mode) {
@@ -78,7 +99,7 @@ TEST_F(TabularParserTest, HandlesSimpleOutput)
         "2   Home Clean room",   // Data 2
     };
 
-    auto result = spy.parseConsoleOutput(schema, stencil, mockOutput);
+    auto result = parse(stencil, mockOutput);
 
     ASSERT_EQ(result.size(), 2);
     EXPECT_EQ(result[0].id, 1);
@@ -100,7 +121,7 @@ TEST_F(TabularParserTest, HandlesMultilineContinuation)
         "2   Home Next task",
     };
 
-    auto result = spy.parseConsoleOutput(schema, stencil, mockOutput);
+    auto result = parse(stencil, mockOutput);
 
     ASSERT_EQ(result.size(), 2);
     EXPECT_EQ(result[0].id, 1);
@@ -122,7 +143,7 @@ TEST_F(TabularParserTest, SkipsEmptyLines)
         "2   Home Task 2",
     };
 
-    auto result = spy.parseConsoleOutput(schema, stencil, mockOutput);
+    auto result = parse(stencil, mockOutput);
 
     ASSERT_EQ(result.size(), 2);
     EXPECT_EQ(result[0].id, 1);
@@ -143,9 +164,146 @@ TEST_F(TabularParserTest, HandlesImpossibleContinuationGracefully)
         "2   Home Valid task",
     };
 
-    auto result = spy.parseConsoleOutput(schema, stencil, mockOutput);
+    auto result = parse(stencil, mockOutput);
 
     ASSERT_EQ(result.size(), 1);
     EXPECT_EQ(result[0].id, 2) << "First boken row had to be ignored.";
 }
+
+TEST_F(TabularParserTest, NonAsciiColumnsAreDecoded)
+{
+    TableStencil stencil({ "ID", "Proj", "Desc" });
+    ASSERT_TRUE(stencil.processLabelString("----|----|-----------"));
+
+    const QByteArray output = "----|----|-----------\n"
+                              "ID  Proj Desc\n"
+                              "1   Work Long task\n"
+                              "         description\n"
+                              "\n"
+                              "2   Home Задача\n"
+                              "3   Дом  Next\n";
+
+    const auto raw =
+        spy.parseRawConsoleOutput(schema, stencil, splitRawLines(output));
+
+    ASSERT_EQ(raw.size(), 3);
+    EXPECT_EQ(raw[0].id, 1);
+    EXPECT_EQ(raw[0].project, "Work");
+    EXPECT_EQ(raw[0].description, "Long task description");
+    EXPECT_EQ(raw[1].description, "Задача");
+    EXPECT_EQ(raw[2].project, "Дом") << "Non-ASCII column must be decoded.";
+    EXPECT_EQ(raw[2].description, "Next");
+}
+
+TEST_F(TabularParserTest, RawHandlerIsPreferred)
+{
+    schema.front().raw_handler = [](QByteArrayView v, TestTask &t, Mode m) {
+        if (m == Mode::FirstLineOfNewRecord) {
+            t.id = v.toInt() * 10;
+        }
+    };
+    TableStencil stencil({ "ID", "Proj", "Desc" });
+    ASSERT_TRUE(stencil.processLabelString("----|----|-----------"));
+
+    const QByteArray output = "----|----|-----------\n"
+                              "ID  Proj Desc\n"
+                              "1   Work Task\n";
+    const auto raw =
+        spy.parseRawConsoleOutput(schema, stencil, splitRawLines(output));
+
+    ASSERT_EQ(raw.size(), 1);
+    EXPECT_EQ(raw[0].id, 10);
+}
+
+TEST_F(TabularParserTest, ParsesTableDateTime)
+{
+    EXPECT_EQ(TabularStencilSpy::parseTableDateTime(" 2025-11-04T09:08:07 "),
+              QDateTime(QDate(2025, 11, 4), QTime(9, 8, 7)));
+    EXPECT_FALSE(
+        TabularStencilSpy::parseTableDateTime("2025-02-30T00:00:00").isValid());
+    EXPECT_FALSE(
+        TabularStencilSpy::parseTableDateTime("2025-11-04 00:00:00").isValid());
+    EXPECT_FALSE(TabularStencilSpy::parseTableDateTime("").isValid());
+}
+
+namespace
+{
+/// @returns table where each 3rd task has description over 3 lines.
+QByteArray makeLongTable(int tasks)
+{
+    QByteArray output = "-----|------------|-----\nID   Proj         Desc\n";
+    for (int i = 1; i <= tasks; ++i) {
+        output += QByteArray::number(i).leftJustified(5, ' ') +
+                  QByteArray("work.sub").leftJustified(13, ' ') +
+                  "Some long enough description of the task\n";
+        if (i % 3 == 0) {
+            output += "                  which continues\n"
+                      "                  over lines\n";
+        }
+    }
+    return output;
+}
+} // namespace
+
+TEST_F(TabularParserTest, ParallelParseKeepsRecordsAndOrder)
+{
+    TableStencil stencil({ "ID", "Proj", "Desc" });
+    ASSERT_TRUE(stencil.processLabelString("-----|------------|-----"));
+
+    const auto tasks =
+        static_cast<int>(OrderedChunks::kParallelMinItems);
+    const QByteArray output = makeLongTable(tasks);
+    const auto lines = splitRawLines(output);
+
+    QThreadPool serialPool;
+    serialPool.setMaxThreadCount(1);
+    QThreadPool parallelPool;
+    // Chunk borders will fall into continuation lines for sure.
+    parallelPool.setMaxThreadCount(7);
+
+    const auto serial =
+        spy.parseRawConsoleOutput(schema, stencil, lines, &serialPool);
+    const auto parallel =
+        spy.parseRawConsoleOutput(schema, stencil, lines, &parallelPool);
+
+    ASSERT_EQ(serial.size(), tasks);
+    ASSERT_EQ(parallel.size(), tasks);
+    for (qsizetype i = 0; i < tasks; ++i) {
+        EXPECT_EQ(parallel[i].id, i + 1);
+        EXPECT_EQ(parallel[i].description, serial[i].description);
+    }
+    EXPECT_EQ(parallel[2].description,
+              "Some long enough description of the task which continues "
+              "over lines");
+}
+
+// OrderedChunks thresholds are checked here: at kParallelMinItems tasks the
+// threads should already win over the single one.
+TEST_F(TabularParserTest, DISABLED_BenchmarkParallelScaling)
+{
+    TableStencil stencil({ "ID", "Proj", "Desc" });
+    ASSERT_TRUE(stencil.processLabelString("-----|------------|-----"));
+
+    for (const auto tasks :
+         { static_cast<int>(OrderedChunks::kParallelMinItems), 100000 }) {
+        const QByteArray output = makeLongTable(tasks);
+        const auto lines = splitRawLines(output);
+
+        for (int threads = 1; threads <= QThread::idealThreadCount();
+             threads *= 2) {
+            QThreadPool pool;
+            pool.setMaxThreadCount(threads);
+            qsizetype parsed = 0;
+            const double ms = Bench::measureMs([&]() {
+                parsed = spy.parseRawConsoleOutput(schema, stencil, lines,
+                                                   &pool)
+                             .size();
+            });
+            EXPECT_EQ(parsed, tasks);
+            Bench::report("parallel table x" + std::to_string(tasks) +
+                              ", threads " + std::to_string(threads),
+                          ms);
+        }
+    }
+}
 } // namespace Test
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "task.hpp"
+
+#include <QDateTime>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QUuid>
+
+namespace Test
+{
+/// @brief Builds DetailedTaskInfo for tests, properties which are not set
+/// keep defaults. It converts to the task implicitly, so it is used right
+/// where task is expected:
+/// @code
+/// tasks << makeTask("uuid-1").description("Buy milk").project("Home");
+/// @endcode
+class TaskBuilder {
+  public:
+    explicit TaskBuilder(const QString &uuid) { m_task.task_uuid = uuid; }
+
+    TaskBuilder &id(int id)
+    {
+        m_task.task_id = QString::number(id);
+        return *this;
+    }
+
+    TaskBuilder &description(const QString &description)
+    {
+        m_task.set(m_task.description, description);
+        return *this;
+    }
+
+    TaskBuilder &project(const QString &project)
+    {
+        m_task.set(m_task.project, project);
+        return *this;
+    }
+
+    TaskBuilder &tags(const QStringList &tags)
+    {
+        m_task.set(m_task.tags, tags);
+        return *this;
+    }
+
+    TaskBuilder &urgency(double urgency)
+    {
+        m_task.urgency = urgency;
+        return *this;
+    }
+
+    TaskBuilder &depends(const QStringList &uuids)
+    {
+        m_task.depends = uuids;
+        return *this;
+    }
+
+    TaskBuilder &modified(const QDateTime &modified)
+    {
+        m_task.modified = modified;
+        return *this;
+    }
+
+    /// @note Invalid @p due leaves task without due date.
+    TaskBuilder &due(const QDateTime &due)
+    {
+        if (due.isValid()) {
+            m_task.set(m_task.due, due);
+        }
+        return *this;
+    }
+
+    /// @note Invalid @p sched leaves task without scheduled date.
+    TaskBuilder &sched(const QDateTime &sched)
+    {
+        if (sched.isValid()) {
+            m_task.set(m_task.sched, sched);
+        }
+        return *this;
+    }
+
+    /// @brief Marks task as read by `task information`, what needs known
+    /// recurrence.
+    TaskBuilder &fullRead()
+    {
+        m_task.modify(m_task.recurrency_period,
+                      [](RecurrentInstancePeriod &period) {
+                          period.setNonRecurrent();
+                      });
+        m_task.markFullRead();
+        return *this;
+    }
+
+    // NOLINTNEXTLINE(google-explicit-constructor)
+    operator DetailedTaskInfo() const { return m_task; }
+
+  private:
+    DetailedTaskInfo m_task;
+};
+
+/// @returns builder of the task with @p uuid.
+[[nodiscard]]
+inline TaskBuilder makeTask(const QString &uuid = {})
+{
+    return TaskBuilder(uuid);
+}
+
+/// @returns @p count tasks with random uuids and nothing else set.
+[[nodiscard]]
+inline QList<DetailedTaskInfo> makeTasks(int count)
+{
+    QList<DetailedTaskInfo> tasks;
+    for (int i = 0; i < count; ++i) {
+        tasks << makeTask(QUuid::createUuid().toString(QUuid::WithoutBraces));
+    }
+    return tasks;
+}
+} // namespace Test
@@ -0,0 +1,66 @@
+#include "task_changes_coalescer.hpp"
+
+#include <QByteArray>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+namespace
+{
+QByteArray taskLine(const QString &uuid, const QString &status,
+                    const QString &description)
+{
+    return QString(R"({"uuid":"%1","status":"%2","description":"%3"})"
+                   "\n")
+        .arg(uuid, status, description)
+        .toUtf8();
+}
+} // namespace
+
+TEST(TaskChangesCoalescerTest, KeepsLatestStatePerTaskInFirstSeenOrder)
+{
+    TaskChangesCoalescer coalescer;
+    coalescer.feed(taskLine("a", "pending", "first") +
+                   taskLine("b", "pending", "second") +
+                   taskLine("a", "completed", "first done"));
+    ASSERT_EQ(coalescer.size(), 2);
+
+    const auto batch = coalescer.take();
+    EXPECT_TRUE(batch.complete);
+    EXPECT_EQ(batch.calls, 3);
+    ASSERT_EQ(batch.changes.size(), 2);
+    EXPECT_EQ(batch.changes.at(0).uuid, "a");
+    EXPECT_EQ(batch.changes.at(0).status, "completed");
+    EXPECT_TRUE(batch.changes.at(0).json.contains("first done"));
+    EXPECT_EQ(batch.changes.at(1).uuid, "b");
+
+    EXPECT_EQ(coalescer.size(), 0);
+    EXPECT_TRUE(coalescer.take().changes.isEmpty());
+}
+
+TEST(TaskChangesCoalescerTest, LineSplitBetweenChunksIsKept)
+{
+    TaskChangesCoalescer coalescer;
+    const auto line = taskLine("a", "pending", "split");
+    coalescer.feed(line.first(10));
+    EXPECT_EQ(coalescer.size(), 0);
+    coalescer.feed(line.sliced(10));
+    ASSERT_EQ(coalescer.size(), 1);
+    EXPECT_EQ(coalescer.take().changes.first().json, line.chopped(1));
+}
+
+TEST(TaskChangesCoalescerTest, BrokenLineMakesBatchIncomplete)
+{
+    TaskChangesCoalescer coalescer;
+    coalescer.feed("{\"status\":\"pending\"}\nnot json\n\n" +
+                   taskLine("a", "pending", "ok"));
+    const auto batch = coalescer.take();
+    EXPECT_FALSE(batch.complete);
+    ASSERT_EQ(batch.changes.size(), 1);
+    EXPECT_EQ(batch.changes.first().uuid, "a");
+
+    EXPECT_TRUE(coalescer.take().complete);
+}
+} // namespace Test
@@ -1,12 +1,17 @@
+#include "bench_timer.hpp"
 #include "task_date_time.hpp"
 
 #include <QDateTime>
 #include <QString>
+#include <QStringList>
+#include <QStringView>
+#include <QTimeZone>
 #include <qnamespace.h>
 
 #include <gtest/gtest.h>
 #include <stdexcept>
 #include <utility>
+#include <vector>
 
 namespace Test
 {
@@ -139,4 +144,107 @@ INSTANTIATE_TEST_SUITE_P(
                       TaskDateTimeTestCase{ ETaskDateTimeRole::Due, "due" },
                       TaskDateTimeTestCase{ ETaskDateTimeRole::Wait, "wait" }));
 
+TEST(FixedWidthDateTest, ExportFormatIsEpochMSecs)
+{
+    EXPECT_EQ(FixedWidthDate::parseExportMSecs(u"19700101T000000Z"), 0);
+    EXPECT_EQ(FixedWidthDate::parseExportMSecs(u"20240229T235959Z"),
+              QDateTime(QDate(2024, 2, 29), QTime(23, 59, 59),
+                        QTimeZone::utc())
+                  .toMSecsSinceEpoch());
+    EXPECT_EQ(FixedWidthDate::parseExportMSecs(u"19691231T235959Z"), -1000);
+    EXPECT_FALSE(FixedWidthDate::parseExportMSecs(u"20230229T000000Z"));
+    EXPECT_FALSE(FixedWidthDate::parseExportMSecs(u"20240101T240000Z"));
+    EXPECT_FALSE(FixedWidthDate::parseExportMSecs(u"2024-02-29T00:00"));
+}
+
+TEST(FixedWidthDateTest, LocalFormatMatchesIsoDate)
+{
+    EXPECT_EQ(FixedWidthDate::parseLocalDateTime(u"2025-11-04", u"09:30:15"),
+              QDateTime::fromString("2025-11-04T09:30:15", Qt::ISODate));
+    EXPECT_FALSE(
+        FixedWidthDate::parseLocalDateTime(u"2025-02-30", u"00:00:00")
+            .isValid());
+    EXPECT_FALSE(
+        FixedWidthDate::parseLocalDateTime(u"2025-1-04", u"00:00:00")
+            .isValid());
+}
+
+TEST(TaskDateTimeEpochTest, KeepsMSecsAndConvertsOnRequest)
+{
+    const QDateTime when(QDate(2025, 12, 22), QTime(12, 0, 0, 250));
+    const TaskDateTime<ETaskDateTimeRole::Due> dt(when);
+    EXPECT_EQ(dt.toMSecsSinceEpoch(), when.toMSecsSinceEpoch());
+    EXPECT_EQ(*dt, when);
+    EXPECT_EQ(dt->date(), when.date());
+    EXPECT_EQ(dt, TaskDateTime<ETaskDateTimeRole::Due>::fromMSecsSinceEpoch(
+                      when.toMSecsSinceEpoch()));
+
+    EXPECT_FALSE(TaskDateTime<ETaskDateTimeRole::Due>(QDateTime()).has_value());
+    EXPECT_EQ(dt.relationToNow(when.toMSecsSinceEpoch() + 1),
+              DatesRelation::Past);
+    EXPECT_EQ(dt.relationToNow(when.toMSecsSinceEpoch()),
+              DatesRelation::Approaching);
+}
+
+TEST(TaskDateTimeEpochTest, DISABLED_BenchmarkParseAndRelationOf100k)
+{
+    constexpr int kCount = 100000;
+    QStringList exported;
+    QStringList local;
+    for (int i = 0; i < kCount; ++i) {
+        const auto dt =
+            QDateTime(QDate(2025, 1, 1), QTime(0, 0), QTimeZone::utc())
+                .addSecs(i * 397LL);
+        exported << dt.toString("yyyyMMddTHHmmssZ");
+        local << dt.toLocalTime().toString(Qt::ISODate);
+    }
+
+    qint64 sum = 0;
+    Bench::report("QDateTime::fromString ISO 100k", Bench::measureMs([&]() {
+                      for (const auto &text : local) {
+                          sum += QDateTime::fromString(text, Qt::ISODate)
+                                     .toMSecsSinceEpoch();
+                      }
+                  }));
+    Bench::report("fixed width local date and time 100k",
+                  Bench::measureMs([&]() {
+                      for (const auto &text : local) {
+                          const QStringView view(text);
+                          sum += FixedWidthDate::parseLocalDateTime(
+                                     view.left(10), view.mid(11, 8))
+                                     .toMSecsSinceEpoch();
+                      }
+                  }));
+    Bench::report("fixed width export to epoch 100k", Bench::measureMs([&]() {
+                      for (const auto &text : exported) {
+                          sum += *FixedWidthDate::parseExportMSecs(text);
+                      }
+                  }));
+
+    std::vector<TaskDateTime<ETaskDateTimeRole::Due>> dates;
+    dates.reserve(kCount);
+    for (const auto &text : exported) {
+        dates.push_back(TaskDateTime<ETaskDateTimeRole::Due>::
+                            fromMSecsSinceEpoch(
+                                *FixedWidthDate::parseExportMSecs(text)));
+    }
+    int past = 0;
+    Bench::report("relationToNow(QDateTime::currentDateTime) 100k",
+                  Bench::measureMs([&]() {
+                      for (const auto &dt : dates) {
+                          past += dt.relationToNow(
+                                      QDateTime::currentDateTime()) ==
+                                  DatesRelation::Past;
+                      }
+                  }));
+    Bench::report("relationToNow(cached now) 100k", Bench::measureMs([&]() {
+                      const qint64 now = QDateTime::currentMSecsSinceEpoch();
+                      for (const auto &dt : dates) {
+                          past += dt.relationToNow(now) == DatesRelation::Past;
+                      }
+                  }));
+    EXPECT_NE(sum, 0);
+    EXPECT_GT(past, 0);
+}
+
 } // namespace Test
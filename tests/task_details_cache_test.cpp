@@ -0,0 +1,57 @@
+#include "task.hpp"
+#include "task_builder.hpp"
+#include "task_details_cache.hpp"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+TEST(TaskDetailsCacheTest, LoadingTasksAreNotRequestedTwice)
+{
+    TaskDetailsCache cache;
+    EXPECT_EQ(cache.takeMissing({ "a", "b", "" }), QStringList({ "a", "b" }));
+    EXPECT_EQ(cache.takeMissing({ "a", "b", "c" }), QStringList({ "c" }));
+
+    cache.store(cache.generation(), { "a", "b" },
+                QList<DetailedTaskInfo>{ makeTask("a").fullRead() });
+    ASSERT_NE(cache.find("a"), nullptr);
+    EXPECT_EQ(cache.find("b"), nullptr);
+    // "b" was not exported, it can be requested again.
+    EXPECT_EQ(cache.takeMissing({ "a", "b" }), QStringList({ "b" }));
+}
+
+TEST(TaskDetailsCacheTest, BatchIsLimited)
+{
+    TaskDetailsCache cache;
+    QStringList wanted;
+    for (int i = 0; i < TaskDetailsCache::kMaxBatchSize + 10; ++i) {
+        wanted << QString("uuid-%1").arg(i);
+    }
+    EXPECT_EQ(cache.takeMissing(wanted).size(),
+              TaskDetailsCache::kMaxBatchSize);
+    EXPECT_EQ(cache.takeMissing(wanted).size(), 10);
+}
+
+TEST(TaskDetailsCacheTest, InvalidationDropsStartedBatches)
+{
+    TaskDetailsCache cache;
+    const auto requested = cache.takeMissing({ "a" });
+    const auto generation = cache.generation();
+    cache.invalidate();
+    cache.store(generation, requested,
+                QList<DetailedTaskInfo>{ makeTask("a").fullRead() });
+    EXPECT_EQ(cache.find("a"), nullptr);
+
+    // Partially read task is never kept.
+    DetailedTaskInfo partial;
+    partial.task_uuid = "a";
+    EXPECT_EQ(cache.takeMissing({ "a" }), QStringList({ "a" }));
+    cache.store(cache.generation(), { "a" },
+                QList<DetailedTaskInfo>{ partial });
+    EXPECT_EQ(cache.find("a"), nullptr);
+}
+} // namespace Test
@@ -0,0 +1,76 @@
+#include "task_urgency.hpp"
+
+#include <QtGlobal>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+class TaskUrgencyTest : public ::testing::Test {
+  protected:
+    static constexpr qint64 kNow = 1767225600; // 2026-01-01T00:00:00Z
+    static constexpr qint64 kDay = 86400;
+};
+
+TEST_F(TaskUrgencyTest, EmptyTaskHasZeroUrgency)
+{
+    EXPECT_DOUBLE_EQ(TaskUrgency::compute({}, kNow), 0.0);
+}
+
+TEST_F(TaskUrgencyTest, SimpleCoefficients)
+{
+    UrgencyInputs in;
+    in.priority = UrgencyInputs::Priority::H;
+    in.has_project = true;
+    in.active = true;
+    EXPECT_DOUBLE_EQ(TaskUrgency::compute(in, kNow), 6.0 + 1.0 + 4.0);
+
+    in = {};
+    in.has_next_tag = true;
+    in.tags_count = 1;
+    EXPECT_DOUBLE_EQ(TaskUrgency::compute(in, kNow), 15.0 + 0.8);
+
+    in = {};
+    in.blocked = true;
+    in.waiting = true;
+    EXPECT_DOUBLE_EQ(TaskUrgency::compute(in, kNow), -5.0 - 3.0);
+}
+
+TEST_F(TaskUrgencyTest, TagsAndAnnotationsAreScaled)
+{
+    UrgencyInputs in;
+    in.tags_count = 2;
+    in.annotations_count = 5;
+    EXPECT_DOUBLE_EQ(TaskUrgency::compute(in, kNow), 0.9 + 1.0);
+}
+
+TEST_F(TaskUrgencyTest, DueIsScaledLinearly)
+{
+    UrgencyInputs in;
+    in.due = kNow + 30 * kDay;
+    EXPECT_DOUBLE_EQ(TaskUrgency::compute(in, kNow), 12.0 * 0.2);
+
+    in.due = kNow - 7 * kDay;
+    EXPECT_DOUBLE_EQ(TaskUrgency::compute(in, kNow), 12.0);
+
+    // Due now: 14 of 21 days passed.
+    in.due = kNow;
+    EXPECT_NEAR(TaskUrgency::compute(in, kNow),
+                12.0 * (14.0 * 0.8 / 21.0 + 0.2), 1e-9);
+}
+
+TEST_F(TaskUrgencyTest, ScheduledAndAge)
+{
+    UrgencyInputs in;
+    in.scheduled = kNow + kDay;
+    EXPECT_DOUBLE_EQ(TaskUrgency::compute(in, kNow), 0.0);
+    in.scheduled = kNow - kDay;
+    EXPECT_DOUBLE_EQ(TaskUrgency::compute(in, kNow), 5.0);
+
+    in = {};
+    in.entry = kNow - 73 * kDay;
+    EXPECT_NEAR(TaskUrgency::compute(in, kNow), 2.0 * 73.0 / 365.0, 1e-9);
+    in.entry = kNow - 1000 * kDay;
+    EXPECT_DOUBLE_EQ(TaskUrgency::compute(in, kNow), 2.0);
+}
+} // namespace Test
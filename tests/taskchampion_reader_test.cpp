@@ -0,0 +1,103 @@
+#include "allatoncekeywordsfinder.hpp"
+#include "taskchampion_reader.hpp"
+
+#include <QDateTime>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QVariant>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace Test
+{
+namespace
+{
+/// @brief Creates TaskChampion database with @p tasks as (uuid, data JSON,
+/// working set id or 0).
+QString makeDatabase(const QTemporaryDir &dir,
+                     const QList<std::tuple<QString, QString, int>> &tasks)
+{
+    const QString path = dir.filePath("taskchampion.sqlite3");
+    {
+        auto db = QSqlDatabase::addDatabase("QSQLITE", "fixture");
+        db.setDatabaseName(path);
+        EXPECT_TRUE(db.open());
+        QSqlQuery query(db);
+        EXPECT_TRUE(query.exec(
+            "CREATE TABLE tasks (uuid STRING PRIMARY KEY, data STRING)"));
+        EXPECT_TRUE(query.exec("CREATE TABLE working_set "
+                               "(id INTEGER PRIMARY KEY, uuid STRING)"));
+        for (const auto &[uuid, data, id] : tasks) {
+            query.prepare("INSERT INTO tasks VALUES (?, ?)");
+            query.addBindValue(uuid);
+            query.addBindValue(data);
+            EXPECT_TRUE(query.exec());
+            if (id > 0) {
+                query.prepare("INSERT INTO working_set VALUES (?, ?)");
+                query.addBindValue(id);
+                query.addBindValue(uuid);
+                EXPECT_TRUE(query.exec());
+            }
+        }
+    }
+    QSqlDatabase::removeDatabase("fixture");
+    return path;
+}
+} // namespace
+
+TEST(TaskChampionReaderTest, ReadsPendingTasksOfWorkingSet)
+{
+    const QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const auto path = makeDatabase(
+        dir,
+        {
+            { "11111111-1111-1111-1111-111111111111",
+              R"({"status":"pending","description":" Buy milk ",)"
+              R"("project":"home","tag_shop":"","tag_next":"",)"
+              R"("due":"1767225600","entry":"1767000000"})",
+              2 },
+            { "22222222-2222-2222-2222-222222222222",
+              R"({"status":"completed","description":"Done"})", 0 },
+            { "33333333-3333-3333-3333-333333333333",
+              R"({"status":"pending","description":"Call","priority":"H"})",
+              1 },
+        });
+
+    const TaskChampionReader reader(path);
+    const auto tasks =
+        reader.readUrgencySortedTasks(AllAtOnceKeywordsFinder({}));
+    ASSERT_TRUE(tasks.has_value());
+    ASSERT_EQ(tasks->size(), 2);
+
+    const auto milk = std::find_if(
+        tasks->cbegin(), tasks->cend(),
+        [](const auto &task) { return task.task_id == "2"; });
+    ASSERT_NE(milk, tasks->cend());
+    EXPECT_EQ(milk->task_uuid, "11111111-1111-1111-1111-111111111111");
+    EXPECT_EQ(milk->description.get(), "Buy milk");
+    EXPECT_EQ(milk->project.get(), "home");
+    auto tags = milk->tags.get();
+    tags.sort();
+    EXPECT_EQ(tags, QStringList({ "next", "shop" }));
+    ASSERT_TRUE(milk->due.get().has_value());
+    EXPECT_EQ(milk->due.get().toMSecsSinceEpoch(), 1767225600000LL);
+    EXPECT_FALSE(milk->isModified(milk->description));
+
+    EXPECT_GE(tasks->first().urgency, tasks->last().urgency);
+}
+
+TEST(TaskChampionReaderTest, MissingDatabaseIsNotRead)
+{
+    const QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const TaskChampionReader reader(dir.filePath("absent.sqlite3"));
+    EXPECT_FALSE(
+        reader.readUrgencySortedTasks(AllAtOnceKeywordsFinder({})).has_value());
+}
+} // namespace Test
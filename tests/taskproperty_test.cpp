@@ -1,88 +1,139 @@
 #include "taskproperty.hpp"
+#include "task.hpp"
+
+#include <QJsonArray>
+#include <QJsonValue>
+#include <QString>
+#include <QStringList>
 
 #include <gtest/gtest.h>
 
-#include <cstdint>
-#include <stdexcept>
-#include <tuple>
+#include <algorithm>
+#include <cstddef>
 
 namespace Test
 {
 using TaskPropertyTest = ::testing::Test;
 
-template <typename taType>
-QStringList getValidStrings(const TaskProperty<taType> &prop)
+TEST_F(TaskPropertyTest, CallingModifySetsFlag)
 {
-    QStringList res;
-    EXPECT_NO_THROW(res = prop.getStringsForCmd());
-    return res;
+    ModTrackingProperty<int> prop(2);
+    EXPECT_FALSE(prop.isModified());
+    prop.modify([](auto &) {});
+    EXPECT_TRUE(prop.isModified());
 }
 
-TEST_F(TaskPropertyTest, ThrowsIfQStringArgNotSupported)
+TEST_F(TaskPropertyTest, ValueCanBeSetAndModificationReset)
 {
-    enum class UnsupportedEnum : std::uint8_t { Value1, Value2 };
-    const TaskProperty<UnsupportedEnum> prop("value: %1",
-                                             UnsupportedEnum::Value1);
-    EXPECT_THROW(std::ignore = prop.getStringsForCmd(), std::runtime_error);
-}
+    DetailedTaskInfo task;
+    task.set(task.project, QString("home"));
+    task.setNotModified(task.project);
+    EXPECT_FALSE(task.isModified(task.project));
+    EXPECT_EQ(task.project.get(), "home");
 
-TEST_F(TaskPropertyTest, WorksIfQStringArgSupported)
-{
-    const TaskProperty<int> prop("value: %1", 2);
-    const auto list = getValidStrings(prop);
-    EXPECT_EQ(list.size(), 1u);
-    EXPECT_EQ(list.first(), QString("value: 2"));
+    task.set(task.project, QString("work"));
+    EXPECT_TRUE(task.isModified(task.project));
+    EXPECT_EQ(task.project.get(), "work");
+
+    task.setNotModified(task.project);
+    EXPECT_FALSE(task.isModified(task.project));
+    EXPECT_EQ(task.project.get(), "work");
 }
 
-TEST_F(TaskPropertyTest, WorksWithFormatterToQString)
+TEST_F(TaskPropertyTest, FlagsAreSeparatedAndCopyKeepsThem)
 {
-    static constexpr int kExpectedValue = 71;
+    DetailedTaskInfo task;
+    task.set(task.description, QString("Buy milk"));
+    task.modify(task.tags, [](QStringList &tags) { tags << "shop"; });
+    EXPECT_TRUE(task.isModified(task.description));
+    EXPECT_TRUE(task.isModified(task.tags));
+    EXPECT_FALSE(task.isModified(task.project));
+    EXPECT_FALSE(task.isModified(task.priority));
 
-    const auto formatter = [](int val) -> QString {
-        EXPECT_EQ(val, kExpectedValue);
-        return QString("v:%1").arg(val);
-    };
-    const TaskProperty<int> prop(formatter, kExpectedValue);
-    const auto list = getValidStrings(prop);
-    EXPECT_EQ(list.size(), 1u);
-    EXPECT_EQ(list.first(), QString("v:71"));
+    const DetailedTaskInfo copy = task;
+    EXPECT_EQ(copy.tags.get(), QStringList{ "shop" });
+    EXPECT_TRUE(copy.isModified(copy.description));
+    EXPECT_TRUE(copy.isModified(copy.tags));
+    EXPECT_FALSE(copy.isModified(copy.active));
+
+    task.setNotModified(task.description);
+    EXPECT_FALSE(task.isModified(task.description));
+    EXPECT_TRUE(task.isModified(task.tags));
 }
 
-TEST_F(TaskPropertyTest, WorksWithFormatterToQStringList)
+TEST_F(TaskPropertyTest, FieldsTableCoversAllProperties)
 {
-    static constexpr int kExpectedValue = 71;
-    static const QStringList fmtList = { "s1", "s2" };
-
-    const auto formatter = [](int val) -> QStringList {
-        EXPECT_EQ(val, kExpectedValue);
-        return fmtList;
-    };
-    const TaskProperty<int> prop(formatter, kExpectedValue);
-    const auto list = getValidStrings(prop);
-    EXPECT_EQ(list, fmtList);
+    const auto &fields = DetailedTaskInfo::fields();
+    EXPECT_EQ(fields.size(), DetailedTaskInfo::propertiesCount());
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+        EXPECT_EQ(fields.at(i).property_index, i);
+        EXPECT_TRUE(fields.at(i).json_key != nullptr);
+        EXPECT_TRUE(fields.at(i).from_json != nullptr);
+        EXPECT_TRUE(fields.at(i).from_storage != nullptr);
+    }
+    // Description goes last, as it is multiline in "information" response.
+    EXPECT_STREQ(fields.back().json_key, "description");
 }
 
-TEST_F(TaskPropertyTest, CallingModifySetsFlag)
+TEST_F(TaskPropertyTest, FieldsTableLoadsNotModifiedValues)
 {
-    TaskProperty<int> prop("value: %1", 2);
-    EXPECT_FALSE(prop.value.isModified());
-    prop.value.modify([](auto &) {});
-    EXPECT_TRUE(prop.value.isModified());
+    const auto &fields = DetailedTaskInfo::fields();
+    const auto field = [&fields](const char *key) {
+        return *std::find_if(fields.cbegin(), fields.cend(),
+                             [key](const TaskFieldInfo &info) {
+                                 return QString(info.json_key) == key;
+                             });
+    };
+
+    DetailedTaskInfo task;
+    field("project").from_json(QJsonValue("home"), task);
+    field("tags").from_json(QJsonArray{ "a", "b" }, task);
+    field("priority").from_json(QJsonValue("H"), task);
+    field("start").from_json(QJsonValue("20240101T000000Z"), task);
+    field("description").from_json(QJsonValue(" Buy milk "), task);
+
+    EXPECT_EQ(task.project.get(), "home");
+    EXPECT_EQ(task.tags.get(), QStringList({ "a", "b" }));
+    EXPECT_EQ(task.priority.get(), DetailedTaskInfo::Priority::H);
+    EXPECT_TRUE(task.active.get());
+    EXPECT_EQ(task.description.get(), "Buy milk");
+    for (const auto &info : fields) {
+        EXPECT_FALSE(info.is_modified(task)) << info.json_key;
+    }
+
+    field("project").from_information("work", task);
+    EXPECT_EQ(task.project.get(), "work");
+    EXPECT_TRUE(field("project").is_modified(task));
+    EXPECT_EQ(field("project").to_cmd(task), QStringList{ "project:work" });
+    EXPECT_TRUE(field("start").to_cmd == nullptr);
 }
 
-TEST_F(TaskPropertyTest, ValueCanBeSetAndModificationReset)
+TEST_F(TaskPropertyTest, FieldsTableLoadsStoredValues)
 {
-    TaskProperty<int> prop("value: %1", 2);
-    EXPECT_FALSE(prop.value.isModified());
-    EXPECT_EQ(prop.get(), 2);
+    const auto &fields = DetailedTaskInfo::fields();
+    const auto field = [&fields](const char *key) {
+        return *std::find_if(fields.cbegin(), fields.cend(),
+                             [key](const TaskFieldInfo &info) {
+                                 return QString(info.json_key) == key;
+                             });
+    };
 
-    prop = 3;
-    EXPECT_TRUE(prop.value.isModified());
-    EXPECT_EQ(prop.get(), 3);
+    DetailedTaskInfo task;
+    field("tags").from_storage("a,b", task);
+    field("due").from_storage("1704067200", task);
+    field("wait").from_storage("not a number", task);
+    field("start").from_storage("1704067200", task);
+    field("description").from_storage(" Buy milk ", task);
 
-    prop.value.setNotModified();
-    EXPECT_FALSE(prop.value.isModified());
-    EXPECT_EQ(prop.get(), 3);
+    EXPECT_EQ(task.tags.get(), QStringList({ "a", "b" }));
+    ASSERT_TRUE(task.due.get().has_value());
+    EXPECT_EQ(task.due.get().toMSecsSinceEpoch(), 1704067200000);
+    EXPECT_FALSE(task.wait.get().has_value());
+    EXPECT_TRUE(task.active.get());
+    EXPECT_EQ(task.description.get(), "Buy milk");
+    for (const auto &info : fields) {
+        EXPECT_FALSE(info.is_modified(task)) << info.json_key;
+    }
 }
 
 } // namespace Test
@@ -0,0 +1,105 @@
+#include "task.hpp"
+#include "task_builder.hpp"
+#include "tasks_filter_index.hpp"
+
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+namespace
+{
+QList<int> matchedRows(const TasksFilterIndex &index,
+                       const QStringList &keywords)
+{
+    const auto query = TasksFilterQuery::parse(keywords);
+    EXPECT_TRUE(query.has_value()) << keywords.join(' ').toStdString();
+    return query ? index.select(*query) : QList<int>{};
+}
+
+const QList<DetailedTaskInfo> kTasks = {
+    makeTask().description("Buy milk").project("Home").tags({ "shop" }),
+    makeTask()
+        .description("Fix the garden fence")
+        .project("Home.Garden")
+        .tags({ "weekend" }),
+    makeTask()
+        .description("Write report")
+        .project("Work")
+        .tags({ "office", "urgent" }),
+    makeTask().description("Homework for the kids").project("Homework"),
+    makeTask().description("Call plumber, kitchen sink"),
+};
+} // namespace
+
+TEST(TasksFilterIndexTest, UnsupportedKeywordsFallBack)
+{
+    for (const auto &keyword :
+         { "due:today", "+OVERDUE", "or", "(", "12", "1-3,5", "/regex/",
+           "8f1c2e3d", "project.not:Home", "a b", "pro:", "+", "urgency>5",
+           "mi.k", "mil*", "milk?", "[mb]uy", "buy|call", "a\\b",
+           "pro:Ho*" }) {
+        EXPECT_FALSE(TasksFilterQuery::parse({ keyword }).has_value())
+            << keyword;
+    }
+    const auto query = TasksFilterQuery::parse(
+        { "pro:Home", "and", "+shop", "-urgent", "milk" });
+    ASSERT_TRUE(query.has_value());
+    EXPECT_EQ(query->terms().size(), 4);
+    EXPECT_TRUE(TasksFilterQuery::parse({})->isEmpty());
+}
+
+TEST(TasksFilterIndexTest, ProjectMatchesBeginning)
+{
+    const TasksFilterIndex index(kTasks);
+    EXPECT_EQ(matchedRows(index, { "project:Home" }), QList<int>({ 0, 1, 3 }));
+    EXPECT_EQ(matchedRows(index, { "pro:Home.Garden" }), QList<int>({ 1 }));
+    EXPECT_EQ(matchedRows(index, { "proj:Wo" }), QList<int>({ 2 }));
+    EXPECT_TRUE(matchedRows(index, { "pro:home" }).isEmpty());
+}
+
+TEST(TasksFilterIndexTest, TagsAndWordsAreCombined)
+{
+    const TasksFilterIndex index(kTasks);
+    EXPECT_EQ(matchedRows(index, { "+urgent" }), QList<int>({ 2 }));
+    EXPECT_EQ(matchedRows(index, { "-shop", "pro:Home" }),
+              QList<int>({ 1, 3 }));
+    // Words are found inside other words, like `task` does.
+    EXPECT_EQ(matchedRows(index, { "ork" }), QList<int>({ 3 }));
+    EXPECT_EQ(matchedRows(index, { "the" }), QList<int>({ 1, 3 }));
+    EXPECT_EQ(matchedRows(index, { "the", "+weekend" }), QList<int>({ 1 }));
+    // Words with separators are checked in descriptions.
+    EXPECT_EQ(matchedRows(index, { "plumber," }), QList<int>({ 4 }));
+    EXPECT_TRUE(matchedRows(index, { "garden-fence" }).isEmpty());
+    EXPECT_TRUE(matchedRows(index, { "Milk" }).isEmpty());
+}
+
+TEST(TasksFilterIndexTest, CaseInsensitiveQueryMatchesWordsAndProjects)
+{
+    const TasksFilterIndex index(kTasks);
+    const auto select = [&index](const QStringList &keywords) {
+        const auto query =
+            TasksFilterQuery::parse(keywords, Qt::CaseInsensitive);
+        EXPECT_TRUE(query.has_value());
+        return query ? index.select(*query) : QList<int>{};
+    };
+    EXPECT_EQ(select({ "Milk" }), QList<int>({ 0 }));
+    EXPECT_EQ(select({ "PLUMBER," }), QList<int>({ 4 }));
+    EXPECT_EQ(select({ "pro:home" }), QList<int>({ 0, 1, 3 }));
+    // Tags are always case sensitive.
+    EXPECT_TRUE(select({ "+Shop" }).isEmpty());
+}
+
+TEST(TasksFilterIndexTest, WordsAreFoundInAnnotations)
+{
+    auto tasks = kTasks;
+    tasks[2].annotations = QStringList{ "ask Bob, then send" };
+    const TasksFilterIndex index(tasks);
+    EXPECT_EQ(matchedRows(index, { "Bob" }), QList<int>({ 2 }));
+    EXPECT_EQ(matchedRows(index, { "Bob,", "report" }), QList<int>({ 2 }));
+    EXPECT_TRUE(matchedRows(index, { "Bob", "milk" }).isEmpty());
+}
+} // namespace Test
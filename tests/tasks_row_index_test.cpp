@@ -0,0 +1,67 @@
+#include "task.hpp"
+#include "task_builder.hpp"
+#include "tasks_row_index.hpp"
+
+#include <QList>
+#include <QString>
+#include <QUuid>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+TEST(TasksRowIndexTest, FindsRowsAfterInvalidate)
+{
+    auto tasks = makeTasks(5);
+    TasksRowIndex index;
+    EXPECT_EQ(index.rowOf(tasks, tasks.at(3).task_uuid), 3);
+    EXPECT_FALSE(index.rowOf(tasks, QUuid::createUuid().toString()));
+
+    const auto moved = tasks.at(3).task_uuid;
+    tasks.move(3, 0);
+    tasks.removeAt(4);
+    index.invalidate();
+    EXPECT_EQ(index.rowOf(tasks, moved), 0);
+    EXPECT_EQ(index.rowOf(tasks, tasks.at(2).task_uuid), 2);
+}
+
+TEST(TasksRowIndexTest, KeepsNotUuidKeysAndFirstOfDuplicates)
+{
+    auto tasks = makeTasks(2);
+    tasks << makeTask("uuid-1") << makeTask(tasks.at(0).task_uuid)
+          << makeTask("uuid-1");
+    TasksRowIndex index;
+    EXPECT_EQ(index.rowOf(tasks, "uuid-1"), 2);
+    EXPECT_EQ(index.rowOf(tasks, tasks.at(0).task_uuid), 0);
+    EXPECT_FALSE(index.rowOf(tasks, "uuid-2"));
+    EXPECT_FALSE(index.rowOf(tasks, ""));
+}
+
+TEST(TasksRowIndexTest, ShiftsRowsFollowingRemovedOne)
+{
+    auto tasks = makeTasks(5);
+    tasks << makeTask("uuid-1");
+    TasksRowIndex index;
+    EXPECT_EQ(index.rowOf(tasks, tasks.at(4).task_uuid), 4);
+
+    const auto removed = tasks.at(1).task_uuid;
+    index.removeRow(tasks, 1);
+    tasks.removeAt(1);
+    EXPECT_FALSE(index.rowOf(tasks, removed));
+    EXPECT_EQ(index.rowOf(tasks, tasks.at(0).task_uuid), 0);
+    EXPECT_EQ(index.rowOf(tasks, tasks.at(3).task_uuid), 3);
+    EXPECT_EQ(index.rowOf(tasks, "uuid-1"), 4);
+}
+
+TEST(TasksRowIndexTest, RemovalOfDuplicateFindsNextOne)
+{
+    auto tasks = makeTasks(2);
+    tasks << makeTask(tasks.at(0).task_uuid);
+    TasksRowIndex index;
+    EXPECT_EQ(index.rowOf(tasks, tasks.at(0).task_uuid), 0);
+
+    index.removeRow(tasks, 0);
+    tasks.removeAt(0);
+    EXPECT_EQ(index.rowOf(tasks, tasks.at(1).task_uuid), 1);
+}
+} // namespace Test
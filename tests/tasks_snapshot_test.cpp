@@ -0,0 +1,61 @@
+#include "allatoncekeywordsfinder.hpp"
+#include "task.hpp"
+#include "task_builder.hpp"
+#include "tasks_snapshot.hpp"
+
+#include <QDateTime>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+#include <gtest/gtest.h>
+
+namespace Test
+{
+namespace
+{
+QStringList uuidsOf(const QList<DetailedTaskInfo> &tasks)
+{
+    QStringList res;
+    for (const auto &task : tasks) {
+        res << task.task_uuid;
+    }
+    return res;
+}
+} // namespace
+
+TEST(TasksSnapshotTest, IdRangesAreExpanded)
+{
+    EXPECT_EQ(AllAtOnceKeywordsFinder::parseIdRanges("1-3 5 7-8"),
+              QSet<int>({ 1, 2, 3, 5, 7, 8 }));
+    EXPECT_TRUE(AllAtOnceKeywordsFinder::parseIdRanges("").isEmpty());
+}
+
+TEST(TasksSnapshotTest, SelectedIdsKeepUrgencyOrder)
+{
+    const QList<DetailedTaskInfo> tasks = {
+        makeTask("uuid-4").id(4),
+        makeTask("uuid-1").id(1),
+        makeTask("uuid-3").id(3),
+        makeTask("uuid-2").id(2),
+    };
+    EXPECT_EQ(uuidsOf(TasksSnapshot::selectIds(tasks, { 1, 2, 4 })),
+              QStringList({ "uuid-4", "uuid-1", "uuid-2" }));
+    EXPECT_TRUE(TasksSnapshot::selectIds(tasks, {}).isEmpty());
+}
+
+TEST(TasksSnapshotTest, HotTasksHaveDatesOrAreActive)
+{
+    const DetailedTaskInfo due = makeTask("uuid-1").id(1).due(
+        QDateTime::currentDateTime().addDays(30));
+    DetailedTaskInfo active = makeTask("uuid-2").id(2);
+    active.set(active.active, true);
+    DetailedTaskInfo wait = makeTask("uuid-4").id(4);
+    wait.set(wait.wait, QDateTime::currentDateTime().addDays(-1));
+
+    const QList<DetailedTaskInfo> tasks = { due, active,
+                                            makeTask("uuid-3").id(3), wait };
+    EXPECT_EQ(uuidsOf(TasksSnapshot::selectHot(tasks)),
+              QStringList({ "uuid-1", "uuid-2", "uuid-4" }));
+}
+} // namespace Test
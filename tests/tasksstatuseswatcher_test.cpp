@@ -11,6 +11,7 @@
 #include <QDateTime>
 #include <QList>
 #include <QSignalSpy>
+#include <qtypes.h>
 
 namespace Test
 {
@@ -24,9 +25,9 @@ class TasksStatusesWatcherTest : public QtBaseTest {
         void addTask(QDateTime due, QDateTime sched, QDateTime wait)
         {
             DetailedTaskInfo task;
-            task.due = due;
-            task.sched = sched;
-            task.wait = wait;
+            task.set(task.due, due);
+            task.set(task.sched, sched);
+            task.set(task.wait, wait);
             tasks.append(std::move(task));
         }
     };
@@ -78,4 +79,57 @@ TEST_F(TasksStatusesWatcherTest, TriggersSignalWhenTaskBecomesPast)
     EXPECT_GT(spy.count(), 1) << "It had to be signal(s) that status changed.";
 }
 
+TEST_F(TasksStatusesWatcherTest, NoticesClockJumpOverDeadline)
+{
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const auto due = QDateTime::fromMSecsSinceEpoch(now).addDays(10);
+    tasksProvider.addTask(due, {}, {});
+    TasksStatusesWatcher watcher(
+        std::ref(tasksProvider), nullptr,
+        TasksStatusesWatcher::kNoPeriodicCheck, 50ms,
+        [&now]() { return now; });
+    QSignalSpy spy(&watcher, &TasksStatusesWatcher::statusesWereChanged);
+
+    watcher.startWatchingStatusesChange();
+    EXPECT_FALSE(spy.wait(300));
+
+    // Like computer was suspended or clock was set forward: monotonic timer
+    // would not wake up for 10 days.
+    now = due.addSecs(1).toMSecsSinceEpoch();
+    EXPECT_TRUE(spy.wait(1000));
+    EXPECT_EQ(spy.count(), 1);
+
+    // Rebuild takes the new time, so task is already overdue.
+    watcher.startWatchingStatusesChange();
+    EXPECT_FALSE(spy.wait(300));
+}
+
+TEST_F(TasksStatusesWatcherTest, ResumeFollowsNextTransitions)
+{
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const auto due = QDateTime::fromMSecsSinceEpoch(now).addDays(10);
+    tasksProvider.addTask(due, {}, {});
+    TasksStatusesWatcher watcher(
+        std::ref(tasksProvider), nullptr,
+        TasksStatusesWatcher::kNoPeriodicCheck, 50ms,
+        [&now]() { return now; });
+    QSignalSpy spy(&watcher, &TasksStatusesWatcher::tasksStatusesWereChanged);
+
+    watcher.startWatchingStatusesChange();
+    now = due.addDays(-1).toMSecsSinceEpoch();
+    ASSERT_TRUE(spy.wait(1000));
+    const auto approaching = spy.takeFirst();
+    EXPECT_EQ(approaching.at(0).value<QList<int>>(), QList<int>({ 0 }));
+    EXPECT_FALSE(approaching.at(1).toBool());
+
+    // Approaching due is followed by Past without re-reading the list.
+    watcher.resumeWatching();
+    now = due.addSecs(1).toMSecsSinceEpoch();
+    ASSERT_TRUE(spy.wait(1000));
+    EXPECT_EQ(spy.count(), 1);
+
+    watcher.resumeWatching();
+    EXPECT_FALSE(spy.wait(300));
+}
+
 } // namespace Test
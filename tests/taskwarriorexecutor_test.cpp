@@ -1,7 +1,11 @@
 #include "task.hpp"
 #include "taskwarriorexecutor.hpp"
 
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QString>
+#include <QTemporaryDir>
 
 #include <gtest/gtest.h>
 #include <stdexcept>
@@ -11,6 +15,19 @@ namespace
 // Defined by CMake.
 const QString kTaskCommand = TASK_EXECUTABLE_PATH;
 
+/// @returns path to shell script with @p body which stands for `task`.
+QString makeFakeTask(const QTemporaryDir &dir, const QByteArray &body)
+{
+    const QString path = dir.filePath("fake_task.sh");
+    QFile file(path);
+    EXPECT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write("#!/bin/sh\n" + body);
+    file.close();
+    file.setPermissions(QFile::ReadOwner | QFile::WriteOwner |
+                        QFile::ExeOwner);
+    return path;
+}
+
 } // namespace
 
 namespace Test
@@ -43,4 +60,39 @@ TEST_F(TaskWarriorExecutorTest, TaskWarriorDbStateUpdates)
            "in the system without tasks on it.";
 }
 
+TEST_F(TaskWarriorExecutorTest, StreamingIsNotBlockedByLongStderr)
+{
+    const QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    // Much more than pipe buffer of the warnings before stdout.
+    const TaskWarriorExecutor executor(
+        makeFakeTask(dir, "head -c 1000000 /dev/zero | tr '\\0' w >&2\n"
+                          "echo done\n"),
+        TaskWarriorExecutor::TSkipBinaryValidation{});
+
+    QByteArray output;
+    QElapsedTimer elapsed;
+    elapsed.start();
+    const auto res = executor.execTaskProgramStreaming(
+        { "export" }, [&output](const QByteArray &chunk) { output += chunk; });
+    EXPECT_TRUE(res);
+    EXPECT_EQ(output.trimmed(), "done");
+    EXPECT_LT(elapsed.elapsed(), 10000);
+}
+
+TEST_F(TaskWarriorExecutorTest, StreamingReportsCollectedStderr)
+{
+    const QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    const TaskWarriorExecutor executor(
+        makeFakeTask(dir, "echo broken >&2\nexit 3\n"),
+        TaskWarriorExecutor::TSkipBinaryValidation{});
+
+    const auto res =
+        executor.execTaskProgramStreaming({ "export" }, [](const auto &) {});
+    EXPECT_FALSE(res);
+    EXPECT_EQ(res.getError().code, 3);
+    EXPECT_EQ(res.getError().message.trimmed(), "broken");
+}
+
 } // namespace Test